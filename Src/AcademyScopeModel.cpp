@@ -16,10 +16,47 @@ GNU General Public License for more details.
 #include "AcademyScopeModel.hpp"
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include <QHash>
 #include <QSqlError>
 #include <QDebug>
+#include <QLocale>
+#include <algorithm>
+#include <cstdlib>
 #include "DataTypeDefinitions.hpp"
 #include "ProgramTableColumnDefinitions.hpp"
+#include "Utils/SQLiteUtil.hpp"
+
+int RowCountMetrics::absoluteError() const
+{
+    if (estimatedRowCount < 0 || exactRowCount < 0)
+        return 0;
+    return std::abs(estimatedRowCount - exactRowCount);
+}
+
+double RowCountMetrics::relativeError() const
+{
+    if (exactRowCount <= 0)
+        return 0;
+    return double(absoluteError()) / exactRowCount;
+}
+
+void FetchCost::record(qint64 latencyNanoseconds, qint64 rowsNanoseconds, int rows)
+{
+    // Smoothed, so a single slow fetch does not flip the strategy
+    auto smooth = [](double previous, double sample) {
+        return previous < 0 ? sample : 0.7 * previous + 0.3 * sample;
+    };
+    latencyMilliseconds = smooth(latencyMilliseconds, latencyNanoseconds / 1e6);
+    if (rows > 0)
+        perRowMilliseconds = smooth(perRowMilliseconds, rowsNanoseconds / 1e6 / rows);
+}
+
+double FetchCost::estimateMilliseconds(int rows) const
+{
+    if (perRowMilliseconds < 0)
+        return -1;
+    return std::max(0.0, latencyMilliseconds) + rows * perRowMilliseconds;
+}
 
 AcademyScopeModel::AcademyScopeModel(QObject *parent)
     : QAbstractTableModel(parent)
@@ -31,7 +68,19 @@ void AcademyScopeModel::setDatabase(const QSqlDatabase &database)
     db = database;
 }
 
-void AcademyScopeModel::setBaseQuery(const QString &queryBase)
+void AcademyScopeModel::setSnapshot(const std::shared_ptr<const DatasetSnapshot> &newSnapshot)
+{
+    // The connection handle is replaced first so the old snapshot can remove its connection
+    db = newSnapshot ? newSnapshot->getDatabase() : QSqlDatabase();
+    if (newSnapshot != snapshot) {
+        // Rowids are only meaningful within one version of the file
+        materializedTableName.clear();
+        materializedRowsById.clear();
+    }
+    snapshot = newSnapshot;
+}
+
+void AcademyScopeModel::setBaseQuery(const QString &queryBase, const QVariantList &bindValues, int rowLimit)
 {
     if (!db.isOpen()) {
         qWarning() << "[AcademyScopeModel] Database is not open!";
@@ -41,36 +90,417 @@ void AcademyScopeModel::setBaseQuery(const QString &queryBase)
     beginResetModel();
 
     modelData.clear();
-    baseQuery = "SELECT * " + queryBase;
+    orderedTableName.clear();
+    orderedRowIds.clear();
+    baseQuery = queryBase;
+    baseBindValues = bindValues;
     dataWindow = DataWindow(); // reset window state
+    rowCountIsEstimate = false;
+    loadStrategy = LoadStrategy::Windowed;
+
+    if (rowLimit > 0) {
+        // Top-k: the first rows are fetched in one go, the total is counted elsewhere
+        countQuery.clear();
+        totalRowCount = -1;
+
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        ++issuedQueryCount;
+        if (!SQLiteUtil::exec(query, QString("%1 LIMIT %2").arg(projectedQuery(), QString::number(rowLimit)),
+                              baseBindValues))
+            qWarning() << "[AcademyScopeModel] Query failed:" << query.lastError().text();
+        dataWindow.columnCount = programTableColumnCount;
+        while (query.next())
+            modelData.append(readRow(query, 0));
+        dataWindow.tableRowCount = modelData.size();
+        dataWindow.beginningIndex = 0;
+        dataWindow.endingIndex = dataWindow.tableRowCount - 1;
+
+        endResetModel();
+        return;
+    }
 
     // --- Get total row count ---
     countQuery = "SELECT COUNT(*) " + queryBase;
     QSqlQuery count(db);
-    if (count.exec(countQuery) && count.next())
+    ++issuedQueryCount;
+    if (SQLiteUtil::exec(count, countQuery, baseBindValues) && count.next())
         dataWindow.tableRowCount = count.value(0).toInt();
     else {
         qWarning() << "[AcademyScopeModel] COUNT query failed:" << count.lastError().text();
         dataWindow.tableRowCount = 0;
     }
 
-    // --- Detect column count ---
-    QString firstRowQuery = QString("%1 LIMIT 1").arg(baseQuery);
-    QSqlQuery colQuery(db);
-    if (colQuery.exec(firstRowQuery))
-        dataWindow.columnCount = colQuery.record().count();
-    else
-        dataWindow.columnCount = 0;
+    // The projection follows the schema, so the column count is known up front
+    dataWindow.columnCount = programTableColumnCount;
 
     // --- Allocate placeholder slots ---
     modelData.resize(dataWindow.tableRowCount);
 
     endResetModel();
+    setTotalRowCount(dataWindow.tableRowCount);
+
+    if (chooseStrategy(dataWindow.tableRowCount) == LoadStrategy::Materialized && materializeQueryRows())
+        return;
 
     // Load initial viewport
+    resetWindow();
+    loadCurrentWindow();
+}
+
+void AcademyScopeModel::setEstimatedBaseQuery(const QString &queryBase, const QVariantList &bindValues,
+                                               int estimatedRowCount)
+{
+    if (!db.isOpen()) {
+        qWarning() << "[AcademyScopeModel] Database is not open!";
+        return;
+    }
+
+    beginResetModel();
+
+    modelData.clear();
+    orderedTableName.clear();
+    orderedRowIds.clear();
+    baseQuery = queryBase;
+    baseBindValues = bindValues;
+    countQuery = "SELECT COUNT(*) " + queryBase;
+    dataWindow = DataWindow(); // reset window state
+    dataWindow.tableRowCount = std::max(0, estimatedRowCount);
+    totalRowCount = -1;
+    rowCountIsEstimate = true;
+    loadStrategy = LoadStrategy::Windowed;
+    rowCountMetrics = RowCountMetrics();
+    rowCountMetrics.estimatedRowCount = dataWindow.tableRowCount;
+    exactCountTimer.start();
+
+    dataWindow.columnCount = programTableColumnCount;
+
+    modelData.resize(dataWindow.tableRowCount);
+
+    endResetModel();
+
+    if (chooseStrategy(dataWindow.tableRowCount) == LoadStrategy::Materialized && materializeQueryRows()) {
+        // The complete fetch counted the rows exactly
+        setTotalRowCount(dataWindow.tableRowCount);
+        return;
+    }
+
+    resetWindow();
+    loadCurrentWindow();
+}
+
+void AcademyScopeModel::setOrderedRows(const QString &tableName, const QVector<qint64> &rowIds, int filteredRowCount)
+{
+    if (!db.isOpen()) {
+        qWarning() << "[AcademyScopeModel] Database is not open!";
+        return;
+    }
+
+    beginResetModel();
+
+    modelData.clear();
+    baseQuery.clear();
+    baseBindValues.clear();
+    countQuery.clear();
+    orderedTableName = tableName;
+    orderedRowIds = rowIds;
+    rowCountIsEstimate = false;
+    loadStrategy = LoadStrategy::Windowed;
+    dataWindow = DataWindow(); // reset window state
+    dataWindow.tableRowCount = orderedRowIds.size();
+
+    dataWindow.columnCount = programTableColumnCount;
+
+    modelData.resize(dataWindow.tableRowCount);
+
+    endResetModel();
+    setTotalRowCount(filteredRowCount < 0 ? dataWindow.tableRowCount : filteredRowCount);
+
+    if (chooseStrategy(dataWindow.tableRowCount) == LoadStrategy::Materialized) {
+        loadStrategy = LoadStrategy::Materialized;
+        materializeOrderedRows();
+        return;
+    }
+
+    resetWindow();
+    loadCurrentWindow();
+}
+
+bool AcademyScopeModel::hasOrderedRows() const
+{
+    return !orderedTableName.isEmpty();
+}
+
+int AcademyScopeModel::getTotalRowCount() const
+{
+    return totalRowCount;
+}
+
+void AcademyScopeModel::setTotalRowCount(int count)
+{
+    if (rowCountIsEstimate) {
+        rowCountIsEstimate = false;
+        rowCountMetrics.exactRowCount = count;
+        rowCountMetrics.millisecondsToExact = exactCountTimer.elapsed();
+        qDebug() << "[AcademyScopeModel] Row count estimate" << rowCountMetrics.estimatedRowCount
+                 << "exact" << count << "after" << rowCountMetrics.millisecondsToExact << "ms";
+        resizeToExactRowCount(count);
+    }
+
+    if (count == totalRowCount)
+        return;
+    totalRowCount = count;
+    emit totalRowCountChanged(count);
+}
+
+const RowCountMetrics &AcademyScopeModel::getRowCountMetrics() const
+{
+    return rowCountMetrics;
+}
+
+namespace {
+qint64 rowBytes(const QVector<QVariant> &row)
+{
+    qint64 bytes = row.capacity() * qint64(sizeof(QVariant));
+    for (const QVariant &value : row)
+        if (value.typeId() == QMetaType::QString)
+            bytes += value.toString().capacity() * qint64(sizeof(QChar));
+    return bytes;
+}
+}
+
+qint64 AcademyScopeModel::estimatedMemoryBytes() const
+{
+    qint64 bytes = modelData.capacity() * qint64(sizeof(QVector<QVariant>));
+    for (const QVector<QVariant> &row : modelData)
+        bytes += rowBytes(row);
+
+    // Rows of a materialized ordered result are shared with modelData
+    const bool shared = loadStrategy == LoadStrategy::Materialized && hasOrderedRows();
+    bytes += materializedRowsById.capacity() * qint64(sizeof(qint64) + sizeof(QVector<QVariant>));
+    if (!shared)
+        for (const QVector<QVariant> &row : materializedRowsById)
+            bytes += rowBytes(row);
+    return bytes;
+}
+
+qint64 AcademyScopeModel::releaseMemory(qint64 targetBytes)
+{
+    const qint64 before = estimatedMemoryBytes();
+
+    const bool materialized = loadStrategy == LoadStrategy::Materialized;
+    if (materialized) {
+        // The hash backs every shown row while materialized; it only goes together with
+        // the strategy, and a result that fits one window is not worth windowing
+        if (targetBytes <= 0 || dataWindow.tableRowCount <= tunedWindowSize())
+            return 0;
+        loadStrategy = LoadStrategy::Windowed;
+        dataWindow.windowSize = tunedWindowSize();
+        dataWindow.beginningIndex = std::max(0, lastRequestedRow - dataWindow.windowSize / 2);
+        dataWindow.endingIndex = std::min(dataWindow.beginningIndex + dataWindow.windowSize, dataWindow.tableRowCount) - 1;
+        for (int row = 0; row < modelData.size(); ++row)
+            if (row < dataWindow.beginningIndex || row > dataWindow.endingIndex)
+                modelData[row] = QVector<QVariant>();
+    }
+
+    materializedRowsById.clear();
+    materializedRowsById.squeeze();
+    materializedTableName.clear();
+
+    // Rows of the new window come from the database again, the rest on scroll
+    if (materialized)
+        loadCurrentWindow();
+    return std::max<qint64>(0, before - estimatedMemoryBytes());
+}
+
+void AcademyScopeModel::setMaterializationLimits(int maxRows, int budgetMilliseconds)
+{
+    materializeRowLimit = std::max(0, maxRows);
+    materializeBudgetMilliseconds = std::max(0, budgetMilliseconds);
+}
+
+void AcademyScopeModel::setViewportRowCount(int rows)
+{
+    viewportRowCount = std::max(0, rows);
+    if (loadStrategy == LoadStrategy::Windowed)
+        dataWindow.windowSize = tunedWindowSize();
+}
+
+LoadStrategy AcademyScopeModel::getLoadStrategy() const
+{
+    return loadStrategy;
+}
+
+const FetchCost &AcademyScopeModel::getFetchCost() const
+{
+    return fetchCost;
+}
+
+qint64 AcademyScopeModel::getIssuedQueryCount() const
+{
+    return issuedQueryCount;
+}
+
+LoadStrategy AcademyScopeModel::chooseStrategy(int rowCount) const
+{
+    if (rowCount > materializeRowLimit)
+        return LoadStrategy::Windowed;
+    // Without a measurement yet the row count alone decides
+    const double estimate = fetchCost.estimateMilliseconds(rowCount);
+    return estimate <= materializeBudgetMilliseconds ? LoadStrategy::Materialized : LoadStrategy::Windowed;
+}
+
+int AcademyScopeModel::tunedWindowSize() const
+{
+    // Three screens, so scrolling a screen either way stays inside the window
+    int size = viewportRowCount > 0 ? viewportRowCount * 3 : DataWindow().windowSize;
+    // Enough rows per fetch that the fixed latency stays under a quarter of the fetch
+    // Capped in double; a tiny per-row cost would overflow the conversion to int
+    if (fetchCost.latencyMilliseconds > 0 && fetchCost.perRowMilliseconds > 0)
+        size = std::max(size, int(std::min(3 * fetchCost.latencyMilliseconds / fetchCost.perRowMilliseconds, 2000.0)));
+    // The viewport wins over the cap
+    return std::max({std::min(size, 2000), viewportRowCount, 50});
+}
+
+void AcademyScopeModel::resetWindow()
+{
+    dataWindow.windowSize = tunedWindowSize();
     dataWindow.beginningIndex = 0;
     dataWindow.endingIndex = std::min(dataWindow.windowSize - 1, dataWindow.tableRowCount - 1);
-    loadCurrentWindow();
+}
+
+QVector<QVariant> AcademyScopeModel::readRow(const QSqlQuery &query, int firstColumn) const
+{
+    QVector<QVariant> row;
+    row.reserve(dataWindow.columnCount);
+    // Result column i is ProgramTableColumn(i), so the schema types every value
+    for (int i = 0; i < dataWindow.columnCount; ++i) {
+        const QVariant value = ProgramTableColumns::decode(ProgramTableColumn(i), query.value(firstColumn + i));
+        row.append(value.isValid() ? value : QVariant("—"));
+    }
+    return row;
+}
+
+bool AcademyScopeModel::materializeQueryRows()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    // One row past the limit tells a result that outgrew its count or estimate
+    ++issuedQueryCount;
+    if (!SQLiteUtil::exec(query, QString("%1 LIMIT %2").arg(projectedQuery(), QString::number(materializeRowLimit + 1)),
+                          baseBindValues)) {
+        qWarning() << "[AcademyScopeModel] Query failed:" << query.lastError().text();
+        return false;
+    }
+    const qint64 latency = timer.nsecsElapsed();
+
+    QVector<QVector<QVariant>> rows;
+    while (query.next())
+        rows.append(readRow(query, 0));
+    fetchCost.record(latency, timer.nsecsElapsed() - latency, rows.size());
+
+    if (rows.size() > materializeRowLimit) {
+        qDebug() << "[AcademyScopeModel] Result exceeds" << materializeRowLimit << "rows, windowing instead";
+        return false;
+    }
+
+    beginResetModel();
+    modelData = std::move(rows);
+    dataWindow.tableRowCount = modelData.size();
+    dataWindow.beginningIndex = 0;
+    dataWindow.endingIndex = dataWindow.tableRowCount - 1;
+    loadStrategy = LoadStrategy::Materialized;
+    endResetModel();
+
+    qDebug() << "[AcademyScopeModel] Materialized" << dataWindow.tableRowCount << "rows in"
+             << timer.elapsed() << "ms";
+    return true;
+}
+
+void AcademyScopeModel::materializeOrderedRows()
+{
+    // A new permutation of rows already in memory needs no query
+    bool cached = orderedTableName == materializedTableName && (visibleColumns & ~materializedColumns) == 0;
+    for (int row = 0; cached && row < orderedRowIds.size(); ++row)
+        cached = materializedRowsById.contains(orderedRowIds[row]);
+
+    if (!cached) {
+        QStringList ids;
+        ids.reserve(orderedRowIds.size());
+        for (qint64 rowId : orderedRowIds)
+            ids << QString::number(rowId);
+
+        QElapsedTimer timer;
+        timer.start();
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        const QString queryStr = QString("SELECT rowid, %1 FROM %2 WHERE rowid IN (%3)")
+                                     .arg(ProgramTableColumns::selectList(visibleColumns), orderedTableName,
+                                          ids.join(','));
+        ++issuedQueryCount;
+        if (!query.exec(queryStr)) {
+            qWarning() << "[AcademyScopeModel] Query failed:" << query.lastError().text();
+            return;
+        }
+        const qint64 latency = timer.nsecsElapsed();
+
+        materializedRowsById.clear();
+        materializedRowsById.reserve(orderedRowIds.size());
+        while (query.next())
+            materializedRowsById.insert(query.value(0).toLongLong(), readRow(query, 1));
+        fetchCost.record(latency, timer.nsecsElapsed() - latency, materializedRowsById.size());
+        materializedTableName = orderedTableName;
+        materializedColumns = visibleColumns;
+    }
+
+    fillFromMaterializedRows();
+}
+
+void AcademyScopeModel::fillFromMaterializedRows()
+{
+    beginResetModel();
+    modelData.resize(dataWindow.tableRowCount);
+    for (int row = 0; row < dataWindow.tableRowCount; ++row)
+        modelData[row] = materializedRowsById.value(orderedRowIdAt(row));
+    dataWindow.beginningIndex = 0;
+    dataWindow.endingIndex = dataWindow.tableRowCount - 1;
+    endResetModel();
+}
+
+void AcademyScopeModel::sort(int column, Qt::SortOrder order)
+{
+    // The back end orders rows (ranks or SQL, NULLs last, ProgramKodu ties) and
+    // tracks the order it produced; sorting here would leave it describing another one
+    if (column < 0 || column >= programTableColumnCount || !ProgramTableColumns::isSortable(ProgramTableColumn(column)))
+        return;
+    emit sortRequested(ProgramTableColumn(column), order);
+}
+
+void AcademyScopeModel::resizeToExactRowCount(int count)
+{
+    const int current = dataWindow.tableRowCount;
+    if (count > current) {
+        beginInsertRows(QModelIndex(), current, count - 1);
+        dataWindow.tableRowCount = count;
+        modelData.resize(count);
+        endInsertRows();
+    } else if (count < current) {
+        beginRemoveRows(QModelIndex(), count, current - 1);
+        dataWindow.tableRowCount = count;
+        modelData.resize(count);
+        endRemoveRows();
+    } else {
+        return;
+    }
+
+    // The window is refitted to the exact size, including rows the estimate did not cover
+    dataWindow.beginningIndex = std::min(dataWindow.beginningIndex, std::max(0, count - 1));
+    dataWindow.endingIndex = std::min(dataWindow.beginningIndex + dataWindow.windowSize - 1, count - 1);
+    if (count > 0)
+        loadCurrentWindow();
 }
 
 int AcademyScopeModel::rowCount(const QModelIndex &) const
@@ -91,6 +521,7 @@ QVariant AcademyScopeModel::data(const QModelIndex &index, int role) const
     const int r = index.row();
     if (r < 0 || r >= modelData.size())
         return {};
+    lastRequestedRow = r;
 
     const auto &row = modelData[r];
     if (row.isEmpty()) return {}; // not loaded yet
@@ -109,35 +540,8 @@ QVariant AcademyScopeModel::headerData(int section,
     if (role != Qt::DisplayRole)
         return {};
 
-    if (orientation == Qt::Horizontal) {
-        switch (static_cast<ProgramTableColumn>(section)) {
-        case ProgramTableColumn::ProgramKodu:                 return "Program Kodu";
-        case ProgramTableColumn::UniversiteAdi:               return "Üniversite";
-        case ProgramTableColumn::FakulteYuksekOkulAdi:        return "Kampüs";
-        case ProgramTableColumn::ProgramAdi:                  return "Program";
-        case ProgramTableColumn::PuanTuru:                    return "Puan Türü";
-        case ProgramTableColumn::GenelKontenjan:              return "Kontenjan";
-        case ProgramTableColumn::GenelYerlesen:               return "Yerleşen";
-        case ProgramTableColumn::GenelBasariSirasi:           return "Başarı Sırası";
-        case ProgramTableColumn::GenelEnKucukPuan:            return "En Küçük Puan";
-        case ProgramTableColumn::OkulBirincisiKontenjan:      return "Okul Birincisi Kontenjan";
-        case ProgramTableColumn::OkulBirincisiYerlesen:       return "Okul Birincisi Yerleşen";
-        case ProgramTableColumn::OkulBirincisiBasariSirasi:   return "Okul Birincisi Başarı Sırası";
-        case ProgramTableColumn::OkulBirincisiEnKucukPuan:    return "Okul Birincisi En Küçük Puan";
-        case ProgramTableColumn::SehitGaziYakiniKontenjan:    return "Şehit / Gazi Yakını Kontenjan";
-        case ProgramTableColumn::SehitGaziYakiniYerlesen:     return "Şehit / Gazi Yakını Yerleşen";
-        case ProgramTableColumn::SehitGaziYakiniBasariSirasi: return "Şehit / Gazi Yakını Başarı Sırası";
-        case ProgramTableColumn::SehitGaziYakiniEnKucukPuan:  return "Şehit / Gazi Yakını En Küçük Puan";
-        case ProgramTableColumn::DepremzedeKontenjan:         return "Depremzede Kontenjan";
-        case ProgramTableColumn::DepremzedeYerlesen:          return "Depremzede Yerleşen";
-        case ProgramTableColumn::DepremzedeBasariSirasi:      return "Depremzede Başarı Sırası";
-        case ProgramTableColumn::DepremzedeEnKucukPuan:       return "Depremzede En Küçük Puan";
-        case ProgramTableColumn::Kadin34PlusKontenjan:        return "34+ Kadın Kontenjan";
-        case ProgramTableColumn::Kadin34PlusYerlesen:         return "34+ Kadın Yerleşen";
-        case ProgramTableColumn::Kadin34PlusBasariSirasi:     return "34+ Kadın Başarı Sırası";
-        case ProgramTableColumn::Kadin34PlusEnKucukPuan:      return "34+ Kadın En Küçük Puan";
-        }
-    }
+    if (orientation == Qt::Horizontal && section >= 0 && section < programTableColumnCount)
+        return ProgramTableColumns::displayName(ProgramTableColumn(section));
 
     if (orientation == Qt::Vertical)
         return QString::number(section + 1);
@@ -145,6 +549,35 @@ QVariant AcademyScopeModel::headerData(int section,
     return {};
 }
 
+void AcademyScopeModel::setVisibleColumns(ProgramTableColumnMask columns, bool refetchRevealed)
+{
+    columns &= allProgramTableColumns;
+    const ProgramTableColumnMask changed = columns ^ visibleColumns;
+    if (changed == 0)
+        return;
+
+    const bool revealsColumns = (changed & columns) != 0;
+    visibleColumns = columns;
+    // The view only hears about columns whose visibility actually flipped
+    for (int column = 0; column < programTableColumnCount; ++column)
+        if (changed & columnBit(ProgramTableColumn(column)))
+            emit columnVisibilityChanged(column, (columns & columnBit(ProgramTableColumn(column))) != 0);
+
+    // Loaded rows hold NULL for columns that were hidden at load time
+    if (refetchRevealed && revealsColumns && dataWindow.tableRowCount > 0)
+        loadCurrentWindow();
+}
+
+ProgramTableColumnMask AcademyScopeModel::getVisibleColumns() const
+{
+    return visibleColumns;
+}
+
+QString AcademyScopeModel::projectedQuery() const
+{
+    return QString("SELECT %1 %2").arg(ProgramTableColumns::selectList(visibleColumns), baseQuery);
+}
+
 void AcademyScopeModel::showColumn(ProgramTableColumn column) const
 {
     emit columnVisibilityChanged(int(column), true);
@@ -181,11 +614,32 @@ DataWindow *AcademyScopeModel::getDataWindow()
 
 void AcademyScopeModel::loadCurrentWindow()
 {
+    if (loadStrategy == LoadStrategy::Materialized) {
+        // Reached when columns are revealed or the row count changed: fetch everything again
+        if (hasOrderedRows()) {
+            materializeOrderedRows();
+            return;
+        }
+        if (materializeQueryRows())
+            return;
+        loadStrategy = LoadStrategy::Windowed;
+        modelData.resize(dataWindow.tableRowCount);
+        resetWindow();
+    }
     loadRows(dataWindow.beginningIndex, dataWindow.endingIndex);
 }
 
 void AcademyScopeModel::loadRows(int startRow, int endRow)
 {
+    // Every row is in memory already
+    if (loadStrategy == LoadStrategy::Materialized)
+        return;
+
+    if (hasOrderedRows()) {
+        loadOrderedRows(startRow, endRow);
+        return;
+    }
+
     if (!db.isOpen() || baseQuery.isEmpty())
         return;
 
@@ -194,15 +648,17 @@ void AcademyScopeModel::loadRows(int startRow, int endRow)
 
     const int fetchCount = endRow - startRow + 1;
     QString queryStr = QString("%1 LIMIT %2 OFFSET %3")
-                           .arg(baseQuery)
-                           .arg(fetchCount)
-                           .arg(startRow);
+                           .arg(projectedQuery(), QString::number(fetchCount), QString::number(startRow));
 
+    QElapsedTimer timer;
+    timer.start();
     QSqlQuery query(db);
-    if (!query.exec(queryStr)) {
+    ++issuedQueryCount;
+    if (!SQLiteUtil::exec(query, queryStr, baseBindValues)) {
         qWarning() << "[AcademyScopeModel] Query failed:" << query.lastError().text();
         return;
     }
+    const qint64 latency = timer.nsecsElapsed();
 
     beginResetModel();
 
@@ -211,13 +667,10 @@ void AcademyScopeModel::loadRows(int startRow, int endRow)
 
     int rowIndex = startRow;
     while (query.next() && rowIndex <= endRow) {
-        QVector<QVariant> row;
-        row.reserve(dataWindow.columnCount);
-        for (int i = 0; i < dataWindow.columnCount; ++i)
-            row.append(query.value(i).isNull() ? QVariant("—") : query.value(i));
-        modelData[rowIndex] = row;
+        modelData[rowIndex] = readRow(query, 0);
         ++rowIndex;
     }
+    fetchCost.record(latency, timer.nsecsElapsed() - latency, rowIndex - startRow);
 
     // Geri kalan satırları boşalt
     for (int i = 0; i < startRow; ++i)
@@ -230,6 +683,70 @@ void AcademyScopeModel::loadRows(int startRow, int endRow)
     qDebug() << "[AcademyScopeModel] Loaded rows:" << startRow << "-" << endRow;
 }
 
+qint64 AcademyScopeModel::orderedRowIdAt(int row) const
+{
+    return orderedRowIds[row];
+}
+
+void AcademyScopeModel::loadOrderedRows(int startRow, int endRow)
+{
+    if (!db.isOpen())
+        return;
+
+    startRow = std::max(0, startRow);
+    endRow   = std::min(dataWindow.tableRowCount - 1, endRow);
+    if (endRow < startRow)
+        return;
+
+    // The order is already decided; SQLite only has to look rows up by rowid
+    QHash<qint64, int> rowIndexByRowId;
+    rowIndexByRowId.reserve(endRow - startRow + 1);
+    QStringList ids;
+    ids.reserve(endRow - startRow + 1);
+    for (int row = startRow; row <= endRow; ++row) {
+        const qint64 rowId = orderedRowIdAt(row);
+        rowIndexByRowId.insert(rowId, row);
+        ids << QString::number(rowId);
+    }
+
+    QString queryStr = QString("SELECT rowid, %1 FROM %2 WHERE rowid IN (%3)")
+                           .arg(ProgramTableColumns::selectList(visibleColumns), orderedTableName, ids.join(','));
+
+    QElapsedTimer timer;
+    timer.start();
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    ++issuedQueryCount;
+    if (!query.exec(queryStr)) {
+        qWarning() << "[AcademyScopeModel] Query failed:" << query.lastError().text();
+        return;
+    }
+    const qint64 latency = timer.nsecsElapsed();
+
+    beginResetModel();
+
+    if (modelData.isEmpty())
+        modelData.resize(dataWindow.tableRowCount);
+
+    int fetched = 0;
+    while (query.next()) {
+        const int rowIndex = rowIndexByRowId.value(query.value(0).toLongLong(), -1);
+        if (rowIndex < 0)
+            continue;
+        modelData[rowIndex] = readRow(query, 1);
+        ++fetched;
+    }
+    fetchCost.record(latency, timer.nsecsElapsed() - latency, fetched);
+
+    for (int i = 0; i < startRow; ++i)
+        modelData[i].clear();
+    for (int i = endRow + 1; i < modelData.size(); ++i)
+        modelData[i].clear();
+
+    endResetModel();
+
+    qDebug() << "[AcademyScopeModel] Loaded ordered rows:" << startRow << "-" << endRow;
+}
 
 void AcademyScopeModel::clear()
 {
@@ -237,5 +754,11 @@ void AcademyScopeModel::clear()
     modelData.clear();
     dataWindow = DataWindow();
     baseQuery.clear();
+    baseBindValues.clear();
+    orderedTableName.clear();
+    orderedRowIds.clear();
+    totalRowCount = -1;
+    rowCountIsEstimate = false;
+    loadStrategy = LoadStrategy::Windowed;
     endResetModel();
 }
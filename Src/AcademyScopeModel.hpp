@@ -14,17 +14,85 @@ You should have received a copy of the GNU General Public License along with thi
 #include <QSqlQuery>
 #include <QVector>
 #include <QVariant>
+#include <QElapsedTimer>
+#include <QHash>
 #include "DataTypeDefinitions.hpp"
+#include "ProgramTableColumnDefinitions.hpp"
+#include "Data/DatasetSnapshot.hpp"
+#include <memory>
+
+struct RowCountMetrics {
+    int estimatedRowCount = -1;
+    int exactRowCount = -1;        // -1 until the background count finished
+    qint64 millisecondsToExact = -1;
+
+    int absoluteError() const;
+    double relativeError() const;
+};
+
+// Materialized results are fetched in one streaming query and then scrolled
+// and sorted without SQLite; windowed ones are paged with LIMIT/OFFSET.
+enum class LoadStrategy {
+    Windowed,
+    Materialized
+};
+
+// Measured cost of the last fetches, smoothed; -1 until the first fetch
+struct FetchCost {
+    double latencyMilliseconds = -1; // exec() until the first row is available
+    double perRowMilliseconds = -1;  // stepping and converting one row
+
+    void record(qint64 latencyNanoseconds, qint64 rowsNanoseconds, int rows);
+    // -1 when nothing has been measured yet
+    double estimateMilliseconds(int rows) const;
+};
 
 class AcademyScopeModel : public QAbstractTableModel {
     Q_OBJECT
 signals:
     void columnVisibilityChanged(int index, bool visible) const;
+    // A header click; the back end repopulates with this order
+    void sortRequested(ProgramTableColumn column, Qt::SortOrder order);
+    // Size of the whole filtered set; in top-k mode it arrives after the rows
+    void totalRowCountChanged(int count);
 public:
     explicit AcademyScopeModel(QObject *parent = nullptr);
 
     void setDatabase(const QSqlDatabase &db);
-    void setBaseQuery(const QString &queryBase);
+    // Reads from the snapshot's connection and keeps the snapshot alive until replaced
+    void setSnapshot(const std::shared_ptr<const DatasetSnapshot> &snapshot);
+    // bindValues fill the "?" placeholders of queryBase in every statement built from it.
+    // rowLimit > 0 loads only that many rows and skips the COUNT(*) query
+    void setBaseQuery(const QString &queryBase, const QVariantList &bindValues, int rowLimit = 0);
+    // Sizes the model from an estimate instead of COUNT(*); the exact count is
+    // applied later through setTotalRowCount() with insert/remove notifications
+    void setEstimatedBaseQuery(const QString &queryBase, const QVariantList &bindValues, int estimatedRowCount);
+    // filteredRowCount is the size of the set rowIds were picked from (top-k); -1 means rowIds.size()
+    void setOrderedRows(const QString &tableName, const QVector<qint64> &rowIds, int filteredRowCount = -1);
+    bool hasOrderedRows() const;
+    // -1 while the count of a top-k result is still running
+    int getTotalRowCount() const;
+    void setTotalRowCount(int count);
+    const RowCountMetrics &getRowCountMetrics() const;
+
+    // Results of at most maxRows rows whose measured fetch cost fits in
+    // budgetMilliseconds are loaded completely
+    void setMaterializationLimits(int maxRows, int budgetMilliseconds);
+    // Visible row count of the view; the window size is derived from it
+    void setViewportRowCount(int rows);
+    LoadStrategy getLoadStrategy() const;
+    const FetchCost &getFetchCost() const;
+    // SQL statements this model has executed since it was created
+    qint64 getIssuedQueryCount() const;
+
+    // Loaded rows and the materialized rowid cache
+    qint64 estimatedMemoryBytes() const;
+    // Drops the rowid cache, then demotes a materialized result to a window
+    // around the rows the view asked for last; returns the bytes freed
+    qint64 releaseMemory(qint64 targetBytes);
+    // Does not reorder rows itself: emits sortRequested, and the back end
+    // re-runs the query with that order
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
@@ -35,6 +103,12 @@ public:
 
     void showColumn(ProgramTableColumn column) const;
     void hideColumn(ProgramTableColumn column) const;
+    // Diffs against the current mask and emits columnVisibilityChanged for each
+    // changed column; hidden columns are left out of the projection.
+    // refetchRevealed reloads the window when columns are revealed; callers about
+    // to set a new query pass false.
+    void setVisibleColumns(ProgramTableColumnMask columns, bool refetchRevealed = true);
+    ProgramTableColumnMask getVisibleColumns() const;
 
     bool canFetchMore(const QModelIndex &parent) const override;
     void fetchMore(const QModelIndex &parent) override;
@@ -47,10 +121,43 @@ public:
     void loadCurrentWindow();
     void loadRows(int startRow, int endRow);
 private:
+    QString projectedQuery() const;
+    void resizeToExactRowCount(int count);
+    void loadOrderedRows(int startRow, int endRow);
+    qint64 orderedRowIdAt(int row) const;
+    QVector<QVariant> readRow(const QSqlQuery &query, int firstColumn) const;
+    LoadStrategy chooseStrategy(int rowCount) const;
+    int tunedWindowSize() const;
+    void resetWindow();
+    bool materializeQueryRows();
+    void materializeOrderedRows();
+    void fillFromMaterializedRows();
 
     QSqlDatabase db;
-    QString baseQuery;
+    std::shared_ptr<const DatasetSnapshot> snapshot;
+    QString baseQuery; // "FROM ... WHERE ... ORDER BY ..."; the projection is added per load
+    QVariantList baseBindValues;
+    ProgramTableColumnMask visibleColumns = allProgramTableColumns;
     QString countQuery;
     QVector<QVector<QVariant>> modelData;
+    QString orderedTableName;
+    QVector<qint64> orderedRowIds;
+    int totalRowCount = -1;
+    bool rowCountIsEstimate = false;
+    RowCountMetrics rowCountMetrics;
+    QElapsedTimer exactCountTimer;
     DataWindow dataWindow;
+
+    LoadStrategy loadStrategy = LoadStrategy::Windowed;
+    int materializeRowLimit = 3000;
+    int materializeBudgetMilliseconds = 150;
+    int viewportRowCount = 0;
+    FetchCost fetchCost;
+    qint64 issuedQueryCount = 0;
+    mutable int lastRequestedRow = 0; // viewport position as seen through data()
+    // Rows of the last materialized ordered result by rowid; header clicks on
+    // the same filter only permute them
+    QString materializedTableName;
+    ProgramTableColumnMask materializedColumns = 0;
+    QHash<qint64, QVector<QVariant>> materializedRowsById;
 };
@@ -17,444 +17,648 @@ You should have received a copy of the GNU General Public License along with thi
 #include <QCollator>
 #include <QCollator>
 #include <QFile>
+#include <QFileInfo>
 #include <QStandardPaths>
 #include <QDir>
 #include <QtGlobal>
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <atomic>
 #include "Utils/SQLiteUtil.hpp"
-#include "Utils/StringUtil.hpp"
+#include "Data/RankSorter.hpp"
+#include "Data/ProgramFilter.hpp"
+#include "QueryBuilder.hpp"
+#include "LookupLists.hpp"
+
+AcademyScopeBackEnd::AcademyScopeBackEnd(StartupMode startupMode, SnapshotSharing snapshotSharing) {
+    datasetManager.setSnapshotSharing(snapshotSharing);
+
+    QObject::connect(&rowCountWatcher, &QFutureWatcher<int>::finished, &rowCountWatcher, [this]() {
+        // A later populate may already have published its own count
+        if (dataModel.getTotalRowCount() < 0)
+            dataModel.setTotalRowCount(rowCountWatcher.result());
+    });
+
+    // Every published snapshot, the first one included, stamps the cache and refreshes its hot entries;
+    // year join indexes are rebuilt on demand
+    QObject::connect(&datasetManager, &DatasetManager::snapshotPublished, &cacheRefreshWatcher, [this]() {
+        const std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+        if (!snapshot)
+            return;
+        yearCatalog.clearIndexes();
+        resultCache.open(snapshot->getDatabasePath(), snapshot->getFileStamp());
+        refreshResultCache();
+    });
+    QObject::connect(&cacheRefreshWatcher, &QFutureWatcherBase::finished, &cacheRefreshWatcher, [this]() {
+        const std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+        // Results of a snapshot replaced meanwhile are dropped and computed again
+        if (!snapshot || snapshot->getFileStamp() != cacheRefreshStamp) {
+            refreshResultCache();
+            return;
+        }
+        for (const auto &[parameters, result] : cacheRefreshWatcher.result())
+            resultCache.store(parameters, result);
+        resultCache.save();
+    });
+
+    auto onSnapshotReady = [this](const QString &dbPath) {
+        yearCatalog.setDatabaseDirectory(QFileInfo(dbPath).absolutePath());
+        datasetManager.setWatchingEnabled(true);
+        acquireCurrentSnapshot();
+    };
+    // A blocking start leaves the first query to the caller, as it always did
+    std::function<void()> loadFirstResult;
+    if (startupMode == StartupMode::Staged)
+        loadFirstResult = [this]() { populateProgramTable(AcademyScopeParameters()); };
+
+    // Queued, so the view's sort() returns before the model is reset
+    QObject::connect(&dataModel, &AcademyScopeModel::sortRequested, &dataModel,
+                     [this](ProgramTableColumn column, Qt::SortOrder order) {
+        if (!lastParameters)
+            return;
+        AcademyScopeParameters parameters = *lastParameters;
+        parameters.order.keys.clear();
+        parameters.order.column = column;
+        parameters.order.direction = order;
+        parameters.order.toBeOrdered = true;
+        populateProgramTable(parameters);
+    }, Qt::QueuedConnection);
+
+    registerMemoryComponents();
+
+    startupPipeline = std::make_unique<StartupPipeline>(datasetManager, onSnapshotReady, loadFirstResult);
+    if (startupMode == StartupMode::Staged)
+        startupPipeline->start();
+    else if (!startupPipeline->runBlocking())
+        qDebug() << "Veritabanı açılamadı";
+}
 
-AcademyScopeBackEnd::AcademyScopeBackEnd() {
-    initDB();
+AcademyScopeBackEnd::~AcademyScopeBackEnd() {
+    rowCountWatcher.waitForFinished();
+    cacheRefreshWatcher.waitForFinished();
+    resultCache.save();
 }
 
 QList<University> AcademyScopeBackEnd::getUniversities() const {
-    QSqlQuery query;
-    QList<University> universities;
-
-    if (query.exec("SELECT UniversiteID, UniversiteAdi FROM Universiteler")) {
-        while (query.next()) {
-            University university;
-            university.id = query.value(0).toInt();
-            university.name = query.value(1).toString();
-            universities.append(university);
-        }
-    }
+    const std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+    return snapshot ? snapshot->getUniversities() : QList<University>();
+}
 
-    // Sorts with Turkish collator
-    QCollator collator(QLocale(QLocale::Turkish, QLocale::Turkey));
-    std::sort(universities.begin(), universities.end(),
-              [&](const University &a, const University &b) {
-                  return collator.compare(a.name, b.name) < 0;
-              });
+QList<QString> AcademyScopeBackEnd::getDepartments() const {
+    const std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+    return snapshot ? snapshot->getDepartments() : QList<QString>();
+}
 
-    return universities;
+void AcademyScopeBackEnd::populateProgramTable(const AcademyScopeParameters &academyScopeParameters) {
+    lastParameters = academyScopeParameters;
+    acquireCurrentSnapshot();
+    // Before the query is set, so hidden columns are never fetched
+    dataModel.setVisibleColumns(visibleColumnMask(academyScopeParameters), false);
+    if (academyScopeParameters.year.has_value()
+        && (!activeSnapshot || !yearCatalog.ensureAttached(activeSnapshot->getDatabase(), *academyScopeParameters.year))) {
+        // Queries against a missing y<year> schema would only fail row by row
+        qWarning() << "[AcademyScopeBackEnd] No data for year" << *academyScopeParameters.year;
+        dataModel.clear();
+        lastSortedRowsShown = false;
+        return;
+    }
+    if (!populateProgramTableFromCache(academyScopeParameters)
+        && !populateProgramTableFromRanks(academyScopeParameters)) {
+        QString baseQuery = QueryBuilder::buildFilteredSql(academyScopeParameters);
+        const QVariantList bindValues = QueryBuilder::buildFilterBindValues(academyScopeParameters);
+        if (academyScopeParameters.topK > 0) {
+            // First screen now, total later: COUNT(*) would visit every matching row first
+            dataModel.setBaseQuery(baseQuery, bindValues, academyScopeParameters.topK);
+            countFilteredRowsInBackground(academyScopeParameters);
+        } else {
+            // Sized from a sample at once, corrected when the exact count arrives
+            bool exact = false;
+            const int estimate = estimateFilteredRowCount(academyScopeParameters, &exact);
+            dataModel.setEstimatedBaseQuery(baseQuery, bindValues, estimate);
+            if (exact)
+                dataModel.setTotalRowCount(estimate);
+            else
+                countFilteredRowsInBackground(academyScopeParameters);
+        }
+        lastSortedRowsShown = false;
+    }
+    // A new result is when the footprint usually grows
+    memoryAccountant.enforceBudget();
 }
 
-void AcademyScopeBackEnd::initDB() {
-    db = QSqlDatabase::addDatabase("QSQLITE");
+void AcademyScopeBackEnd::acquireCurrentSnapshot()
+{
+    std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+    if (!snapshot || snapshot == activeSnapshot)
+        return;
 
-    QString dbPath = SQLiteUtil::resolveDatabasePath();
+    // A new dataset version was published; cached row sets refer to the old one
+    activeSnapshot = snapshot;
+    dataModel.setSnapshot(activeSnapshot);
+    lastFilterKey.clear();
+    lastFilteredRows.clear();
+    lastSortSignature.clear();
+    lastSortedRows.clear();
+    lastSortedRowsShown = false;
+}
 
-    db.setDatabaseName(dbPath);
+int AcademyScopeBackEnd::estimateFilteredRowCount(const AcademyScopeParameters &academyScopeParameters, bool *exact)
+{
+    constexpr qint64 sampleSize = 1000;
+    *exact = false;
+    if (!activeSnapshot)
+        return 0;
+
+    // MIN/MAX(rowid) are single b-tree seeks
+    QSqlQuery query(activeSnapshot->getDatabase());
+    if (!query.exec("SELECT MIN(rowid), MAX(rowid) FROM " + QueryBuilder::buildTableName(academyScopeParameters))
+        || !query.next() || query.value(0).isNull())
+        return 0;
+    const qint64 firstRowId = query.value(0).toLongLong();
+    const qint64 lastRowId = query.value(1).toLongLong();
+    const qint64 stride = std::max<qint64>(1, (lastRowId - firstRowId + 1) / sampleSize);
+
+    // Every rowid of the range is sampled with the same probability, 1 / stride,
+    // whether or not it exists, so gaps in the numbering do not bias the estimate
+    const QString sampledSql = QueryBuilder::buildSampledFilterSql(academyScopeParameters, firstRowId, lastRowId,
+                                                                   stride);
+    if (!SQLiteUtil::exec(query, "SELECT COUNT(*) " + sampledSql,
+                          QueryBuilder::buildFilterBindValues(academyScopeParameters))
+        || !query.next()) {
+        qWarning() << "[AcademyScopeBackEnd] Sampled COUNT query failed:" << query.lastError().text();
+        return 0;
+    }
+    *exact = stride == 1;
+    return int(query.value(0).toLongLong() * stride);
+}
 
-    if (!db.open()) {
-        qDebug() << "Veritabanı açılamadı:" << db.lastError().text();
+void AcademyScopeBackEnd::countFilteredRowsInBackground(const AcademyScopeParameters &academyScopeParameters)
+{
+    if (!activeSnapshot)
         return;
-    }
-    dataModel.setDatabase(db);
-}
 
-QList<QString> AcademyScopeBackEnd::getDepartments() const {
-    /*
-    QStandardItem* firstItem = model->item(0);
-    firstItem->setFlags(firstItem->flags() & ~Qt::ItemIsEnabled);
-    firstItem->setForeground(QBrush(Qt::gray));
-    */
-    QSqlQuery query;
-    QList<QString> departments;
-
-    QString selectionQuery = "SELECT DISTINCT\n\
-        TRIM(\n\
-            CASE\n\
-                WHEN instr(ProgramAdi, '(') > 0\n\
-            THEN substr(ProgramAdi, 1, instr(ProgramAdi, '(') - 1)\n\
-            ELSE ProgramAdi\n\
-                END\n\
-            ) AS AnaProgramAdi\n\
-            FROM YKS;\
-           ";
-
-    if (query.exec(selectionQuery)) {
-        while (query.next()) {
-            QString department = query.value(0).toString();
-            departments.append(department);
+    // The snapshot's connection belongs to this thread; the count opens its own
+    static std::atomic_int countConnectionSerial{0};
+    const QString connectionName = QString("row-count-%1").arg(++countConnectionSerial);
+    // Counted on the snapshot's versioned file, so the total matches the rows shown
+    const std::shared_ptr<const DatasetSnapshot> snapshot = activeSnapshot;
+    const QString countSql = "SELECT COUNT(*) " + QueryBuilder::buildFilterSql(academyScopeParameters);
+    const QVariantList bindValues = QueryBuilder::buildFilterBindValues(academyScopeParameters);
+    const std::optional<int> year = academyScopeParameters.year;
+    const YearCatalog *catalog = &yearCatalog;
+
+    rowCountWatcher.setFuture(QtConcurrent::run([connectionName, snapshot, countSql, bindValues, year, catalog]() {
+        int count = 0;
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+            const bool opened = SQLiteUtil::openImmutable(db, snapshot->getSnapshotFilePath());
+            if (opened)
+                SQLiteUtil::configureConnection(db);
+            if (opened && (!year.has_value() || catalog->ensureAttached(db, *year))) {
+                QSqlQuery query(db);
+                if (SQLiteUtil::exec(query, countSql, bindValues) && query.next())
+                    count = query.value(0).toInt();
+                else
+                    qWarning() << "[AcademyScopeBackEnd] COUNT query failed:" << query.lastError().text();
+            }
+            db.close();
         }
-    }
+        QSqlDatabase::removeDatabase(connectionName);
+        return count;
+    }));
+}
 
-    QCollator collator(QLocale(QLocale::Turkish, QLocale::Turkey));
-    std::sort(departments.begin(), departments.end(),
-              [&](const QString &a, const QString &b) {
-                  return collator.compare(a, b) < 0;
-              });
+std::shared_ptr<const ProgramDataset> AcademyScopeBackEnd::getDataset(PlacementType placementType)
+{
+    const std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+    return snapshot ? snapshot->getDataset(placementType) : nullptr;
+}
 
-    return departments;
+StartupPipeline *AcademyScopeBackEnd::getStartupPipeline()
+{
+    return startupPipeline.get();
 }
 
-void AcademyScopeBackEnd::populateProgramTable(const AcademyScopeParameters &academyScopeParameters) {
-    QString baseQuery = buildFilteredSql(academyScopeParameters);
-    dataModel.setBaseQuery(baseQuery);
-    hideUnnecessaryColumnsOnTheProgramTable(academyScopeParameters);
+DatasetManager *AcademyScopeBackEnd::getDatasetManager()
+{
+    return &datasetManager;
 }
 
-AcademyScopeModel *AcademyScopeBackEnd::getDataModel()
+QList<int> AcademyScopeBackEnd::getAvailableYears() const
 {
-    return &dataModel;
+    return yearCatalog.getAvailableYears();
 }
 
-QStringList AcademyScopeBackEnd::getProgramTableColumnsToBeShown(const AcademyScopeParameters &parameters)
+std::optional<QVector<ProgramYearRecord>> AcademyScopeBackEnd::getProgramTrend(qint64 programCode, int fromYear,
+                                                                               int toYear)
 {
-    QMap<ProgramTableColumn, ProgramTableColumnInfo> columnMap = ProgramTableColumns::getColumnMap();
-
-    /*
-
-    //Unused
-    columnMap.remove(ProgramTableColumn::GenelBasariSirasi);
-    columnMap.remove(ProgramTableColumn::OkulBirincisiBasariSirasi);
-    columnMap.remove(ProgramTableColumn::SehitGaziYakiniBasariSirasi);
-    columnMap.remove(ProgramTableColumn::DepremzedeBasariSirasi);
-    columnMap.remove(ProgramTableColumn::Kadin34PlusBasariSirasi);
-    columnMap.remove();
-    columnMap.remove();
-
-    if(ui->checkBoxGenel->isChecked() || ui->checkBoxKKTCUyruklu->isChecked() || ui->checkBoxMTOK->isChecked()) {
-        ui->programTable->showColumn((int) ProgramTableColumn::GenelKontenjan);
-        ui->programTable->showColumn((int) ProgramTableColumn::GenelYerlesen);
-        ui->programTable->showColumn((int) ProgramTableColumn::GenelEnKucukPuan);
-    }
-    else {
-        columnMap.remove(ProgramTableColumn::GenelKontenjan);
-        columnMap.remove(ProgramTableColumn::GenelYerlesen);
-        columnMap.remove(ProgramTableColumn::GenelEnKucukPuan);
-    }
+    return yearCatalog.getProgramTrend(programCode, fromYear, toYear);
+}
 
-    if(ui->checkBoxOkulBirincisi->isChecked()) {
-        ui->programTable->showColumn((int) ProgramTableColumn::OkulBirincisiKontenjan);
-        ui->programTable->showColumn((int) ProgramTableColumn::OkulBirincisiYerlesen);
-        ui->programTable->showColumn((int) ProgramTableColumn::OkulBirincisiEnKucukPuan);
-    }
-    else {
-        ui->programTable->hideColumn((int) );
-        columnMap.remove(ProgramTableColumn::OkulBirincisiKontenjan);
+std::optional<QHash<qint64, QVector<ProgramYearRecord>>> AcademyScopeBackEnd::getProgramTrends(
+    const QVector<qint64> &programCodes, int fromYear, int toYear)
+{
+    return yearCatalog.getProgramTrends(programCodes, fromYear, toYear);
+}
 
-        ui->programTable->hideColumn();
-        columnMap.remove(ProgramTableColumn::OkulBirincisiYerlesen);
+bool AcademyScopeBackEnd::populateProgramTableFromRanks(const AcademyScopeParameters &parameters)
+{
+    // In-memory datasets cover the current year only. Without sort keys the
+    // order is the ProgramKodu tie-break alone, which is the dataset's row order.
+    const QList<SortKey> sortKeys = parameters.order.sortKeys();
+    if (parameters.year.has_value())
+        return false;
+
+    if (!activeSnapshot)
+        return false;
+    std::shared_ptr<const ProgramDataset> dataset = activeSnapshot->getDataset(parameters.placementType);
+    if (!dataset)
+        return false;
+
+    // Every key is ranked in its own direction, NULLs last, ties by ProgramKodu ascending
+    QVector<RankSorter::Key> rankKeys;
+    QString sortSignature = "rank:"; // never empty, unlike a cleared signature
+    for (const SortKey &key : sortKeys) {
+        const int column = dataset->columnIndex(QueryBuilder::getDbColumnNameFromProgramTableColumnIndex(key.column));
+        if (column < 0)
+            return false;
+        const bool descending = key.direction == Qt::DescendingOrder;
+        rankKeys.append({dataset->ranks(column), dataset->rankCount(column), descending});
+        sortSignature += QString("%1%2;").arg(column).arg(descending ? '-' : '+');
+    }
+
+    // The filter only runs again when it actually changed; header clicks reuse the row set.
+    // It runs on the dataset: bitmaps for the categorical part, the rest per row.
+    const QString filterKey = ProgramFilter::filterKey(parameters);
+    if (filterKey != lastFilterKey) {
+        QElapsedTimer timer;
+        timer.start();
+        // Dataset rows are in ProgramKodu order, so the filtered rows are in tie-break order
+        lastFilteredRows = ProgramFilter::filterRows(*activeSnapshot, parameters);
+        lastFilterKey = filterKey;
+        lastSortSignature.clear();
+        lastSortStateMilliseconds = timer.nsecsElapsed() / 1e6;
+    }
+
+    if (parameters.topK > 0) {
+        // Only the first screen is ordered; the filter already gave the exact total
+        QVector<int> topRows = lastFilteredRows;
+        RankSorter::selectTopRows(topRows, rankKeys, parameters.topK);
+
+        QVector<qint64> rowIds;
+        rowIds.reserve(topRows.size());
+        for (int row : topRows)
+            rowIds.append(dataset->rowId(row));
+        dataModel.setOrderedRows(dataset->tableName(), rowIds, lastFilteredRows.size());
+        // The model no longer holds the full permutation
+        lastSortedRowsShown = false;
+        return true;
+    }
+
+    const bool resorted = sortSignature != lastSortSignature;
+    if (resorted) {
+        QElapsedTimer timer;
+        timer.start();
+        lastSortedRows = lastFilteredRows;
+        RankSorter::sortRows(lastSortedRows, rankKeys);
+        lastSortSignature = sortSignature;
+        lastSortStateMilliseconds += timer.nsecsElapsed() / 1e6;
+    }
+    if (resorted || !lastSortedRowsShown) {
+        QVector<qint64> rowIds;
+        rowIds.reserve(lastSortedRows.size());
+        for (int row : lastSortedRows)
+            rowIds.append(dataset->rowId(row));
+        dataModel.setOrderedRows(dataset->tableName(), rowIds);
+        lastSortedRowsShown = true;
+    }
+
+    // Only parameter sets asked for repeatedly are worth keeping for the next start
+    const int programCodeColumn = dataset->columnIndex("ProgramKodu");
+    if (programCodeColumn >= 0 && resultCache.wantsResult(parameters)) {
+        CachedResult result;
+        result.count = lastSortedRows.size();
+        result.programCodes.reserve(lastSortedRows.size());
+        for (int row : lastSortedRows)
+            result.programCodes.append(qint64(dataset->number(programCodeColumn, row)));
+        resultCache.store(parameters, result);
+    }
+
+    return true;
+}
 
-        ui->programTable->hideColumn((int) ProgramTableColumn::OkulBirincisiEnKucukPuan);
-        columnMap.remove();
+bool AcademyScopeBackEnd::populateProgramTableFromCache(const AcademyScopeParameters &parameters)
+{
+    if (!activeSnapshot)
+        return false;
+    const std::optional<CachedResult> cached = resultCache.lookup(parameters);
+    if (!cached)
+        return false;
+
+    // ProgramKodu -> row goes through the join index, which covers both tables
+    const std::shared_ptr<const ProgramDataset> dataset = activeSnapshot->getDataset(parameters.placementType);
+    const std::shared_ptr<const ProgramJoinIndex> joinIndex = activeSnapshot->getProgramJoinIndex();
+    if (!dataset || !joinIndex)
+        return false;
+
+    const int rowLimit = parameters.topK > 0 ? std::min<int>(parameters.topK, cached->programCodes.size())
+                                             : cached->programCodes.size();
+    QVector<qint64> rowIds;
+    rowIds.reserve(rowLimit);
+    for (int i = 0; i < rowLimit; ++i) {
+        const int pairIndex = joinIndex->pairIndexOfProgramCode(cached->programCodes[i]);
+        if (pairIndex < 0)
+            return false;
+        const ProgramJoinIndex::Pair &pair = joinIndex->pair(pairIndex);
+        const int row = parameters.placementType == PlacementType::Additional ? pair.additionalRow : pair.regularRow;
+        if (row < 0)
+            return false;
+        rowIds.append(dataset->rowId(row));
+    }
+
+    dataModel.setOrderedRows(dataset->tableName(), rowIds, cached->count);
+    // The sort state stays valid for its own parameters; only the model shows another result
+    lastSortedRowsShown = false;
+    return true;
+}
 
-    }
+void AcademyScopeBackEnd::refreshResultCache()
+{
+    if (cacheRefreshWatcher.isRunning())
+        return;
+    const std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+    if (!snapshot)
+        return;
+    const QVector<AcademyScopeParameters> stale = resultCache.staleHotParameters();
+    if (stale.isEmpty())
+        return;
 
-    if(ui->checkBoxSehitGaziYakini->isChecked()) {
-        ui->programTable->showColumn((int) ProgramTableColumn::SehitGaziYakiniKontenjan);
-        ui->programTable->showColumn((int) ProgramTableColumn::SehitGaziYakiniYerlesen);
-        ui->programTable->showColumn((int) ProgramTableColumn::SehitGaziYakiniEnKucukPuan);
-    }
-    else {
-        ui->programTable->hideColumn((int) ProgramTableColumn::SehitGaziYakiniKontenjan);
-        ui->programTable->hideColumn((int) ProgramTableColumn::SehitGaziYakiniYerlesen);
-        ui->programTable->hideColumn((int) ProgramTableColumn::SehitGaziYakiniEnKucukPuan);
-    }
+    cacheRefreshStamp = snapshot->getFileStamp();
+    cacheRefreshWatcher.setFuture(QtConcurrent::run([snapshot, stale]() {
+        QVector<std::pair<AcademyScopeParameters, CachedResult>> results;
+        for (const AcademyScopeParameters &parameters : stale)
+            if (const std::optional<CachedResult> result = ResultCache::compute(*snapshot, parameters))
+                results.append({parameters, *result});
+        return results;
+    }));
+}
 
+void AcademyScopeBackEnd::registerMemoryComponents()
+{
+    MemoryComponent snapshot;
+    snapshot.name = "snapshot";
+    snapshot.usageBytes = [this]() {
+        const std::shared_ptr<const DatasetSnapshot> current = datasetManager.getCurrentSnapshot();
+        return current ? current->estimatedMemoryBytes() : 0;
+    };
+    memoryAccountant.registerComponent(snapshot);
+
+    MemoryComponent table;
+    table.name = "result table";
+    table.usageBytes = [this]() { return dataModel.estimatedMemoryBytes(); };
+    table.release = [this](qint64 targetBytes) { return dataModel.releaseMemory(targetBytes); };
+    table.rebuildCostMilliseconds = [this]() {
+        return std::max(0.0, dataModel.getFetchCost().estimateMilliseconds(dataModel.rowCount()));
+    };
+    memoryAccountant.registerComponent(table);
 
-    if(ui->checkBoxDepremzede->isChecked()) {
-        ui->programTable->showColumn((int) ProgramTableColumn::DepremzedeKontenjan);
-        ui->programTable->showColumn((int) ProgramTableColumn::DepremzedeYerlesen);
-        ui->programTable->showColumn((int) ProgramTableColumn::DepremzedeEnKucukPuan);
-    }
-    else {
-        ui->programTable->hideColumn((int) ProgramTableColumn::DepremzedeKontenjan);
-        ui->programTable->hideColumn((int) ProgramTableColumn::DepremzedeYerlesen);
-        ui->programTable->hideColumn((int) ProgramTableColumn::DepremzedeEnKucukPuan);
-    }
+    MemoryComponent sortState;
+    sortState.name = "sort state";
+    sortState.usageBytes = [this]() {
+        return (lastFilteredRows.capacity() + lastSortedRows.capacity()) * qint64(sizeof(int));
+    };
+    sortState.release = [this](qint64) {
+        const qint64 bytes = (lastFilteredRows.capacity() + lastSortedRows.capacity()) * qint64(sizeof(int));
+        lastFilteredRows = QVector<int>();
+        lastSortedRows = QVector<int>();
+        lastFilterKey.clear();
+        lastSortSignature.clear();
+        lastSortedRowsShown = false;
+        return bytes;
+    };
+    sortState.rebuildCostMilliseconds = [this]() { return lastSortStateMilliseconds; };
+    memoryAccountant.registerComponent(sortState);
+
+    MemoryComponent cache;
+    cache.name = "result cache";
+    cache.usageBytes = [this]() { return resultCache.estimatedMemoryBytes(); };
+    cache.release = [this](qint64 targetBytes) { return resultCache.releaseMemory(targetBytes); };
+    // Evicted entries come back from the mapped file; only the page-in is paid
+    cache.rebuildCostMilliseconds = []() { return 1.0; };
+    memoryAccountant.registerComponent(cache);
+
+    MemoryComponent yearIndexes;
+    yearIndexes.name = "year indexes";
+    yearIndexes.usageBytes = [this]() { return yearCatalog.estimatedMemoryBytes(); };
+    yearIndexes.release = [this](qint64) {
+        const qint64 bytes = yearCatalog.estimatedMemoryBytes();
+        yearCatalog.clearIndexes();
+        return bytes;
+    };
+    yearIndexes.rebuildCostMilliseconds = [this]() { return yearCatalog.getIndexBuildMilliseconds(); };
+    memoryAccountant.registerComponent(yearIndexes);
+
+    MemoryComponent comparison;
+    comparison.name = "comparison table";
+    comparison.usageBytes = [this]() { return comparisonModel.estimatedMemoryBytes(); };
+    comparison.release = [this](qint64) {
+        const qint64 bytes = comparisonModel.estimatedMemoryBytes();
+        comparisonModel.clear();
+        return bytes;
+    };
+    comparison.rebuildCostMilliseconds = [this]() { return lastComparisonMilliseconds; };
+    memoryAccountant.registerComponent(comparison);
+
+    // A result stays on the snapshot it was built from until the next populate,
+    // so a reload leaves the previous version alive next to the published one
+    auto retainedSnapshotBytes = [this]() {
+        const std::shared_ptr<const DatasetSnapshot> current = datasetManager.getCurrentSnapshot();
+        const std::shared_ptr<const DatasetSnapshot> &compared = comparisonModel.getSnapshot();
+        qint64 bytes = 0;
+        if (activeSnapshot && activeSnapshot != current)
+            bytes += activeSnapshot->estimatedMemoryBytes();
+        if (compared && compared != current && compared != activeSnapshot)
+            bytes += compared->estimatedMemoryBytes();
+        return bytes;
+    };
+    MemoryComponent previousSnapshot;
+    previousSnapshot.name = "previous snapshot";
+    previousSnapshot.usageBytes = retainedSnapshotBytes;
+    previousSnapshot.release = [this, retainedSnapshotBytes](qint64) {
+        const qint64 bytes = retainedSnapshotBytes();
+        const std::shared_ptr<const DatasetSnapshot> current = datasetManager.getCurrentSnapshot();
+        if (comparisonModel.getSnapshot() && comparisonModel.getSnapshot() != current)
+            comparisonModel.clear();
+        if (activeSnapshot && activeSnapshot != current) {
+            acquireCurrentSnapshot();
+            // The shown result belongs to the old version; it is queried again on
+            // the current one once the accountant is done
+            QMetaObject::invokeMethod(&dataModel, [this]() {
+                if (!lastParameters)
+                    return;
+                const AcademyScopeParameters parameters = *lastParameters;
+                populateProgramTable(parameters);
+            }, Qt::QueuedConnection);
+        }
+        return bytes;
+    };
+    previousSnapshot.rebuildCostMilliseconds = [this]() {
+        return std::max(0.0, dataModel.getFetchCost().estimateMilliseconds(dataModel.rowCount()));
+    };
+    memoryAccountant.registerComponent(previousSnapshot);
 
+    memoryAccountant.setReportInterval(60 * 1000);
+}
 
-    if(ui->checkBoxKadin34->isChecked()) {
-        ui->programTable->showColumn((int) ProgramTableColumn::Kadin34PlusKontenjan);
-        ui->programTable->showColumn((int) ProgramTableColumn::Kadin34PlusYerlesen);
-        ui->programTable->showColumn((int) ProgramTableColumn::Kadin34PlusEnKucukPuan);
-    }
-    else {
-        ui->programTable->hideColumn((int) ProgramTableColumn::Kadin34PlusKontenjan);
-        ui->programTable->hideColumn((int) ProgramTableColumn::Kadin34PlusYerlesen);
-        ui->programTable->hideColumn((int) ProgramTableColumn::Kadin34PlusEnKucukPuan);
-    }
+void AcademyScopeBackEnd::setMemoryBudget(qint64 bytes)
+{
+    memoryAccountant.setBudgetBytes(bytes);
+}
 
-    //Ek kontenjanda yok
-    if(parameters.placementType == PlacementType::Regular) {
-        if(ui->checkBoxGenel->isChecked())
-            ui->programTable->showColumn((int) ProgramTableColumn::GenelYerlesen);
-        if(ui->checkBoxOkulBirincisi->isChecked())
-            ui->programTable->showColumn((int) ProgramTableColumn::OkulBirincisiYerlesen);
-        if(ui->checkBoxSehitGaziYakini->isChecked())
-            ui->programTable->showColumn((int) ProgramTableColumn::SehitGaziYakiniYerlesen);
-        if(ui->checkBoxDepremzede->isChecked())
-            ui->programTable->showColumn((int) ProgramTableColumn::DepremzedeYerlesen);
-        if(ui->checkBoxKadin34->isChecked())
-            ui->programTable->showColumn((int) ProgramTableColumn::Kadin34PlusYerlesen);
-    }
-    else {
-        ui->programTable->hideColumn((int) ProgramTableColumn::GenelYerlesen);
-        ui->programTable->hideColumn((int) ProgramTableColumn::OkulBirincisiYerlesen);
-        ui->programTable->hideColumn((int) ProgramTableColumn::SehitGaziYakiniYerlesen);
-        ui->programTable->hideColumn((int) ProgramTableColumn::DepremzedeYerlesen);
-        ui->programTable->hideColumn((int) ProgramTableColumn::Kadin34PlusYerlesen);
-    }
-    */
+MemoryAccountant *AcademyScopeBackEnd::getMemoryAccountant()
+{
+    return &memoryAccountant;
 }
 
-void AcademyScopeBackEnd::hideUnnecessaryColumnsOnTheProgramTable(const AcademyScopeParameters &academyScopeParameters) const {
-    if(academyScopeParameters.selectedQuotaTypes.regularQuota || academyScopeParameters.selectedQuotaTypes.trncNationalsQuota || academyScopeParameters.selectedQuotaTypes.mtokQuota) {
-        dataModel.showColumn(ProgramTableColumn::GenelKontenjan);
-        dataModel.showColumn(ProgramTableColumn::GenelYerlesen);
-        dataModel.showColumn(ProgramTableColumn::GenelEnKucukPuan);
-    }
-    else {
-        dataModel.hideColumn(ProgramTableColumn::GenelKontenjan);
-        dataModel.hideColumn(ProgramTableColumn::GenelYerlesen);
-        dataModel.hideColumn(ProgramTableColumn::GenelEnKucukPuan);
-    }
+AcademyScopeModel *AcademyScopeBackEnd::getDataModel()
+{
+    return &dataModel;
+}
 
-    if(academyScopeParameters.selectedQuotaTypes.highSchoolValedictoriansQuota) {
-        dataModel.showColumn(ProgramTableColumn::OkulBirincisiKontenjan);
-        dataModel.showColumn(ProgramTableColumn::OkulBirincisiYerlesen);
-        dataModel.showColumn(ProgramTableColumn::OkulBirincisiEnKucukPuan);
-    }
-    else {
-        dataModel.hideColumn(ProgramTableColumn::OkulBirincisiKontenjan);
-        dataModel.hideColumn(ProgramTableColumn::OkulBirincisiYerlesen);
-        dataModel.hideColumn(ProgramTableColumn::OkulBirincisiEnKucukPuan);
-    }
+void AcademyScopeBackEnd::populateComparisonTable(const AcademyScopeParameters &academyScopeParameters)
+{
+    acquireCurrentSnapshot();
+    QElapsedTimer timer;
+    timer.start();
+    comparisonModel.setComparison(activeSnapshot, academyScopeParameters);
+    lastComparisonMilliseconds = timer.nsecsElapsed() / 1e6;
+}
 
-    if(academyScopeParameters.selectedQuotaTypes.martyrsAndVeteransQuota) {
-        dataModel.showColumn(ProgramTableColumn::SehitGaziYakiniKontenjan);
-        dataModel.showColumn(ProgramTableColumn::SehitGaziYakiniYerlesen);
-        dataModel.showColumn(ProgramTableColumn::SehitGaziYakiniEnKucukPuan);
-    }
-    else {
-        dataModel.hideColumn(ProgramTableColumn::SehitGaziYakiniKontenjan);
-        dataModel.hideColumn(ProgramTableColumn::SehitGaziYakiniYerlesen);
-        dataModel.hideColumn(ProgramTableColumn::SehitGaziYakiniEnKucukPuan);
-    }
+PlacementComparisonModel *AcademyScopeBackEnd::getComparisonModel()
+{
+    return &comparisonModel;
+}
 
+ExportResult AcademyScopeBackEnd::exportFilteredResults(const AcademyScopeParameters &parameters,
+                                                       const QList<ProgramTableColumn> &columns,
+                                                       QIODevice *sink,
+                                                       const ExportOptions &options)
+{
+    // Holding the snapshot keeps its connection valid for the whole export
+    const std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+    if (!snapshot)
+        return ExportResult::Failed;
+    if (parameters.year.has_value() && !yearCatalog.ensureAttached(snapshot->getDatabase(), *parameters.year))
+        return ExportResult::Failed;
+    return ResultExporter::exportRows(snapshot->getDatabase(), parameters, columns, sink, options);
+}
 
-    if(academyScopeParameters.selectedQuotaTypes.earthquakeVictimsQuota) {
-        dataModel.showColumn(ProgramTableColumn::DepremzedeKontenjan);
-        dataModel.showColumn(ProgramTableColumn::DepremzedeYerlesen);
-        dataModel.showColumn(ProgramTableColumn::DepremzedeEnKucukPuan);
-    }
-    else {
-        dataModel.hideColumn(ProgramTableColumn::DepremzedeKontenjan);
-        dataModel.hideColumn(ProgramTableColumn::DepremzedeYerlesen);
-        dataModel.hideColumn(ProgramTableColumn::DepremzedeEnKucukPuan);
+ExportResult AcademyScopeBackEnd::exportFilteredResults(const AcademyScopeParameters &parameters,
+                                                       const QList<ProgramTableColumn> &columns,
+                                                       const QString &filePath,
+                                                       const ExportOptions &options)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[AcademyScopeBackEnd] Export file could not be opened:" << file.errorString();
+        return ExportResult::Failed;
     }
 
+    const ExportResult result = exportFilteredResults(parameters, columns, &file, options);
+    file.close();
+    if (result != ExportResult::Completed)
+        file.remove(); // no partial reports
+    return result;
+}
 
-    if(academyScopeParameters.selectedQuotaTypes.women34PlusQuota) {
-        dataModel.showColumn(ProgramTableColumn::Kadin34PlusKontenjan);
-        dataModel.showColumn(ProgramTableColumn::Kadin34PlusYerlesen);
-        dataModel.showColumn(ProgramTableColumn::Kadin34PlusEnKucukPuan);
-    }
-    else {
-        dataModel.hideColumn(ProgramTableColumn::Kadin34PlusKontenjan);
-        dataModel.hideColumn(ProgramTableColumn::Kadin34PlusYerlesen);
-        dataModel.hideColumn(ProgramTableColumn::Kadin34PlusEnKucukPuan);
-    }
+QVector<BatchQueryResult> AcademyScopeBackEnd::evaluateBatch(const QVector<AcademyScopeParameters> &parameterSets,
+                                                             bool countsOnly,
+                                                             BatchQueryStatistics *statistics)
+{
+    const std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+    if (!snapshot)
+        return QVector<BatchQueryResult>(parameterSets.size());
 
-    //Ek kontenjanda yok
-    if(academyScopeParameters.placementType == PlacementType::Regular) {
-        if(academyScopeParameters.selectedQuotaTypes.regularQuota)
-            dataModel.showColumn(ProgramTableColumn::GenelYerlesen);
-        if(academyScopeParameters.selectedQuotaTypes.highSchoolValedictoriansQuota)
-            dataModel.showColumn(ProgramTableColumn::OkulBirincisiYerlesen);
-        if(academyScopeParameters.selectedQuotaTypes.highSchoolValedictoriansQuota)
-            dataModel.showColumn(ProgramTableColumn::SehitGaziYakiniYerlesen);
-        if(academyScopeParameters.selectedQuotaTypes.earthquakeVictimsQuota)
-            dataModel.showColumn(ProgramTableColumn::DepremzedeYerlesen);
-        if(academyScopeParameters.selectedQuotaTypes.women34PlusQuota)
-            dataModel.showColumn(ProgramTableColumn::Kadin34PlusYerlesen);
-    }
-    else {
-        dataModel.hideColumn(ProgramTableColumn::GenelYerlesen);
-        dataModel.hideColumn(ProgramTableColumn::OkulBirincisiYerlesen);
-        dataModel.hideColumn(ProgramTableColumn::SehitGaziYakiniYerlesen);
-        dataModel.hideColumn(ProgramTableColumn::DepremzedeYerlesen);
-        dataModel.hideColumn(ProgramTableColumn::Kadin34PlusYerlesen);
-    }
+    return BatchQueryEvaluator::evaluate(*snapshot, parameterSets, countsOnly, statistics);
 }
 
-void AcademyScopeBackEnd::hideUnusedColumnsOnTheProgramTable() {
-    dataModel.hideColumn(ProgramTableColumn::GenelBasariSirasi);
-    dataModel.hideColumn(ProgramTableColumn::OkulBirincisiBasariSirasi);
-    dataModel.hideColumn(ProgramTableColumn::SehitGaziYakiniBasariSirasi);
-    dataModel.hideColumn(ProgramTableColumn::DepremzedeBasariSirasi);
-    dataModel.hideColumn(ProgramTableColumn::Kadin34PlusBasariSirasi);
+QVector<AggregationGroup> AcademyScopeBackEnd::aggregate(const AcademyScopeParameters &parameters,
+                                                         const QList<ProgramTableColumn> &groupBy,
+                                                         const QList<Aggregate> &aggregates,
+                                                         AggregationStatistics *statistics)
+{
+    const std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+    if (!snapshot)
+        return {};
+
+    return AggregationEngine::aggregate(*snapshot, parameters, groupBy, aggregates, statistics);
 }
 
-void AcademyScopeBackEnd::initializeYKSTableColumnNames()
+QVector<ReachableProgram> AcademyScopeBackEnd::findReachablePrograms(double score,
+                                                                    const AcademyScopeParameters &filters,
+                                                                    ColumnTypes quotaType,
+                                                                    int k)
 {
-    yksTableColumnNames = {
-        "ProgramKodu",
-        "UniversiteTuru",
-        "UniversiteAdi",
-        "FakulteYuksekokulAdi",
-        "ProgramAdi",
-        "PuanTuru",
-        "GenelKontenjan",
-        "GenelYerlesen",
-        "GenelEnKucukPuan",
-        "GenelEnBuyukPuan",
-        "OkulBirincisiKontenjan",
-        "OkulBirincisiYerlesen",
-        "OkulBirincisiEnKucukPuan",
-        "OkulBirincisiEnBuyukPuan",
-        "DepremzedeKontenjan",
-        "DepremzedeYerlesen",
-        "DepremzedeEnKucukPuan",
-        "DepremzedeEnBuyukPuan",
-        "Kadin34Kontenjan",
-        "Kadin34Yerlesen",
-        "Kadin34EnKucukPuan",
-        "Kadin34EnBuyukPuan",
-        "SehitGaziKontenjan",
-        "SehitGaziYerlesen",
-        "SehitGaziEnKucukPuan",
-        "SehitGaziEnBuyukPuan",
-        "Lisans",
-        "UlkeKodu"
-    };
+    const std::shared_ptr<const DatasetSnapshot> snapshot = datasetManager.getCurrentSnapshot();
+    if (!snapshot || k <= 0)
+        return {};
+
+    const std::shared_ptr<const ProgramDataset> dataset = snapshot->getDataset(filters.placementType);
+    const std::shared_ptr<const ScoreIndex> scoreIndex = snapshot->getScoreIndex(filters.placementType);
+    if (!dataset || !scoreIndex) {
+        qWarning() << "[AcademyScopeBackEnd] No score index for the placement type";
+        return {};
+    }
+
+    // The score itself decides reachability; a score window would only hide results
+    AcademyScopeParameters parameters = filters;
+    parameters.scoreInterval = Interval();
+    const ProgramFilter filter(*dataset, parameters);
+    return scoreIndex->findReachable(*dataset, score, filters.trackType, quotaType, k, &filter);
 }
 
-QString AcademyScopeBackEnd::buildFilteredSql(const AcademyScopeParameters &parameters)
+bool AcademyScopeBackEnd::isColumnVisible(ProgramTableColumn column, const AcademyScopeParameters &parameters)
 {
-    QStringList where;
-    QString sql = "FROM ";
-
-    // Base table
-    sql += (parameters.placementType == PlacementType::Additional)
-               ? "EkTercihDetayli" : "YKS";
-
-    // University name
-    if (!parameters.universityName.trimmed().isEmpty())
-        where << QString("UniversiteAdi LIKE '%%1%'")
-                     .arg(StringUtil::toTurkishUpperCase(parameters.universityName));
-
-    // Department
-    if (!parameters.departmentName.trimmed().isEmpty())
-        where << QString("ProgramAdi LIKE '%%1%'")
-                     .arg(StringUtil::toTurkishTitleCase(parameters.departmentName));
-
-    // Country filter
-    switch (parameters.country) {
-    case Country::Turkiye:          where << "UlkeKodu = 90"; break;
-    case Country::Cyprus:           where << "UlkeKodu = 357"; break;
-    case Country::ForeignCountries: where << "UlkeKodu NOT IN (90, 357)"; break;
-    case Country::AllCountries:
-        break;
-    }
-
-    // Degree type
-    if (parameters.degreeType == DegreeType::Bachelor)      where << "Lisans = 1";
-    else if (parameters.degreeType == DegreeType::Associate) where << "Lisans = 0";
-
-    // University type
-    if (parameters.universityType == UniversityType::Government)      where << "DevletUniversitesi = 1";
-    else if (parameters.universityType == UniversityType::Private)    where << "DevletUniversitesi = 0";
-
-    // Track type
-    switch (parameters.trackType) {
-    case TrackType::Science:      where << "PuanTuru = 'SAY'"; break;
-    case TrackType::EqualWeight:  where << "PuanTuru = 'EA'";  break;
-    case TrackType::Humanities:   where << "PuanTuru = 'SÖZ'"; break;
-    case TrackType::TYT:          where << "PuanTuru = 'TYT'"; break;
-    case TrackType::Language:     where << "PuanTuru = 'DİL'"; break;
-    case TrackType::Undefined:    break;
-    }
-
-    // Score range
-    double minScore = parameters.scoreInterval.minimum.value_or(0);
-    double maxScore = parameters.scoreInterval.maximum.value_or(0);
-    QString scoreRange;
-
-    if (minScore > 100)
-        scoreRange += QString("GenelEnKucukPuan > %1").arg(minScore);
-    if (maxScore < 560) {
-        if (!scoreRange.isEmpty()) scoreRange += " AND ";
-        scoreRange += QString("GenelEnBuyukPuan < %1").arg(maxScore);
-    }
-    if (!scoreRange.isEmpty())
-        where << QString("(%1)").arg(scoreRange);
-
-    // Quota types
-    QStringList kontenjan;
-    if (parameters.selectedQuotaTypes.regularQuota)           kontenjan << "GenelKontenjan IS NOT NULL";
-    if (parameters.selectedQuotaTypes.highSchoolValedictoriansQuota) kontenjan << "OkulBirincisiKontenjan IS NOT NULL";
-    if (parameters.selectedQuotaTypes.martyrsAndVeteransQuota) kontenjan << "SehitGaziKontenjan IS NOT NULL";
-    if (parameters.selectedQuotaTypes.earthquakeVictimsQuota)  kontenjan << "DepremzedeKontenjan IS NOT NULL";
-    if (parameters.selectedQuotaTypes.women34PlusQuota)        kontenjan << "Kadin34Kontenjan IS NOT NULL";
-    if (parameters.selectedQuotaTypes.trncNationalsQuota)      kontenjan << "KKTCUyruklu = TRUE";
-    else                                              where << "KKTCUyruklu = FALSE";
-    if (parameters.selectedQuotaTypes.mtokQuota)               kontenjan << "MTOK = TRUE";
-    else                                              where << "MTOK = FALSE";
-
-    if (!kontenjan.isEmpty())
-        where << "(" + kontenjan.join(" OR ") + ")";
-
-    // Tuition filters
-    QStringList tuition;
-    if (parameters.selectedTuitionFeeTypes.free)       tuition << "UcretDurumu = 0";
-    if (parameters.selectedTuitionFeeTypes.discounted) tuition << "UcretDurumu = 50";
-    if (parameters.selectedTuitionFeeTypes.paid)       tuition << "UcretDurumu = 100";
-    if (!tuition.isEmpty())                   where << "(" + tuition.join(" OR ") + ")";
-
-    // Combine WHERE clauses
-    if (!where.isEmpty())
-        sql += " WHERE " + where.join(" AND ");
-
-    // Order
-    if (parameters.order.toBeOrdered) {
-        QString col = getDbColumnNameFromProgramTableColumnIndex(parameters.order.column);
-        sql += QString(" ORDER BY %1 %2")
-                   .arg(SQLiteUtil::trOrderExprFor(col))
-                   .arg(parameters.order.direction == Qt::AscendingOrder ? "ASC" : "DESC");
-    } else {
-        sql += " ORDER BY ProgramKodu ASC";
-    }
+    const ProgramTableColumnSchema &entry = ProgramTableColumns::schema(column);
+    if (!entry.dbName)
+        return false;
+
+    // Additional placements publish no placed counts
+    const bool placedCount = column == ProgramTableColumn::GenelYerlesen
+                             || column == ProgramTableColumn::OkulBirincisiYerlesen
+                             || column == ProgramTableColumn::SehitGaziYakiniYerlesen
+                             || column == ProgramTableColumn::DepremzedeYerlesen
+                             || column == ProgramTableColumn::Kadin34PlusYerlesen;
+    if (placedCount && parameters.placementType == PlacementType::Additional)
+        return false;
+
+    const SelectedQuotaTypes &quotas = parameters.selectedQuotaTypes;
+    switch (entry.quotaGroup) {
+    case ColumnTypes::Base:                     return true;
+    case ColumnTypes::Regular:                  return quotas.regularQuota || quotas.trncNationalsQuota || quotas.mtokQuota;
+    case ColumnTypes::HighSchoolValedictorians: return quotas.highSchoolValedictoriansQuota;
+    case ColumnTypes::MartyrsAndVeterans:       return quotas.martyrsAndVeteransQuota;
+    case ColumnTypes::EarthquakeVictims:        return quotas.earthquakeVictimsQuota;
+    case ColumnTypes::Women34Plus:              return quotas.women34PlusQuota;
+    }
+    return false;
+}
 
-    return sql;
+ProgramTableColumnMask AcademyScopeBackEnd::visibleColumnMask(const AcademyScopeParameters &parameters)
+{
+    ProgramTableColumnMask mask = 0;
+    for (const ProgramTableColumnSchema &entry : programTableSchema)
+        if (isColumnVisible(entry.column, parameters))
+            mask |= columnBit(entry.column);
+    return mask;
 }
 
-QString AcademyScopeBackEnd::getDbColumnNameFromProgramTableColumnIndex(ProgramTableColumn column) {
-    switch (column) {
-    case ProgramTableColumn::ProgramKodu:              return "ProgramKodu";
-    case ProgramTableColumn::UniversiteAdi:            return "UniversiteAdi";
-    case ProgramTableColumn::FakulteYuksekOkulAdi:     return "FakulteYuksekokulAdi";
-    case ProgramTableColumn::ProgramAdi:               return "ProgramAdi";
-    case ProgramTableColumn::PuanTuru:                 return "PuanTuru";
-    case ProgramTableColumn::GenelKontenjan:           return "GenelKontenjan";
-    case ProgramTableColumn::GenelYerlesen:            return "GenelYerlesen";
-    case ProgramTableColumn::GenelEnKucukPuan:         return "GenelEnKucukPuan";
-    case ProgramTableColumn::OkulBirincisiKontenjan:   return "OkulBirincisiKontenjan";
-    case ProgramTableColumn::OkulBirincisiYerlesen:    return "OkulBirincisiYerlesen";
-    case ProgramTableColumn::OkulBirincisiEnKucukPuan: return "OkulBirincisiEnKucukPuan";
-    case ProgramTableColumn::SehitGaziYakiniKontenjan: return "SehitGaziKontenjan";
-    case ProgramTableColumn::SehitGaziYakiniYerlesen:  return "SehitGaziYerlesen";
-    case ProgramTableColumn::SehitGaziYakiniEnKucukPuan:return "SehitGaziEnKucukPuan";
-    case ProgramTableColumn::DepremzedeKontenjan:      return "DepremzedeKontenjan";
-    case ProgramTableColumn::DepremzedeYerlesen:       return "DepremzedeYerlesen";
-    case ProgramTableColumn::DepremzedeEnKucukPuan:    return "DepremzedeEnKucukPuan";
-    case ProgramTableColumn::Kadin34PlusKontenjan:     return "Kadin34Kontenjan";
-    case ProgramTableColumn::Kadin34PlusYerlesen:      return "Kadin34Yerlesen";
-    case ProgramTableColumn::Kadin34PlusEnKucukPuan:   return "Kadin34EnKucukPuan";
-    default: return QString();
-    }
+QStringList AcademyScopeBackEnd::getProgramTableColumnsToBeShown(const AcademyScopeParameters &parameters)
+{
+    const ProgramTableColumnMask mask = visibleColumnMask(parameters);
+    QStringList columns;
+    for (const ProgramTableColumnSchema &entry : programTableSchema)
+        if (mask & columnBit(entry.column))
+            columns << QString::fromLatin1(entry.dbName);
+    return columns;
 }
@@ -16,6 +16,19 @@ You should have received a copy of the GNU General Public License along with thi
 #include "ProgramTableColumnDefinitions.hpp"
 #include <QStandardItemModel>
 #include "AcademyScopeModel.hpp"
+#include "PlacementComparisonModel.hpp"
+#include "Data/ProgramDataset.hpp"
+#include "Data/DatasetManager.hpp"
+#include "Data/YearCatalog.hpp"
+#include "ResultExporter.hpp"
+#include "Data/BatchQueryEvaluator.hpp"
+#include "Data/AggregationEngine.hpp"
+#include "Data/ScoreIndex.hpp"
+#include "Data/ResultCache.hpp"
+#include "StartupPipeline.hpp"
+#include "Utils/MemoryAccountant.hpp"
+#include <QFutureWatcher>
+#include <memory>
 
 class ProgramTableInterface {
 public:
@@ -36,29 +49,105 @@ protected:
     virtual void init() = 0;
 };
 
+// Blocking loads everything in the constructor. Staged returns at once and
+// reports progress through getStartupPipeline(); queries wait for its
+// interactive() signal.
+enum class StartupMode {
+    Blocking,
+    Staged
+};
+
 class AcademyScopeBackEnd {
 public:
-    AcademyScopeBackEnd();
+    // Several back ends on one host share their datasets through SnapshotSharing::Publish
+    // in one process and SnapshotSharing::Attach in the others
+    explicit AcademyScopeBackEnd(StartupMode startupMode = StartupMode::Blocking,
+                                 SnapshotSharing snapshotSharing = SnapshotSharing::Private);
+    ~AcademyScopeBackEnd();
     QList<University> getUniversities()const;
     QList<QString> getDepartments() const;
     void populateProgramTable(const AcademyScopeParameters &academyScopeParameters);
     AcademyScopeModel * getDataModel();
+    // Regular and additional placement of the filtered programs side by side
+    void populateComparisonTable(const AcademyScopeParameters &academyScopeParameters);
+    PlacementComparisonModel * getComparisonModel();
+    std::shared_ptr<const ProgramDataset> getDataset(PlacementType placementType);
+    DatasetManager * getDatasetManager();
+    StartupPipeline * getStartupPipeline();
+    // One budget for every cache of the back end; 0 (the default) only reports usage
+    void setMemoryBudget(qint64 bytes);
+    MemoryAccountant * getMemoryAccountant();
+    QList<int> getAvailableYears() const;
+    // Empty when a year in the range could not be read
+    std::optional<QVector<ProgramYearRecord>> getProgramTrend(qint64 programCode, int fromYear, int toYear);
+    std::optional<QHash<qint64, QVector<ProgramYearRecord>>> getProgramTrends(const QVector<qint64> &programCodes,
+                                                                              int fromYear, int toYear);
     QStringList getProgramTableColumnsToBeShown(const AcademyScopeParameters &parameters);
+    ExportResult exportFilteredResults(const AcademyScopeParameters &parameters,
+                                       const QList<ProgramTableColumn> &columns,
+                                       QIODevice *sink,
+                                       const ExportOptions &options = ExportOptions());
+    ExportResult exportFilteredResults(const AcademyScopeParameters &parameters,
+                                       const QList<ProgramTableColumn> &columns,
+                                       const QString &filePath,
+                                       const ExportOptions &options = ExportOptions());
+    QVector<BatchQueryResult> evaluateBatch(const QVector<AcademyScopeParameters> &parameterSets,
+                                            bool countsOnly = false,
+                                            BatchQueryStatistics *statistics = nullptr);
+    // Programs whose minimum score in the quota group is at or below the given
+    // score, closest cutoffs first. The score bounds of the filters are ignored.
+    QVector<ReachableProgram> findReachablePrograms(double score,
+                                                    const AcademyScopeParameters &filters,
+                                                    ColumnTypes quotaType = ColumnTypes::Regular,
+                                                    int k = 50);
+    // Grouped statistics (counts, sums, extremes, quantiles, ratios) of the
+    // filtered programs, computed in parallel on the in-memory dataset
+    QVector<AggregationGroup> aggregate(const AcademyScopeParameters &parameters,
+                                        const QList<ProgramTableColumn> &groupBy,
+                                        const QList<Aggregate> &aggregates,
+                                        AggregationStatistics *statistics = nullptr);
 
 private:
-    void initDB();
     void setProgramTableColumnWidths();
     void populateUniversitiesComboBox();
     void populateDepartmentsComboBox();
-    void hideUnnecessaryColumnsOnTheProgramTable(const AcademyScopeParameters &academyScopeParameters) const;
-    void hideUnusedColumnsOnTheProgramTable();
-    void initializeYKSTableColumnNames();
+    static bool isColumnVisible(ProgramTableColumn column, const AcademyScopeParameters &parameters);
+    static ProgramTableColumnMask visibleColumnMask(const AcademyScopeParameters &parameters);
     void setLogoDarkMode(bool isDarkMode);
-    QString buildFilteredSql(const AcademyScopeParameters &academyScopeParameters);
-    QString getDbColumnNameFromProgramTableColumnIndex(ProgramTableColumn columnIndex);
+    bool populateProgramTableFromRanks(const AcademyScopeParameters &academyScopeParameters);
+    bool populateProgramTableFromCache(const AcademyScopeParameters &academyScopeParameters);
+    void refreshResultCache();
+    void registerMemoryComponents();
+    void acquireCurrentSnapshot();
+    int estimateFilteredRowCount(const AcademyScopeParameters &academyScopeParameters, bool *exact);
+    void countFilteredRowsInBackground(const AcademyScopeParameters &academyScopeParameters);
     AcademyScopeModel dataModel;
+    PlacementComparisonModel comparisonModel;
+    DatasetManager datasetManager;
+    YearCatalog yearCatalog;
+    // Parameters of the current result; header clicks repopulate them with a new order
+    std::optional<AcademyScopeParameters> lastParameters;
+    // Snapshot the current result was built from; swapped only on the next populate
+    std::shared_ptr<const DatasetSnapshot> activeSnapshot;
+
+    // In-memory sort state of the last populated result
+    QString lastFilterKey;
+    QVector<int> lastFilteredRows;
+    QString lastSortSignature;
+    QVector<int> lastSortedRows;
+    double lastSortStateMilliseconds = 0; // filter and sort time that built the two above
+    bool lastSortedRowsShown = false;     // the model shows lastSortedRows, not a cached, top-k or SQL result
+    double lastComparisonMilliseconds = 0; // time the comparison table took to fill
+    // Exact row count of a top-k or estimated result that went through SQL
+    QFutureWatcher<int> rowCountWatcher;
+    // Ordered results of popular parameter sets, persisted next to the database
+    ResultCache resultCache;
+    QFutureWatcher<QVector<std::pair<AcademyScopeParameters, CachedResult>>> cacheRefreshWatcher;
+    QString cacheRefreshStamp;
+    // Declared after the members its hooks touch, so it is destroyed first
+    std::unique_ptr<StartupPipeline> startupPipeline;
 
     QLocale turkishLocale;
-    QStringList yksTableColumnNames;
-    QSqlDatabase db;
+    // Last, so it is destroyed before the components its callbacks read
+    MemoryAccountant memoryAccountant;
 };
@@ -0,0 +1,62 @@
+/*
+AggregationBenchmark class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "AggregationBenchmark.hpp"
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include "../BackEnd.hpp"
+#include "BenchmarkUtil.hpp"
+
+QList<AggregationBenchmarkResult> AggregationBenchmark::run(AcademyScopeBackEnd &backEnd, int iterations)
+{
+    struct Case {
+        QString label;
+        QList<ProgramTableColumn> groupBy;
+        QList<Aggregate> aggregates;
+    };
+    const QList<Case> cases = {
+        { "fill rate per university",
+          { ProgramTableColumn::UniversiteAdi },
+          { {AggregateFunction::Sum, ProgramTableColumn::GenelKontenjan},
+            {AggregateFunction::Sum, ProgramTableColumn::GenelYerlesen},
+            {AggregateFunction::Ratio, ProgramTableColumn::GenelYerlesen, 0.5, ProgramTableColumn::GenelKontenjan} } },
+        { "score quantiles per faculty and track",
+          { ProgramTableColumn::UniversiteAdi, ProgramTableColumn::FakulteYuksekOkulAdi, ProgramTableColumn::PuanTuru },
+          { {AggregateFunction::Minimum, ProgramTableColumn::GenelEnKucukPuan},
+            {AggregateFunction::Quantile, ProgramTableColumn::GenelEnKucukPuan, 0.5},
+            {AggregateFunction::Maximum, ProgramTableColumn::GenelEnKucukPuan} } },
+    };
+
+    const AcademyScopeParameters parameters = AcademyScopeParameters();
+    QList<AggregationBenchmarkResult> results;
+    for (const Case &benchmarkCase : cases) {
+        AggregationBenchmarkResult result;
+        result.label = benchmarkCase.label;
+        QVector<double> samples;
+        QElapsedTimer timer;
+        for (int i = 0; i < iterations; ++i) {
+            AggregationStatistics statistics;
+            timer.start();
+            const QVector<AggregationGroup> groups = backEnd.aggregate(parameters, benchmarkCase.groupBy,
+                                                                       benchmarkCase.aggregates, &statistics);
+            samples << timer.nsecsElapsed() / 1e6;
+            result.rowCount = statistics.rowCount;
+            result.partitionCount = statistics.partitionCount;
+            result.groupCount = groups.size();
+        }
+        result.milliseconds = BenchmarkUtil::median(samples);
+        qDebug().nospace() << "[AggregationBenchmark] " << result.label << ": " << result.rowCount << " rows into "
+                           << result.groupCount << " groups over " << result.partitionCount << " partitions in "
+                           << result.milliseconds << " ms";
+        results << result;
+    }
+    return results;
+}
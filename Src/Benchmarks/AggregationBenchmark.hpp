@@ -0,0 +1,31 @@
+/*
+AggregationBenchmark class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QList>
+#include <QString>
+
+class AcademyScopeBackEnd;
+
+struct AggregationBenchmarkResult {
+    QString label;
+    int rowCount = 0;
+    int groupCount = 0;
+    int partitionCount = 0;
+    double milliseconds = 0; // median AcademyScopeBackEnd::aggregate
+};
+
+// Times the summary views charts are built from: seats against placements per
+// university, and minimum score quantiles per faculty and track.
+class AggregationBenchmark
+{
+public:
+    static QList<AggregationBenchmarkResult> run(AcademyScopeBackEnd &backEnd, int iterations = 20);
+};
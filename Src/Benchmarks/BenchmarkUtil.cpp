@@ -0,0 +1,26 @@
+/*
+BenchmarkUtil class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "BenchmarkUtil.hpp"
+#include <algorithm>
+
+double BenchmarkUtil::percentile(QVector<double> samples, double fraction)
+{
+    if (samples.isEmpty())
+        return 0;
+    std::sort(samples.begin(), samples.end());
+    const qsizetype index = qsizetype(std::clamp(fraction, 0.0, 1.0) * (samples.size() - 1) + 0.5);
+    return samples[std::min<qsizetype>(samples.size() - 1, index)];
+}
+
+double BenchmarkUtil::median(const QVector<double> &samples)
+{
+    return percentile(samples, 0.5);
+}
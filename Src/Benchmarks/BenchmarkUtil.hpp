@@ -0,0 +1,21 @@
+/*
+BenchmarkUtil class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QVector>
+
+class BenchmarkUtil
+{
+public:
+    // Nearest-rank percentile, fraction in [0, 1]; 0 without samples
+    static double percentile(QVector<double> samples, double fraction);
+    // The upper middle sample for an even count
+    static double median(const QVector<double> &samples);
+};
@@ -0,0 +1,102 @@
+/*
+BitmapFilterBenchmark class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "BitmapFilterBenchmark.hpp"
+#include <QElapsedTimer>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+#include "../BackEnd.hpp"
+#include "BenchmarkUtil.hpp"
+#include "../QueryBuilder.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+
+QList<BitmapFilterBenchmarkResult> BitmapFilterBenchmark::run(AcademyScopeBackEnd &backEnd, int iterations)
+{
+    QList<QPair<QString, AcademyScopeParameters>> cases;
+
+    AcademyScopeParameters defaults;
+    cases << qMakePair(QString("defaults"), defaults);
+
+    AcademyScopeParameters science = defaults;
+    science.trackType = TrackType::Science;
+    science.degreeType = DegreeType::Bachelor;
+    science.country = Country::Turkiye;
+    cases << qMakePair(QString("SAY bachelor in Turkiye"), science);
+
+    AcademyScopeParameters privateForeign = defaults;
+    privateForeign.universityType = UniversityType::Private;
+    privateForeign.country = Country::ForeignCountries;
+    privateForeign.selectedTuitionFeeTypes.free = false;
+    cases << qMakePair(QString("private abroad, paid"), privateForeign);
+
+    AcademyScopeParameters quotas = defaults;
+    quotas.selectedQuotaTypes.regularQuota = false;
+    quotas.selectedQuotaTypes.earthquakeVictimsQuota = true;
+    quotas.selectedQuotaTypes.women34PlusQuota = true;
+    quotas.selectedQuotaTypes.trncNationalsQuota = true;
+    cases << qMakePair(QString("special quotas"), quotas);
+
+    QList<BitmapFilterBenchmarkResult> results;
+    for (const auto &testCase : cases) {
+        const BitmapFilterBenchmarkResult result = runParameters(backEnd, testCase.first, testCase.second, iterations);
+        qDebug().nospace() << "[BitmapFilterBenchmark] " << result.label << ": SQL " << result.sqlRowCount
+                           << " rows in " << result.sqlMilliseconds << " ms, bitmap " << result.bitmapRowCount
+                           << " rows in " << result.bitmapMilliseconds << " ms";
+        if (result.sqlRowCount != result.bitmapRowCount)
+            qWarning() << "[BitmapFilterBenchmark] Row counts differ for" << result.label;
+        results << result;
+    }
+    return results;
+}
+
+BitmapFilterBenchmarkResult BitmapFilterBenchmark::runParameters(AcademyScopeBackEnd &backEnd, const QString &label,
+                                                                 const AcademyScopeParameters &parameters,
+                                                                 int iterations)
+{
+    BitmapFilterBenchmarkResult result;
+    result.label = label;
+
+    const std::shared_ptr<const DatasetSnapshot> snapshot = backEnd.getDatasetManager()->getCurrentSnapshot();
+    if (!snapshot)
+        return result;
+    const std::shared_ptr<const BitmapIndex> bitmapIndex = snapshot->getBitmapIndex(parameters.placementType);
+    if (!bitmapIndex)
+        return result;
+    const QString sql = "SELECT rowid " + QueryBuilder::buildFilterSql(parameters);
+    const QVariantList bindValues = QueryBuilder::buildFilterBindValues(parameters);
+
+    QVector<double> sqlSamples, bitmapSamples;
+    QElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+        timer.start();
+        QSqlQuery query(snapshot->getDatabase());
+        query.setForwardOnly(true);
+        if (!SQLiteUtil::exec(query, sql, bindValues)) {
+            qWarning() << "[BitmapFilterBenchmark] Query failed:" << query.lastError().text();
+            return result;
+        }
+        int count = 0;
+        while (query.next())
+            ++count;
+        sqlSamples << timer.nsecsElapsed() / 1e6;
+        result.sqlRowCount = count;
+
+        timer.start();
+        const QVector<int> rows = bitmapIndex->evaluateCategorical(parameters).toRows();
+        bitmapSamples << timer.nsecsElapsed() / 1e6;
+        result.bitmapRowCount = rows.size();
+    }
+
+    result.sqlMilliseconds = BenchmarkUtil::median(sqlSamples);
+    result.bitmapMilliseconds = BenchmarkUtil::median(bitmapSamples);
+    return result;
+}
@@ -0,0 +1,35 @@
+/*
+BitmapFilterBenchmark class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QList>
+#include <QString>
+#include "../DataTypeDefinitions.hpp"
+
+class AcademyScopeBackEnd;
+
+struct BitmapFilterBenchmarkResult {
+    QString label;
+    int sqlRowCount = 0;
+    int bitmapRowCount = 0;        // differs from sqlRowCount only on a bug
+    double sqlMilliseconds = 0;    // median SELECT rowid with the categorical WHERE clause
+    double bitmapMilliseconds = 0; // median BitmapIndex::evaluateCategorical + toRows
+};
+
+// Evaluates categorical-only filters (no name or score predicates) through
+// SQLite and through the snapshot's bitmap index, and checks both agree.
+class BitmapFilterBenchmark
+{
+public:
+    static QList<BitmapFilterBenchmarkResult> run(AcademyScopeBackEnd &backEnd, int iterations = 20);
+private:
+    static BitmapFilterBenchmarkResult runParameters(AcademyScopeBackEnd &backEnd, const QString &label,
+                                                     const AcademyScopeParameters &parameters, int iterations);
+};
@@ -0,0 +1,372 @@
+/*
+QueryPlanAudit class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "QueryPlanAudit.hpp"
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QDebug>
+#include <functional>
+#include <optional>
+#include "../DataTypeDefinitions.hpp"
+#include "../ProgramTableColumnDefinitions.hpp"
+#include "../QueryBuilder.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+
+namespace {
+const QString fixtureConnectionName = "query-plan-audit";
+const QString tableList = "('YKS', 'EkTercihDetayli')";
+
+// One value of one dimension of the enumeration
+struct Variant {
+    QString name;
+    std::function<void(AcademyScopeParameters &)> apply;
+};
+
+void setQuotas(AcademyScopeParameters &parameters, bool regular, bool valedictorians, bool women34Plus,
+               bool trnc, bool mtok)
+{
+    SelectedQuotaTypes &quotas = parameters.selectedQuotaTypes;
+    quotas = SelectedQuotaTypes();
+    quotas.regularQuota = regular;
+    quotas.highSchoolValedictoriansQuota = valedictorians;
+    quotas.women34PlusQuota = women34Plus;
+    quotas.trncNationalsQuota = trnc;
+    quotas.mtokQuota = mtok;
+}
+
+void setOrder(AcademyScopeParameters &parameters, ProgramTableColumn column, Qt::SortOrder direction)
+{
+    parameters.order.keys = { SortKey{column, direction} };
+}
+
+// Most shapes share a handful of plans, so each distinct plan is stored once
+// and the shapes refer to it by index
+constexpr int baselineFormat = 3;
+
+struct Baseline {
+    QHash<QString, QStringList> plans; // by shape label
+    QString sqliteVersion;
+    bool statistics = false;
+};
+
+std::optional<Baseline> readBaseline(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt;
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("format").toInt() != baselineFormat) {
+        qWarning() << "[QueryPlanAudit] Baseline" << path << "is not in format" << baselineFormat;
+        return std::nullopt;
+    }
+
+    QList<QStringList> distinctPlans;
+    for (const QJsonValue &plan : root.value("distinctPlans").toArray()) {
+        QStringList lines;
+        for (const QJsonValue &line : plan.toArray())
+            lines << line.toString();
+        distinctPlans << lines;
+    }
+    Baseline baseline;
+    baseline.sqliteVersion = root.value("sqliteVersion").toString();
+    baseline.statistics = root.value("statistics").toBool();
+    const QJsonObject object = root.value("plans").toObject();
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+        const int index = it.value().toInt(-1);
+        if (index >= 0 && index < distinctPlans.size())
+            baseline.plans.insert(it.key(), distinctPlans[index]);
+    }
+    return baseline;
+}
+
+bool writeBaseline(const QString &path, const QueryPlanAuditReport &report, const QList<QueryPlanAuditResult> &results)
+{
+    QJsonArray distinctPlans;
+    QHash<QString, int> indexByPlan;
+    QJsonObject plans;
+    for (const QueryPlanAuditResult &result : results) {
+        const QString key = result.plan.join('\n');
+        auto it = indexByPlan.constFind(key);
+        if (it == indexByPlan.constEnd()) {
+            it = indexByPlan.insert(key, distinctPlans.size());
+            distinctPlans.append(QJsonArray::fromStringList(result.plan));
+        }
+        plans.insert(result.label, it.value());
+    }
+    QJsonObject root;
+    root.insert("format", baselineFormat);
+    root.insert("sqliteVersion", report.sqliteVersion);
+    root.insert("statistics", report.statisticsCopied);
+    root.insert("distinctPlans", distinctPlans);
+    root.insert("plans", plans);
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(QJsonDocument(root).toJson(QJsonDocument::Indented)) < 0 || !file.commit()) {
+        qWarning() << "[QueryPlanAudit] Baseline could not be written to" << path << ":" << file.errorString();
+        return false;
+    }
+    return true;
+}
+}
+
+QList<QueryPlanShape> QueryPlanAudit::enumerateShapes()
+{
+    // Values of one dimension only differ in constants when they share a name,
+    // so one representative per distinct predicate structure is enough
+    const QList<QList<Variant>> dimensions = {
+        { {"Regular",    [](AcademyScopeParameters &p) { p.placementType = PlacementType::Regular; }},
+          {"Additional", [](AcademyScopeParameters &p) { p.placementType = PlacementType::Additional; }} },
+        { {"AllCountries",     [](AcademyScopeParameters &p) { p.country = Country::AllCountries; }},
+          {"Turkiye",          [](AcademyScopeParameters &p) { p.country = Country::Turkiye; }},
+          {"ForeignCountries", [](AcademyScopeParameters &p) { p.country = Country::ForeignCountries; }} },
+        { {"anyTrack", [](AcademyScopeParameters &p) { p.trackType = TrackType::Undefined; }},
+          {"track",    [](AcademyScopeParameters &p) { p.trackType = TrackType::Science; }} },
+        { {"anyKind", [](AcademyScopeParameters &) {}},
+          {"kind",    [](AcademyScopeParameters &p) {
+               p.degreeType = DegreeType::Bachelor;
+               p.universityType = UniversityType::Government;
+           }} },
+        { {"quota=regular",        [](AcademyScopeParameters &p) { setQuotas(p, true, false, false, false, false); }},
+          {"quota=none",           [](AcademyScopeParameters &p) { setQuotas(p, false, false, false, false, false); }},
+          {"quota=several",        [](AcademyScopeParameters &p) { setQuotas(p, true, true, true, false, false); }},
+          {"quota=trnc+mtok",      [](AcademyScopeParameters &p) { setQuotas(p, false, false, false, true, true); }},
+          {"quota=women34+seats",  [](AcademyScopeParameters &p) {
+               setQuotas(p, false, false, true, false, false);
+               p.women34PlusQuotaInterval = {2.0, std::nullopt};
+           }} },
+        { {"tuition=all",  [](AcademyScopeParameters &p) { p.selectedTuitionFeeTypes = SelectedTuitionFeeTypes(); }},
+          {"tuition=one",  [](AcademyScopeParameters &p) {
+               p.selectedTuitionFeeTypes = {true, false, false};
+           }},
+          {"tuition=none", [](AcademyScopeParameters &p) {
+               p.selectedTuitionFeeTypes = {false, false, false};
+           }} },
+        { {"anyScore", [](AcademyScopeParameters &) {}},
+          {"score",    [](AcademyScopeParameters &p) { p.scoreInterval = {300.0, 500.0}; }} },
+        { {"anySeats", [](AcademyScopeParameters &) {}},
+          {"seats",    [](AcademyScopeParameters &p) { p.regularQuotaInterval = {10.0, std::nullopt}; }} },
+        // Both name filters at once; each one alone plans as a subset of that
+        { {"anyName", [](AcademyScopeParameters &) {}},
+          {"names",   [](AcademyScopeParameters &p) {
+               p.universityName = "Ankara";
+               p.departmentName = "Bilgisayar";
+           }} },
+        { {"order=default",    [](AcademyScopeParameters &p) { p.order = OrderParameters(); }},
+          {"order=score-desc", [](AcademyScopeParameters &p) {
+               setOrder(p, ProgramTableColumn::GenelEnKucukPuan, Qt::DescendingOrder);
+           }},
+          {"order=university", [](AcademyScopeParameters &p) {
+               setOrder(p, ProgramTableColumn::UniversiteAdi, Qt::AscendingOrder);
+           }},
+          {"order=seats-desc", [](AcademyScopeParameters &p) {
+               setOrder(p, ProgramTableColumn::GenelKontenjan, Qt::DescendingOrder);
+           }} },
+    };
+
+    QList<QueryPlanShape> shapes;
+    QVector<int> choice(dimensions.size(), 0);
+    const QString selectList = ProgramTableColumns::selectList();
+    for (;;) {
+        AcademyScopeParameters parameters = AcademyScopeParameters();
+        QStringList label;
+        for (int dimension = 0; dimension < dimensions.size(); ++dimension) {
+            const Variant &variant = dimensions[dimension][choice[dimension]];
+            variant.apply(parameters);
+            label << variant.name;
+        }
+        shapes << QueryPlanShape{label.join('/'),
+                                 QString("SELECT %1 %2").arg(selectList, QueryBuilder::buildFilteredSql(parameters)),
+                                 QueryBuilder::buildFilterBindValues(parameters)};
+
+        // Odometer over the dimensions, last one fastest
+        int dimension = dimensions.size() - 1;
+        while (dimension >= 0 && ++choice[dimension] == dimensions[dimension].size())
+            choice[dimension--] = 0;
+        if (dimension < 0)
+            break;
+    }
+    return shapes;
+}
+
+QueryPlanAuditReport QueryPlanAudit::run(const QSqlDatabase &source, const QString &baselinePath, bool updateBaseline)
+{
+    QueryPlanAuditReport report;
+    const QList<QueryPlanShape> shapes = enumerateShapes();
+    report.shapeCount = shapes.size();
+
+    QList<QueryPlanAuditResult> results;
+    {
+        QSqlDatabase fixture = QSqlDatabase::addDatabase("QSQLITE", fixtureConnectionName);
+        fixture.setDatabaseName(":memory:");
+        const bool opened = fixture.open();
+        if (opened)
+            SQLiteUtil::configureConnection(fixture);
+        report.fixtureCreated = opened && createFixture(source, fixture, &report.statisticsCopied);
+        if (!report.fixtureCreated) {
+            qWarning() << "[QueryPlanAudit] Fixture could not be created:" << fixture.lastError().text();
+        } else {
+            QSqlQuery version(fixture);
+            if (version.exec("SELECT sqlite_version()") && version.next())
+                report.sqliteVersion = version.value(0).toString();
+            for (const QueryPlanShape &shape : shapes) {
+                bool ok = false;
+                QueryPlanAuditResult result;
+                result.label = shape.label;
+                result.plan = explain(fixture, shape, &ok);
+                if (!ok) {
+                    ++report.failedShapeCount;
+                    continue;
+                }
+                result.fullScan = usesFullScan(result.plan);
+                result.tempSort = usesTempSort(result.plan);
+                results << result;
+            }
+        }
+        fixture.close();
+    }
+    QSqlDatabase::removeDatabase(fixtureConnectionName);
+    if (results.isEmpty())
+        return report;
+
+    const std::optional<Baseline> read = readBaseline(baselinePath);
+    if (!read && !updateBaseline) {
+        // Comparing with nothing would pass every shape
+        qWarning() << "[QueryPlanAudit] No baseline at" << baselinePath << "- run with the update flag to create it";
+        report.baselineMissing = true;
+        return report;
+    }
+    // Another planner or other statistics change plans without any query changing
+    if (read && !updateBaseline
+        && (read->sqliteVersion != report.sqliteVersion || read->statistics != report.statisticsCopied)) {
+        qWarning().nospace() << "[QueryPlanAudit] Baseline was planned by SQLite " << read->sqliteVersion
+                             << (read->statistics ? " with" : " without") << " sqlite_stat1; this run uses "
+                             << report.sqliteVersion << (report.statisticsCopied ? " with" : " without")
+                             << " it - run with the update flag against the production database";
+        report.baselineMismatch = true;
+        return report;
+    }
+    const QHash<QString, QStringList> baseline = read ? read->plans : QHash<QString, QStringList>();
+    for (QueryPlanAuditResult &result : results) {
+        if (result.fullScan) ++report.fullScanCount;
+        if (result.tempSort) ++report.tempSortCount;
+
+        const auto it = baseline.constFind(result.label);
+        if (it == baseline.constEnd()) {
+            ++report.newShapeCount;
+            continue;
+        }
+        result.baselinePlan = it.value();
+        if ((result.fullScan && !usesFullScan(result.baselinePlan))
+            || (result.tempSort && !usesTempSort(result.baselinePlan))) {
+            report.regressions << result;
+            qWarning().noquote() << "[QueryPlanAudit] Regressed:" << result.label << "\n  was:"
+                                 << result.baselinePlan.join(" | ") << "\n  now:" << result.plan.join(" | ");
+        }
+    }
+
+    if (updateBaseline)
+        report.baselineWritten = writeBaseline(baselinePath, report, results);
+
+    qDebug().nospace() << "[QueryPlanAudit] SQLite " << report.sqliteVersion
+                       << (report.statisticsCopied ? " with" : " without") << " sqlite_stat1, "
+                       << report.shapeCount << " shapes: " << report.fullScanCount
+                       << " full scans, " << report.tempSortCount << " temp B-tree sorts, "
+                       << report.newShapeCount << " new, " << report.failedShapeCount << " failed, "
+                       << report.regressions.size() << " regressions"
+                       << (report.baselineWritten ? " (baseline written)" : "");
+    return report;
+}
+
+bool QueryPlanAudit::usesFullScan(const QStringList &plan)
+{
+    // "SCAN YKS" (or "SCAN TABLE YKS" before SQLite 3.36) reads every row, and
+    // so does "SCAN YKS USING INDEX ...", only in index order. SEARCH seeks a
+    // range; a covering index scan never reads the table.
+    for (const QString &line : plan) {
+        if (line.startsWith("SCAN ") && !line.contains(" USING COVERING INDEX "))
+            return true;
+    }
+    return false;
+}
+
+bool QueryPlanAudit::usesTempSort(const QStringList &plan)
+{
+    for (const QString &line : plan) {
+        if (line.contains("USE TEMP B-TREE FOR ORDER BY"))
+            return true;
+    }
+    return false;
+}
+
+bool QueryPlanAudit::createFixture(const QSqlDatabase &source, QSqlDatabase &fixture, bool *statisticsCopied)
+{
+    *statisticsCopied = false;
+    QSqlQuery schema(source);
+    // Tables before their indexes
+    if (!schema.exec(QString("SELECT sql FROM sqlite_master WHERE sql IS NOT NULL AND tbl_name IN %1 "
+                             "ORDER BY type = 'index'").arg(tableList))) {
+        qWarning() << "[QueryPlanAudit] Source schema could not be read:" << schema.lastError().text();
+        return false;
+    }
+    QSqlQuery create(fixture);
+    int statementCount = 0;
+    while (schema.next()) {
+        if (!create.exec(schema.value(0).toString())) {
+            qWarning() << "[QueryPlanAudit] Schema statement failed:" << create.lastError().text();
+            return false;
+        }
+        ++statementCount;
+    }
+    if (statementCount == 0) {
+        qWarning() << "[QueryPlanAudit] Source has neither placement table";
+        return false;
+    }
+
+    // Without the source's statistics the planner would assume default selectivities
+    QSqlQuery statistics(source);
+    if (!statistics.exec(QString("SELECT tbl, idx, stat FROM sqlite_stat1 WHERE tbl IN %1").arg(tableList)))
+        return true;
+    QSqlQuery insert(fixture);
+    if (!insert.exec("ANALYZE") || !insert.prepare("INSERT INTO sqlite_stat1 (tbl, idx, stat) VALUES (?, ?, ?)"))
+        return true;
+    while (statistics.next()) {
+        insert.addBindValue(statistics.value(0));
+        insert.addBindValue(statistics.value(1));
+        insert.addBindValue(statistics.value(2));
+        if (insert.exec())
+            *statisticsCopied = true;
+    }
+    // Makes the planner load the copied statistics
+    insert.exec("ANALYZE sqlite_master");
+    return true;
+}
+
+QStringList QueryPlanAudit::explain(const QSqlDatabase &fixture, const QueryPlanShape &shape, bool *ok)
+{
+    QStringList plan;
+    QSqlQuery query(fixture);
+    query.setForwardOnly(true);
+    *ok = SQLiteUtil::exec(query, "EXPLAIN QUERY PLAN " + shape.sql, shape.bindValues);
+    if (!*ok) {
+        qWarning() << "[QueryPlanAudit] Plan failed:" << query.lastError().text() << shape.sql;
+        return plan;
+    }
+    // Columns are id, parent, notused, detail
+    while (query.next())
+        plan << query.value(3).toString();
+    return plan;
+}
@@ -0,0 +1,83 @@
+/*
+QueryPlanAudit class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QList>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+
+struct QueryPlanShape {
+    QString label; // stable key in the baseline, e.g. "Regular/Turkiye/track/.../order=score-desc"
+    QString sql;
+    QVariantList bindValues; // the name patterns, bound as the back end binds them
+};
+
+struct QueryPlanAuditResult {
+    QString label;
+    QStringList plan;         // EXPLAIN QUERY PLAN detail lines
+    QStringList baselinePlan; // empty for a shape the baseline does not know yet
+    bool fullScan = false;
+    bool tempSort = false;
+};
+
+struct QueryPlanAuditReport {
+    int shapeCount = 0;
+    int fullScanCount = 0;
+    int tempSortCount = 0;
+    int newShapeCount = 0;
+    int failedShapeCount = 0; // shapes the fixture could not prepare
+    bool fixtureCreated = false;
+    QString sqliteVersion;        // of the library that planned the shapes
+    bool statisticsCopied = false; // the source had sqlite_stat1 rows for the placement tables
+    bool baselineMissing = false; // no readable baseline and no update requested; nothing was compared
+    // The baseline was planned by another SQLite version or with(out) statistics; nothing was compared
+    bool baselineMismatch = false;
+    bool baselineWritten = false;
+    // Shapes that scan the table or sort in a temp B-tree where the baseline used an index
+    QList<QueryPlanAuditResult> regressions;
+
+    // What a build gate checks: every shape planned and compared, none regressed
+    bool passed() const
+    {
+        return fixtureCreated && !baselineMissing && !baselineMismatch && failedShapeCount == 0
+               && regressions.isEmpty();
+    }
+};
+
+// Plans every query shape buildFilteredSql generates against a fixture with
+// the production schema and compares them with a baseline file. The fixture is
+// an in-memory database created from the source database's DDL for both
+// placement tables and their indexes, with the source's sqlite_stat1 copied
+// over, so plans match production without carrying its rows. The fixture
+// connection is configured like every other one, so tr_fold name filters plan
+// too. A missing baseline is an error; updateBaseline writes the current plans,
+// regressions included. The baseline records the SQLite version and whether
+// statistics were present; plans from another version or without the same
+// statistics are not compared. The baseline belongs in
+// Benchmarks/QueryPlanBaseline.json and is written only by
+// QueryPlanAuditMain --database <production database> --update;
+// QueryPlanAuditMain without --update is the gate that runs it.
+class QueryPlanAudit
+{
+public:
+    static QList<QueryPlanShape> enumerateShapes();
+    static QueryPlanAuditReport run(const QSqlDatabase &source, const QString &baselinePath,
+                                    bool updateBaseline = false);
+
+    static bool usesFullScan(const QStringList &plan);
+    static bool usesTempSort(const QStringList &plan);
+
+private:
+    // statisticsCopied tells whether the source's sqlite_stat1 made it over
+    static bool createFixture(const QSqlDatabase &source, QSqlDatabase &fixture, bool *statisticsCopied);
+    static QStringList explain(const QSqlDatabase &fixture, const QueryPlanShape &shape, bool *ok);
+};
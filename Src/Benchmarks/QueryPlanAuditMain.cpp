@@ -0,0 +1,58 @@
+/*
+Query plan audit entry point of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QDebug>
+#include "QueryPlanAudit.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+
+// Exits with 0 only when every query shape was planned and none regressed
+// against the baseline, so a build can gate on it
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("AcademyScopeQueryPlanAudit");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compares the query plans of every filter shape with a baseline");
+    parser.addHelpOption();
+    QCommandLineOption databaseOption("database", "SQLite database whose schema and statistics are planned against.",
+                                      "path");
+    QCommandLineOption baselineOption("baseline", "Baseline JSON file.", "path", "QueryPlanBaseline.json");
+    QCommandLineOption updateOption("update", "Write the current plans to the baseline, regressions included.");
+    parser.addOptions({ databaseOption, baselineOption, updateOption });
+    parser.process(app);
+
+    const QString databasePath = parser.isSet(databaseOption) ? parser.value(databaseOption)
+                                                              : SQLiteUtil::resolveDatabasePath();
+    const QString connectionName = "query-plan-audit-source";
+    QueryPlanAuditReport report;
+    {
+        QSqlDatabase source = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        source.setDatabaseName(databasePath);
+        source.setConnectOptions("QSQLITE_OPEN_READONLY");
+        if (!source.open()) {
+            qWarning() << "[QueryPlanAudit] Database could not be opened:" << source.lastError().text();
+        } else {
+            SQLiteUtil::configureConnection(source);
+            report = QueryPlanAudit::run(source, parser.value(baselineOption), parser.isSet(updateOption));
+            source.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+
+    // An update accepts the current plans; it only fails when they could not be written
+    if (parser.isSet(updateOption))
+        return report.fixtureCreated && report.baselineWritten ? 0 : 1;
+    return report.passed() ? 0 : 1;
+}
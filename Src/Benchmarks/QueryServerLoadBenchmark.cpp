@@ -0,0 +1,164 @@
+/*
+QueryServerLoadBenchmark class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "QueryServerLoadBenchmark.hpp"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QJsonDocument>
+#include <QLocalSocket>
+#include <QMutex>
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../Server/QueryServer.hpp"
+#include "BenchmarkUtil.hpp"
+#include "../ParametersJson.hpp"
+#include "../ProgramTableColumnDefinitions.hpp"
+
+QList<QueryServerLoadResult> QueryServerLoadBenchmark::run(const QString &databasePath,
+                                                           const QList<int> &workerCounts,
+                                                           int clientCount,
+                                                           int requestsPerClient)
+{
+    QList<QueryServerLoadResult> results;
+    for (int workerCount : workerCounts) {
+        const QueryServerLoadResult result = runOnce(databasePath, workerCount, clientCount, requestsPerClient);
+        qDebug().nospace() << "[QueryServerLoadBenchmark] workers=" << result.workerCount
+                           << " clients=" << result.clientCount
+                           << " qps=" << result.queriesPerSecond
+                           << " p50=" << result.p50Milliseconds << "ms"
+                           << " p95=" << result.p95Milliseconds << "ms"
+                           << " p99=" << result.p99Milliseconds << "ms"
+                           << " max=" << result.maxMilliseconds << "ms"
+                           << " failed=" << result.failedCount;
+        results << result;
+    }
+    return results;
+}
+
+QueryServerLoadResult QueryServerLoadBenchmark::runOnce(const QString &databasePath, int workerCount,
+                                                        int clientCount, int requestsPerClient)
+{
+    QueryServerOptions options;
+    options.socketName = QString("academyscope-load-%1-%2").arg(QCoreApplication::applicationPid()).arg(workerCount);
+    options.databasePath = databasePath;
+    options.workerCount = workerCount;
+
+    QueryServerLoadResult result;
+    result.workerCount = workerCount;
+    result.clientCount = clientCount;
+
+    QueryServer server(options);
+    if (!server.start())
+        return result;
+
+    const QVector<QJsonObject> requests = requestMix();
+    QMutex latencyMutex;
+    QVector<double> latencies;
+    std::atomic_int failed{0};
+    std::atomic_int finishedClients{0};
+
+    QElapsedTimer wallClock;
+    wallClock.start();
+
+    std::vector<std::thread> clients;
+    for (int client = 0; client < clientCount; ++client) {
+        clients.emplace_back([&, client]() {
+            QLocalSocket socket;
+            socket.connectToServer(options.socketName);
+            if (!socket.waitForConnected(5000)) {
+                failed += requestsPerClient;
+                ++finishedClients;
+                return;
+            }
+
+            QVector<double> local;
+            local.reserve(requestsPerClient);
+            QElapsedTimer timer;
+            for (int i = 0; i < requestsPerClient; ++i) {
+                QJsonObject request = requests[(client * 7 + i) % requests.size()];
+                request.insert("id", i);
+
+                timer.start();
+                socket.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+                socket.waitForBytesWritten(5000);
+                while (!socket.canReadLine() && socket.waitForReadyRead(10000)) {}
+                const QByteArray line = socket.readLine();
+                local << timer.nsecsElapsed() / 1e6;
+
+                if (!QJsonDocument::fromJson(line).object().value("ok").toBool())
+                    ++failed;
+            }
+
+            QMutexLocker locker(&latencyMutex);
+            latencies += local;
+            ++finishedClients;
+        });
+    }
+
+    // The server lives on this thread, so keep its event loop turning
+    QEventLoop loop;
+    QTimer poll;
+    QObject::connect(&poll, &QTimer::timeout, &loop, [&]() {
+        if (finishedClients.load() == clientCount)
+            loop.quit();
+    });
+    poll.start(5);
+    loop.exec();
+
+    for (std::thread &client : clients)
+        client.join();
+
+    const double seconds = wallClock.nsecsElapsed() / 1e9;
+    std::sort(latencies.begin(), latencies.end());
+    result.requestCount = latencies.size();
+    result.failedCount = failed.load();
+    result.queriesPerSecond = seconds > 0 ? latencies.size() / seconds : 0;
+    result.p50Milliseconds = BenchmarkUtil::percentile(latencies, 0.50);
+    result.p95Milliseconds = BenchmarkUtil::percentile(latencies, 0.95);
+    result.p99Milliseconds = BenchmarkUtil::percentile(latencies, 0.99);
+    result.maxMilliseconds = latencies.isEmpty() ? 0 : latencies.last();
+
+    server.stop();
+    return result;
+}
+
+QVector<QJsonObject> QueryServerLoadBenchmark::requestMix()
+{
+    QVector<QJsonObject> requests;
+    const TrackType tracks[] = { TrackType::Science, TrackType::EqualWeight, TrackType::Humanities,
+                                 TrackType::TYT, TrackType::Language };
+    int page = 0;
+    for (TrackType track : tracks) {
+        AcademyScopeParameters parameters;
+        parameters.country = Country::AllCountries;
+        parameters.trackType = track;
+        requests << QJsonObject{ { "op", "query" }, { "parameters", ParametersJson::toJson(parameters) },
+                                 { "offset", 0 }, { "limit", 100 } };
+
+        parameters.scoreInterval.minimum = 350;
+        parameters.scoreInterval.maximum = 450;
+        parameters.order.keys = { { ProgramTableColumn::GenelEnKucukPuan, Qt::DescendingOrder } };
+        requests << QJsonObject{ { "op", "query" }, { "parameters", ParametersJson::toJson(parameters) },
+                                 { "offset", 100 * (page++ % 5) }, { "limit", 100 } };
+
+        parameters.order.keys = { { ProgramTableColumn::UniversiteAdi, Qt::AscendingOrder } };
+        parameters.universityName = "ANKARA";
+        requests << QJsonObject{ { "op", "query" }, { "parameters", ParametersJson::toJson(parameters) },
+                                 { "offset", 0 }, { "limit", 50 }, { "count", false } };
+    }
+    requests << QJsonObject{ { "op", "universities" } };
+    requests << QJsonObject{ { "op", "departments" } };
+    return requests;
+}
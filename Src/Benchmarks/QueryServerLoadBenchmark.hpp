@@ -0,0 +1,44 @@
+/*
+QueryServerLoadBenchmark class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QList>
+#include <QVector>
+#include <QString>
+#include <QJsonObject>
+
+struct QueryServerLoadResult {
+    int workerCount = 0;
+    int clientCount = 0;
+    int requestCount = 0;
+    int failedCount = 0;
+    double queriesPerSecond = 0;
+    double p50Milliseconds = 0;
+    double p95Milliseconds = 0;
+    double p99Milliseconds = 0;
+    double maxMilliseconds = 0;
+};
+
+// Load generator for QueryServer. Starts an in-process server for every
+// worker count and drives it from concurrent blocking clients with a mix of
+// filter, sort, paging and lookup requests.
+// Must be called from a thread with a running-capable event loop (the GUI or main thread).
+class QueryServerLoadBenchmark
+{
+public:
+    static QList<QueryServerLoadResult> run(const QString &databasePath,
+                                            const QList<int> &workerCounts = { 1, 2, 4, 8 },
+                                            int clientCount = 16,
+                                            int requestsPerClient = 200);
+private:
+    static QueryServerLoadResult runOnce(const QString &databasePath, int workerCount,
+                                         int clientCount, int requestsPerClient);
+    static QVector<QJsonObject> requestMix();
+};
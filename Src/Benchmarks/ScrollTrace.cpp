@@ -0,0 +1,186 @@
+/*
+ScrollTrace class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ScrollTrace.hpp"
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QDebug>
+#include "../ParametersJson.hpp"
+#include "../ProgramTableColumnDefinitions.hpp"
+
+namespace {
+const char *typeName(TraceEventType type)
+{
+    switch (type) {
+    case TraceEventType::SetFilters: return "filters";
+    case TraceEventType::Sort:       return "sort";
+    case TraceEventType::Scroll:     return "scroll";
+    case TraceEventType::Jump:       return "jump";
+    }
+    return "";
+}
+
+QJsonObject toJson(const TraceEvent &event)
+{
+    QJsonObject object;
+    object.insert("type", typeName(event.type));
+    object.insert("at", event.atMilliseconds);
+    switch (event.type) {
+    case TraceEventType::SetFilters:
+        object.insert("parameters", ParametersJson::toJson(event.parameters));
+        break;
+    case TraceEventType::Sort:
+        object.insert("column", int(event.sortKey.column));
+        object.insert("descending", event.sortKey.direction == Qt::DescendingOrder);
+        break;
+    case TraceEventType::Scroll:
+    case TraceEventType::Jump:
+        object.insert("rows", event.rows);
+        break;
+    }
+    return object;
+}
+
+bool fromJson(const QJsonObject &object, TraceEvent &event)
+{
+    const QString type = object.value("type").toString();
+    if (type == "filters") {
+        event.type = TraceEventType::SetFilters;
+        event.parameters = ParametersJson::fromJson(object.value("parameters").toObject());
+    } else if (type == "sort") {
+        const int column = object.value("column").toInt(-1);
+        if (column < 0 || column >= programTableColumnCount)
+            return false;
+        event.type = TraceEventType::Sort;
+        event.sortKey.column = ProgramTableColumn(column);
+        event.sortKey.direction = object.value("descending").toBool() ? Qt::DescendingOrder : Qt::AscendingOrder;
+    } else if (type == "scroll" || type == "jump") {
+        event.type = type == "scroll" ? TraceEventType::Scroll : TraceEventType::Jump;
+        event.rows = object.value("rows").toInt();
+    } else {
+        return false;
+    }
+    event.atMilliseconds = object.value("at").toInteger();
+    return true;
+}
+}
+
+void ScrollTrace::record(TraceEvent event)
+{
+    if (!recordingTimer.isValid())
+        recordingTimer.start();
+    event.atMilliseconds = recordingTimer.elapsed();
+    events.append(event);
+}
+
+bool ScrollTrace::save(const QString &filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[ScrollTrace] Trace could not be written:" << file.errorString();
+        return false;
+    }
+    for (const TraceEvent &event : events) {
+        file.write(QJsonDocument(toJson(event)).toJson(QJsonDocument::Compact));
+        file.write("\n");
+    }
+    return true;
+}
+
+ScrollTrace ScrollTrace::load(const QString &filePath)
+{
+    ScrollTrace trace;
+    trace.name = filePath;
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[ScrollTrace] Trace could not be read:" << file.errorString();
+        return trace;
+    }
+    int lineNumber = 0;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty())
+            continue;
+        TraceEvent event;
+        if (!fromJson(QJsonDocument::fromJson(line).object(), event)) {
+            qWarning() << "[ScrollTrace] Skipping unreadable event on line" << lineNumber;
+            continue;
+        }
+        trace.events.append(event);
+    }
+    return trace;
+}
+
+ScrollTrace ScrollTrace::synthesize(quint32 seed, int eventCount)
+{
+    QRandomGenerator random(seed);
+    ScrollTrace trace;
+    trace.name = QString("synthetic-%1").arg(seed);
+
+    AcademyScopeParameters parameters;
+    parameters.order.keys = { {ProgramTableColumn::GenelEnKucukPuan, Qt::DescendingOrder} };
+    qint64 at = 0;
+    auto append = [&](TraceEvent event, int gapMilliseconds) {
+        at += gapMilliseconds;
+        event.atMilliseconds = at;
+        trace.events.append(event);
+    };
+
+    TraceEvent first;
+    first.type = TraceEventType::SetFilters;
+    first.parameters = parameters;
+    append(first, 0);
+
+    const QList<TrackType> tracks = { TrackType::Undefined, TrackType::Science, TrackType::EqualWeight,
+                                      TrackType::Humanities, TrackType::Language, TrackType::TYT };
+    const QStringList departments = { "", "Tıp", "Hukuk", "Bilgisayar", "Mühendisliği", "Öğretmenliği" };
+    QVector<ProgramTableColumn> sortable;
+    for (const ProgramTableColumnSchema &schema : programTableSchema)
+        if (schema.sortable)
+            sortable.append(schema.column);
+
+    while (trace.events.size() < eventCount) {
+        const int choice = random.bounded(100);
+        if (choice < 70) {
+            // A run of wheel steps, three rows each, mostly downwards
+            const int direction = random.bounded(100) < 80 ? 1 : -1;
+            const int steps = 1 + random.bounded(30);
+            for (int step = 0; step < steps && trace.events.size() < eventCount; ++step) {
+                TraceEvent scroll;
+                scroll.type = TraceEventType::Scroll;
+                scroll.rows = 3 * direction;
+                append(scroll, 16 + random.bounded(20));
+            }
+        } else if (choice < 80) {
+            TraceEvent jump;
+            jump.type = TraceEventType::Jump;
+            jump.rows = random.bounded(100) < 30 ? 0 : random.bounded(20000);
+            append(jump, 300 + random.bounded(1500));
+        } else if (choice < 90) {
+            TraceEvent sort;
+            sort.type = TraceEventType::Sort;
+            sort.sortKey.column = sortable[random.bounded(sortable.size())];
+            sort.sortKey.direction = random.bounded(2) ? Qt::DescendingOrder : Qt::AscendingOrder;
+            parameters.order.keys = { sort.sortKey };
+            append(sort, 500 + random.bounded(2000));
+        } else {
+            TraceEvent filters;
+            filters.type = TraceEventType::SetFilters;
+            parameters.trackType = tracks[random.bounded(tracks.size())];
+            parameters.departmentName = departments[random.bounded(departments.size())];
+            filters.parameters = parameters;
+            append(filters, 1000 + random.bounded(4000));
+        }
+    }
+    return trace;
+}
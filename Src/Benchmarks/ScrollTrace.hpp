@@ -0,0 +1,52 @@
+/*
+ScrollTrace class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+#include "../DataTypeDefinitions.hpp"
+
+enum class TraceEventType {
+    SetFilters, // a new parameter set from the filter panel
+    Sort,       // header click
+    Scroll,     // wheel or drag, relative in rows
+    Jump        // scroll bar click or keyboard Home/End, absolute row
+};
+
+struct TraceEvent {
+    TraceEventType type = TraceEventType::Scroll;
+    qint64 atMilliseconds = 0; // since the start of the session
+    AcademyScopeParameters parameters; // SetFilters
+    SortKey sortKey{};                 // Sort
+    int rows = 0;                      // Scroll: signed row delta; Jump: target row
+};
+
+// One user session: what was changed and where the view was scrolled.
+// Traces are recorded from the front end with record(), synthesized, or
+// loaded from JSON Lines files (one event object per line).
+class ScrollTrace
+{
+public:
+    QString name;
+    QVector<TraceEvent> events;
+
+    // Stamps the event with the time since the first recorded event
+    void record(TraceEvent event);
+    bool save(const QString &filePath) const;
+    static ScrollTrace load(const QString &filePath);
+
+    // A reproducible session: a default first query, then runs of scrolling
+    // broken up by jumps, header sorts and filter edits
+    static ScrollTrace synthesize(quint32 seed, int eventCount = 500);
+
+private:
+    QElapsedTimer recordingTimer;
+};
@@ -0,0 +1,146 @@
+/*
+ScrollTraceReplayer class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ScrollTraceReplayer.hpp"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include "../BackEnd.hpp"
+#include "BenchmarkUtil.hpp"
+#include "../Utils/MemoryUtil.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+
+namespace {
+// Roles QStyledItemDelegate::initStyleOption asks for, per cell and paint
+const int paintRoles[] = {
+    Qt::FontRole, Qt::TextAlignmentRole, Qt::ForegroundRole, Qt::CheckStateRole,
+    Qt::DecorationRole, Qt::DisplayRole, Qt::BackgroundRole
+};
+
+// What QTableView does with the model on scroll and paint, without widgets
+class HeadlessTableView
+{
+public:
+    HeadlessTableView(AcademyScopeModel &model, int viewportRows)
+        : model(model), viewportRows(viewportRows) {}
+
+    void scrollTo(int row)
+    {
+        firstRow = std::clamp(row, 0, std::max(0, model.rowCount() - viewportRows));
+        // Lazy loading as the front end does it: a window centred on the viewport
+        DataWindow *window = model.getDataWindow();
+        const int lastRow = std::min(firstRow + viewportRows, model.rowCount()) - 1;
+        if (model.getLoadStrategy() == LoadStrategy::Windowed && lastRow >= 0
+            && (firstRow < window->beginningIndex || lastRow > window->endingIndex)) {
+            window->beginningIndex = std::max(0, firstRow - (window->windowSize - viewportRows) / 2);
+            window->endingIndex = std::min(window->beginningIndex + window->windowSize, model.rowCount()) - 1;
+            model.loadCurrentWindow();
+        }
+    }
+
+    void scrollBy(int rows) { scrollTo(firstRow + rows); }
+
+    qint64 paint()
+    {
+        qint64 calls = 0;
+        const ProgramTableColumnMask visible = model.getVisibleColumns();
+        for (int column = 0; column < model.columnCount(QModelIndex()); ++column) {
+            if (!(visible & columnBit(ProgramTableColumn(column))))
+                continue;
+            model.headerData(column, Qt::Horizontal, Qt::DisplayRole);
+            ++calls;
+        }
+        const int lastRow = std::min(firstRow + viewportRows, model.rowCount()) - 1;
+        for (int row = firstRow; row <= lastRow; ++row) {
+            model.headerData(row, Qt::Vertical, Qt::DisplayRole);
+            ++calls;
+            for (int column = 0; column < model.columnCount(QModelIndex()); ++column) {
+                if (!(visible & columnBit(ProgramTableColumn(column))))
+                    continue;
+                const QModelIndex index = model.index(row, column);
+                for (int role : paintRoles)
+                    model.data(index, role);
+                calls += std::size(paintRoles);
+            }
+        }
+        return calls;
+    }
+
+private:
+    AcademyScopeModel &model;
+    int viewportRows;
+    int firstRow = 0;
+};
+}
+
+ReplayReport ScrollTraceReplayer::run(AcademyScopeBackEnd &backEnd, const ScrollTrace &trace,
+                                      const ReplayOptions &options)
+{
+    ReplayReport report;
+    AcademyScopeModel &model = *backEnd.getDataModel();
+    model.setViewportRowCount(options.viewportRows);
+    HeadlessTableView view(model, options.viewportRows);
+
+    QObject resetCounter;
+    QObject::connect(&model, &QAbstractItemModel::modelReset, &resetCounter, [&report]() { ++report.modelResets; });
+    // Counted on every connection: the model's windows as well as the back end's
+    // filter, estimate and background count statements
+    const qint64 queriesBefore = SQLiteUtil::getStartedStatementCount();
+
+    AcademyScopeParameters parameters;
+    QVector<double> frames;
+    frames.reserve(trace.events.size());
+    QElapsedTimer timer;
+    for (const TraceEvent &event : trace.events) {
+        timer.start();
+        switch (event.type) {
+        case TraceEventType::SetFilters:
+            parameters = event.parameters;
+            backEnd.populateProgramTable(parameters);
+            view.scrollTo(0);
+            break;
+        case TraceEventType::Sort:
+            parameters.order.keys = { event.sortKey };
+            backEnd.populateProgramTable(parameters);
+            view.scrollTo(0);
+            break;
+        case TraceEventType::Scroll:
+            view.scrollBy(event.rows);
+            break;
+        case TraceEventType::Jump:
+            view.scrollTo(event.rows);
+            break;
+        }
+        // Row counts, visibility changes and the like arrive as queued events
+        QCoreApplication::processEvents();
+        report.dataCalls += view.paint();
+
+        const double milliseconds = timer.nsecsElapsed() / 1e6;
+        frames.append(milliseconds);
+        report.droppedFrames += std::max(0, int(std::ceil(milliseconds / options.frameBudgetMilliseconds)) - 1);
+        report.peakResidentSetBytes = std::max(report.peakResidentSetBytes, MemoryUtil::residentSetSizeBytes());
+    }
+
+    report.frameCount = frames.size();
+    report.medianFrameMilliseconds = BenchmarkUtil::percentile(frames, 0.5);
+    report.p95FrameMilliseconds = BenchmarkUtil::percentile(frames, 0.95);
+    report.maxFrameMilliseconds = frames.isEmpty() ? 0 : *std::max_element(frames.cbegin(), frames.cend());
+    report.queriesIssued = SQLiteUtil::getStartedStatementCount() - queriesBefore;
+
+    qDebug().nospace() << "[ScrollTraceReplayer] " << trace.name << ": " << report.frameCount << " frames, median "
+                       << report.medianFrameMilliseconds << " ms, p95 " << report.p95FrameMilliseconds
+                       << " ms, max " << report.maxFrameMilliseconds << " ms, " << report.droppedFrames
+                       << " dropped, " << report.queriesIssued << " queries, " << report.modelResets
+                       << " resets, " << report.dataCalls << " data() calls, peak RSS "
+                       << MemoryUtil::toMegabytes(report.peakResidentSetBytes) << " MB";
+    return report;
+}
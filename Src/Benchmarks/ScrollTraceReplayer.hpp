@@ -0,0 +1,42 @@
+/*
+ScrollTraceReplayer class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "ScrollTrace.hpp"
+
+class AcademyScopeBackEnd;
+
+struct ReplayOptions {
+    int viewportRows = 30;
+    double frameBudgetMilliseconds = 1000.0 / 60;
+};
+
+struct ReplayReport {
+    int frameCount = 0;
+    double medianFrameMilliseconds = 0;
+    double p95FrameMilliseconds = 0;
+    double maxFrameMilliseconds = 0;
+    int droppedFrames = 0;        // frame budgets missed beyond the first, summed over frames
+    qint64 queriesIssued = 0;     // SQLite statements started, by any connection
+    int modelResets = 0;
+    qint64 dataCalls = 0;
+    qint64 peakResidentSetBytes = -1; // sampled after every frame
+};
+
+// Replays a ScrollTrace against the back end's AcademyScopeModel with a
+// headless view. Every event is one frame: the model work it triggers, the
+// queued events it leaves behind and a paint that asks data() for every
+// visible cell with the roles a QTableView delegate asks for.
+class ScrollTraceReplayer
+{
+public:
+    static ReplayReport run(AcademyScopeBackEnd &backEnd, const ScrollTrace &trace,
+                            const ReplayOptions &options = ReplayOptions());
+};
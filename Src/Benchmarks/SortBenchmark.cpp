@@ -0,0 +1,104 @@
+/*
+SortBenchmark class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "SortBenchmark.hpp"
+#include <QElapsedTimer>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+#include <numeric>
+#include "../BackEnd.hpp"
+#include "BenchmarkUtil.hpp"
+#include "../QueryBuilder.hpp"
+#include "../ProgramTableColumnDefinitions.hpp"
+#include "../Data/RankSorter.hpp"
+
+QList<SortBenchmarkResult> SortBenchmark::run(AcademyScopeBackEnd &backEnd, int iterations, int topK)
+{
+    const QList<QList<SortKey>> keySets = {
+        { {ProgramTableColumn::GenelEnKucukPuan, Qt::DescendingOrder} },
+        { {ProgramTableColumn::PuanTuru, Qt::AscendingOrder},
+          {ProgramTableColumn::GenelEnKucukPuan, Qt::DescendingOrder} },
+        { {ProgramTableColumn::PuanTuru, Qt::AscendingOrder},
+          {ProgramTableColumn::GenelEnKucukPuan, Qt::DescendingOrder},
+          {ProgramTableColumn::UniversiteAdi, Qt::AscendingOrder} },
+    };
+
+    QList<SortBenchmarkResult> results;
+    for (const QList<SortKey> &keys : keySets) {
+        const SortBenchmarkResult result = runKeys(backEnd, keys, iterations, topK);
+        qDebug().nospace() << "[SortBenchmark] " << result.keyCount << "-key sort over " << result.rowCount
+                           << " rows: SQL " << result.sqlMilliseconds << " ms, ranks "
+                           << result.inMemoryMilliseconds << " ms, top " << topK << " "
+                           << result.topKMilliseconds << " ms";
+        results << result;
+    }
+    return results;
+}
+
+SortBenchmarkResult SortBenchmark::runKeys(AcademyScopeBackEnd &backEnd, const QList<SortKey> &keys, int iterations,
+                                           int topK)
+{
+    SortBenchmarkResult result;
+    result.keyCount = keys.size();
+
+    std::shared_ptr<const ProgramDataset> dataset = backEnd.getDataset(PlacementType::Regular);
+    if (!dataset)
+        return result;
+    result.rowCount = dataset->rowCount();
+
+    AcademyScopeParameters parameters;
+    parameters.order.keys = keys;
+    const QString sql = "SELECT rowid FROM YKS" + QueryBuilder::buildOrderSql(parameters);
+
+    QVector<RankSorter::Key> rankKeys;
+    for (const SortKey &key : keys) {
+        const int column = dataset->columnIndex(QueryBuilder::getDbColumnNameFromProgramTableColumnIndex(key.column));
+        if (column < 0) {
+            qWarning() << "[SortBenchmark] Column is missing in dataset:" << int(key.column);
+            return result;
+        }
+        rankKeys.append({dataset->ranks(column), dataset->rankCount(column), key.direction == Qt::DescendingOrder});
+    }
+
+    QVector<int> allRows(dataset->rowCount());
+    std::iota(allRows.begin(), allRows.end(), 0);
+
+    QVector<double> sqlSamples, rankSamples, topKSamples;
+    QElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+        timer.start();
+        QSqlQuery query;
+        query.setForwardOnly(true);
+        if (!query.exec(sql)) {
+            qWarning() << "[SortBenchmark] Query failed:" << query.lastError().text();
+            return result;
+        }
+        while (query.next())
+            query.value(0);
+        sqlSamples << timer.nsecsElapsed() / 1e6;
+
+        QVector<int> rows = allRows;
+        timer.start();
+        RankSorter::sortRows(rows, rankKeys);
+        rankSamples << timer.nsecsElapsed() / 1e6;
+
+        rows = allRows;
+        timer.start();
+        RankSorter::selectTopRows(rows, rankKeys, topK);
+        topKSamples << timer.nsecsElapsed() / 1e6;
+    }
+
+    result.sqlMilliseconds = BenchmarkUtil::median(sqlSamples);
+    result.inMemoryMilliseconds = BenchmarkUtil::median(rankSamples);
+    result.topKMilliseconds = BenchmarkUtil::median(topKSamples);
+    return result;
+}
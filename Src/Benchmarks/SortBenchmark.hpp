@@ -0,0 +1,34 @@
+/*
+SortBenchmark class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QList>
+#include "../DataTypeDefinitions.hpp"
+
+class AcademyScopeBackEnd;
+
+struct SortBenchmarkResult {
+    int keyCount = 0;
+    int rowCount = 0;
+    double sqlMilliseconds = 0;      // median ORDER BY over the full table
+    double inMemoryMilliseconds = 0; // median rank radix sort over the full table
+    double topKMilliseconds = 0;     // median bounded partial sort keeping the first screen
+};
+
+// Compares 1-, 2- and 3-key sorts of the whole YKS table through SQLite and
+// through the precomputed rank arrays, and the top-k selection of one screen.
+class SortBenchmark
+{
+public:
+    static QList<SortBenchmarkResult> run(AcademyScopeBackEnd &backEnd, int iterations = 10, int topK = 50);
+private:
+    static SortBenchmarkResult runKeys(AcademyScopeBackEnd &backEnd, const QList<SortKey> &keys, int iterations,
+                                       int topK);
+};
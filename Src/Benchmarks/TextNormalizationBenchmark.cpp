@@ -0,0 +1,103 @@
+/*
+TextNormalizationBenchmark class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "TextNormalizationBenchmark.hpp"
+#include <QElapsedTimer>
+#include <QLocale>
+#include <QStringList>
+#include <QDebug>
+#include <algorithm>
+#include "../BackEnd.hpp"
+#include "BenchmarkUtil.hpp"
+#include "../Utils/TurkishText.hpp"
+
+namespace {
+// StringUtil before TurkishText, kept as the baseline
+QString localeTitleCase(const QLocale &locale, const QString &input)
+{
+    QStringList words = input.split(' ', Qt::SkipEmptyParts);
+    for (QString &word : words) {
+        if (!word.isEmpty()) {
+            QString first = locale.toUpper(word.left(1));
+            QString rest  = locale.toLower(word.mid(1));
+            word = first + rest;
+        }
+    }
+    return words.join(' ');
+}
+}
+
+TextNormalizationBenchmarkResult TextNormalizationBenchmark::run(AcademyScopeBackEnd &backEnd, int iterations)
+{
+    TextNormalizationBenchmarkResult result;
+
+    QVector<QString> names;
+    qsizetype longestName = 0;
+    for (PlacementType placementType : {PlacementType::Regular, PlacementType::Additional}) {
+        std::shared_ptr<const ProgramDataset> dataset = backEnd.getDataset(placementType);
+        if (!dataset)
+            continue;
+        for (const char *columnName : {"UniversiteAdi", "ProgramAdi"}) {
+            const int column = dataset->columnIndex(columnName);
+            if (column < 0)
+                continue;
+            for (int row = 0; row < dataset->rowCount(); ++row) {
+                const QStringView text = dataset->text(column, row);
+                if (text.isNull())
+                    continue;
+                names.append(text.toString());
+                longestName = std::max(longestName, text.size());
+            }
+        }
+    }
+    result.nameCount = names.size();
+    if (names.isEmpty()) {
+        qWarning() << "[TextNormalizationBenchmark] No names to normalize";
+        return result;
+    }
+
+    const QLocale turkishLocale(QLocale::Turkish, QLocale::Turkey);
+    for (const QString &name : names) {
+        if (turkishLocale.toUpper(name) != TurkishText::upper(name)
+            || localeTitleCase(turkishLocale, name) != TurkishText::title(name))
+            ++result.mismatchCount;
+    }
+
+    // The checksum keeps the optimizer from dropping the work
+    QVector<QChar> buffer(longestName);
+    qsizetype checksum = 0;
+    QVector<double> localeSamples, tableSamples, foldSamples;
+    QElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+        timer.start();
+        for (const QString &name : names)
+            checksum += turkishLocale.toUpper(name).size() + localeTitleCase(turkishLocale, name).size();
+        localeSamples << timer.nsecsElapsed() / 1e6;
+
+        timer.start();
+        for (const QString &name : names)
+            checksum += TurkishText::toUpper(name, buffer.data()) + TurkishText::toTitle(name, buffer.data());
+        tableSamples << timer.nsecsElapsed() / 1e6;
+
+        timer.start();
+        for (const QString &name : names)
+            checksum += TurkishText::fold(name, buffer.data());
+        foldSamples << timer.nsecsElapsed() / 1e6;
+    }
+
+    result.localeMilliseconds = BenchmarkUtil::median(localeSamples);
+    result.tableMilliseconds = BenchmarkUtil::median(tableSamples);
+    result.foldMilliseconds = BenchmarkUtil::median(foldSamples);
+    qDebug().nospace() << "[TextNormalizationBenchmark] " << result.nameCount << " names: QLocale "
+                       << result.localeMilliseconds << " ms, TurkishText " << result.tableMilliseconds
+                       << " ms, fold " << result.foldMilliseconds << " ms, mismatches " << result.mismatchCount
+                       << " (checksum " << checksum << ")";
+    return result;
+}
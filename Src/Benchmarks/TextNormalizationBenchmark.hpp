@@ -0,0 +1,30 @@
+/*
+TextNormalizationBenchmark class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+class AcademyScopeBackEnd;
+
+struct TextNormalizationBenchmarkResult {
+    int nameCount = 0;
+    int mismatchCount = 0;           // names where the two paths disagree
+    double localeMilliseconds = 0;   // median QLocale upper + split/join title case over all names
+    double tableMilliseconds = 0;    // median TurkishText upper + title into one reused buffer
+    double foldMilliseconds = 0;     // median TurkishText::fold over all names
+};
+
+// Normalizes every university and program name of both placement tables the
+// way the name filters do, through QLocale as StringUtil used to and through
+// TurkishText, and checks that both produce the same patterns.
+class TextNormalizationBenchmark
+{
+public:
+    static TextNormalizationBenchmarkResult run(AcademyScopeBackEnd &backEnd, int iterations = 10);
+};
@@ -0,0 +1,247 @@
+/*
+AggregationEngine class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "AggregationEngine.hpp"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QThread>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "ProgramFilter.hpp"
+#include "../QueryBuilder.hpp"
+
+namespace {
+// Below this a partition costs more to schedule than to reduce
+constexpr int minimumPartitionRows = 2048;
+
+struct PartialAggregate {
+    int count = 0;
+    double sum = 0;
+    double denominatorSum = 0;
+    double minimum = std::numeric_limits<double>::infinity();
+    double maximum = -std::numeric_limits<double>::infinity();
+    QVector<double> values; // Quantile only
+
+    void merge(const PartialAggregate &other)
+    {
+        count += other.count;
+        sum += other.sum;
+        denominatorSum += other.denominatorSum;
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+        values += other.values;
+    }
+};
+
+struct PartialGroup {
+    int firstRow = -1; // supplies the key values
+    int rowCount = 0;
+    QVector<PartialAggregate> aggregates;
+};
+
+using PartialResult = QHash<quint64, PartialGroup>;
+
+struct ResolvedAggregate {
+    AggregateFunction function;
+    int column = -1;
+    int denominatorColumn = -1;
+    double quantile = 0.5;
+};
+
+struct GroupColumn {
+    int column;
+    ColumnArray<quint32> ranks;
+    quint64 multiplier; // key = sum of rank * multiplier
+};
+
+double quantileOf(QVector<double> &values, double quantile)
+{
+    if (values.isEmpty())
+        return std::numeric_limits<double>::quiet_NaN();
+    const double position = std::clamp(quantile, 0.0, 1.0) * (values.size() - 1);
+    const int lower = int(std::floor(position));
+    std::nth_element(values.begin(), values.begin() + lower, values.end());
+    const double lowerValue = values[lower];
+    if (lower + 1 >= values.size())
+        return lowerValue;
+    // The next value up is the smallest of the upper part
+    const double upperValue = *std::min_element(values.begin() + lower + 1, values.end());
+    return lowerValue + (position - lower) * (upperValue - lowerValue);
+}
+
+double finish(const ResolvedAggregate &aggregate, PartialAggregate &partial, int rowCount)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    switch (aggregate.function) {
+    case AggregateFunction::Count:    return rowCount;
+    case AggregateFunction::Sum:      return partial.count > 0 ? partial.sum : nan;
+    case AggregateFunction::Minimum:  return partial.count > 0 ? partial.minimum : nan;
+    case AggregateFunction::Maximum:  return partial.count > 0 ? partial.maximum : nan;
+    case AggregateFunction::Mean:     return partial.count > 0 ? partial.sum / partial.count : nan;
+    case AggregateFunction::Quantile: return quantileOf(partial.values, aggregate.quantile);
+    case AggregateFunction::Ratio:
+        return partial.count > 0 && partial.denominatorSum != 0 ? partial.sum / partial.denominatorSum : nan;
+    }
+    return nan;
+}
+}
+
+QVector<AggregationGroup> AggregationEngine::aggregate(const DatasetSnapshot &snapshot,
+                                                       const AcademyScopeParameters &parameters,
+                                                       const QList<ProgramTableColumn> &groupBy,
+                                                       const QList<Aggregate> &aggregates,
+                                                       AggregationStatistics *statistics)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if (parameters.year.has_value()) {
+        qWarning() << "[AggregationEngine] Only the current year is held in memory";
+        return {};
+    }
+    const std::shared_ptr<const ProgramDataset> dataset = snapshot.getDataset(parameters.placementType);
+    if (!dataset)
+        return {};
+
+    auto columnOf = [&dataset](ProgramTableColumn column) {
+        return dataset->columnIndex(QueryBuilder::getDbColumnNameFromProgramTableColumnIndex(column));
+    };
+
+    // Ranks are dense, so the ranks of all group-by columns pack into one key
+    QVector<GroupColumn> groupColumns;
+    quint64 keySpace = 1;
+    for (ProgramTableColumn column : groupBy) {
+        const int datasetColumn = columnOf(column);
+        if (datasetColumn < 0) {
+            qWarning() << "[AggregationEngine] Group-by column is missing in dataset:" << int(column);
+            return {};
+        }
+        const quint64 rankCount = std::max<quint64>(dataset->rankCount(datasetColumn), 1);
+        if (keySpace > std::numeric_limits<quint64>::max() / rankCount) {
+            qWarning() << "[AggregationEngine] Too many distinct group-by combinations";
+            return {};
+        }
+        groupColumns.append({datasetColumn, dataset->ranks(datasetColumn), keySpace});
+        keySpace *= rankCount;
+    }
+
+    QVector<ResolvedAggregate> resolved;
+    for (const Aggregate &aggregate : aggregates) {
+        ResolvedAggregate entry{aggregate.function, -1, -1, aggregate.quantile};
+        if (aggregate.function != AggregateFunction::Count) {
+            entry.column = columnOf(aggregate.column);
+            if (aggregate.function == AggregateFunction::Ratio)
+                entry.denominatorColumn = columnOf(aggregate.denominator);
+            const bool missing = entry.column < 0
+                                 || (aggregate.function == AggregateFunction::Ratio && entry.denominatorColumn < 0);
+            if (missing || dataset->isTextColumn(entry.column)
+                || (entry.denominatorColumn >= 0 && dataset->isTextColumn(entry.denominatorColumn))) {
+                qWarning() << "[AggregationEngine] Aggregated columns must be numeric dataset columns:"
+                           << int(aggregate.column);
+                return {};
+            }
+        }
+        resolved.append(entry);
+    }
+
+    // The rows the table shows for the same parameters: same helper, same name folding
+    const QVector<int> rows = ProgramFilter::filterRows(snapshot, parameters);
+
+    const int partitionCount = std::clamp(int(rows.size() / minimumPartitionRows), 1, QThread::idealThreadCount());
+    QVector<std::pair<int, int>> partitions;
+    for (int partition = 0; partition < partitionCount; ++partition)
+        partitions.append({int(qint64(rows.size()) * partition / partitionCount),
+                           int(qint64(rows.size()) * (partition + 1) / partitionCount)});
+
+    auto reducePartition = [&](const std::pair<int, int> &partition) {
+        PartialResult result;
+        for (int i = partition.first; i < partition.second; ++i) {
+            const int row = rows[i];
+            quint64 key = 0;
+            for (const GroupColumn &groupColumn : groupColumns)
+                key += groupColumn.ranks[row] * groupColumn.multiplier;
+
+            PartialGroup &group = result[key];
+            if (group.firstRow < 0) {
+                group.firstRow = row;
+                group.aggregates.resize(resolved.size());
+            }
+            ++group.rowCount;
+
+            for (int a = 0; a < resolved.size(); ++a) {
+                const ResolvedAggregate &aggregate = resolved[a];
+                if (aggregate.function == AggregateFunction::Count)
+                    continue;
+                const double value = dataset->number(aggregate.column, row);
+                if (std::isnan(value))
+                    continue;
+                double denominator = 0;
+                if (aggregate.function == AggregateFunction::Ratio) {
+                    denominator = dataset->number(aggregate.denominatorColumn, row);
+                    if (std::isnan(denominator))
+                        continue;
+                }
+                PartialAggregate &partial = group.aggregates[a];
+                ++partial.count;
+                partial.sum += value;
+                partial.denominatorSum += denominator;
+                partial.minimum = std::min(partial.minimum, value);
+                partial.maximum = std::max(partial.maximum, value);
+                if (aggregate.function == AggregateFunction::Quantile)
+                    partial.values.append(value);
+            }
+        }
+        return result;
+    };
+    auto mergePartition = [](PartialResult &merged, const PartialResult &partial) {
+        for (auto it = partial.constBegin(); it != partial.constEnd(); ++it) {
+            PartialGroup &group = merged[it.key()];
+            if (group.firstRow < 0) {
+                group = it.value();
+                continue;
+            }
+            group.firstRow = std::min(group.firstRow, it.value().firstRow);
+            group.rowCount += it.value().rowCount;
+            for (int a = 0; a < group.aggregates.size(); ++a)
+                group.aggregates[a].merge(it.value().aggregates[a]);
+        }
+    };
+
+    PartialResult merged = partitionCount == 1
+                               ? reducePartition(partitions.first())
+                               : QtConcurrent::blockingMappedReduced<PartialResult>(partitions, reducePartition,
+                                                                                    mergePartition);
+
+    QList<quint64> keys = merged.keys();
+    std::sort(keys.begin(), keys.end());
+    QVector<AggregationGroup> groups;
+    groups.reserve(keys.size());
+    for (quint64 key : keys) {
+        PartialGroup &partial = merged[key];
+        AggregationGroup group;
+        // value() deep-copies text, so the keys stay valid after the snapshot image is unmapped
+        for (const GroupColumn &groupColumn : groupColumns)
+            group.keys.append(dataset->value(partial.firstRow, groupColumn.column));
+        group.rowCount = partial.rowCount;
+        for (int a = 0; a < resolved.size(); ++a)
+            group.values.append(finish(resolved[a], partial.aggregates[a], partial.rowCount));
+        groups.append(group);
+    }
+
+    if (statistics) {
+        statistics->rowCount = rows.size();
+        statistics->partitionCount = partitionCount;
+        statistics->elapsedMilliseconds = timer.elapsed();
+    }
+    return groups;
+}
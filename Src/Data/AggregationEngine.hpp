@@ -0,0 +1,63 @@
+/*
+AggregationEngine class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QList>
+#include <QVariant>
+#include <QVector>
+#include "../DataTypeDefinitions.hpp"
+#include "../ProgramTableColumnDefinitions.hpp"
+#include "DatasetSnapshot.hpp"
+
+enum class AggregateFunction {
+    Count,    // rows of the group; the column is not read
+    Sum,
+    Minimum,
+    Maximum,
+    Mean,
+    Quantile, // exact, linearly interpolated between neighbours; 0.5 is the median
+    Ratio     // Sum(column) / Sum(denominator) over rows where both are set, e.g. a fill rate
+};
+
+struct Aggregate {
+    AggregateFunction function = AggregateFunction::Count;
+    ProgramTableColumn column = ProgramTableColumn::ProgramKodu;
+    double quantile = 0.5;                                            // Quantile only, in [0, 1]
+    ProgramTableColumn denominator = ProgramTableColumn::ProgramKodu; // Ratio only
+};
+
+struct AggregationGroup {
+    QVariantList keys;      // one per group-by column, as stored in the dataset
+    int rowCount = 0;
+    QVector<double> values; // one per aggregate; NaN when no row of the group has a value
+};
+
+struct AggregationStatistics {
+    int rowCount = 0;       // filtered rows that were aggregated
+    int partitionCount = 0;
+    qint64 elapsedMilliseconds = 0;
+};
+
+// Grouped statistics over the filtered rows of a snapshot's dataset, e.g.
+// seats against placements per university or score quantiles per faculty and
+// track. The filtered rows are split into partitions that are reduced on the
+// Qt global thread pool into partial states (sums, counts, extremes and, for
+// quantiles, the values themselves), which are then merged. Groups are keyed
+// by the group-by columns' ranks, so they come out in rank order (Turkish
+// collation for text). Like the rank path, only the current year is in memory.
+class AggregationEngine
+{
+public:
+    static QVector<AggregationGroup> aggregate(const DatasetSnapshot &snapshot,
+                                               const AcademyScopeParameters &parameters,
+                                               const QList<ProgramTableColumn> &groupBy,
+                                               const QList<Aggregate> &aggregates,
+                                               AggregationStatistics *statistics = nullptr);
+};
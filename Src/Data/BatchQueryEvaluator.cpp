@@ -0,0 +1,138 @@
+/*
+BatchQueryEvaluator class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "BatchQueryEvaluator.hpp"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <numeric>
+#include "ProgramFilter.hpp"
+#include "RankSorter.hpp"
+#include "../QueryBuilder.hpp"
+
+namespace {
+struct Group {
+    const ProgramDataset *dataset = nullptr;
+    const BitmapIndex *bitmapIndex = nullptr;
+    const ZoneMap *zoneMap = nullptr;
+    QVector<int> members;
+    QVector<int> candidateRows;
+};
+}
+
+QVector<BatchQueryResult> BatchQueryEvaluator::evaluate(const DatasetSnapshot &snapshot,
+                                                        const QVector<AcademyScopeParameters> &parameterSets,
+                                                        bool countsOnly,
+                                                        BatchQueryStatistics *statistics)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<BatchQueryResult> results(parameterSets.size());
+
+    // --- Group by shared categorical predicates ---
+    QHash<QString, int> groupIndexByKey;
+    QVector<Group> groups;
+    QVector<int> groupOfSet(parameterSets.size(), -1);
+    for (int i = 0; i < parameterSets.size(); ++i) {
+        const AcademyScopeParameters &parameters = parameterSets[i];
+        const ProgramDataset *dataset = snapshot.getDataset(parameters.placementType).get();
+        if (!dataset)
+            continue;
+
+        const QString key = ProgramFilter::categoricalKey(parameters);
+        auto it = groupIndexByKey.constFind(key);
+        if (it == groupIndexByKey.constEnd()) {
+            it = groupIndexByKey.insert(key, groups.size());
+            groups.append(Group{dataset, snapshot.getBitmapIndex(parameters.placementType).get(),
+                                snapshot.getZoneMap(parameters.placementType).get(), {}, {}});
+        }
+        groups[it.value()].members.append(i);
+        groupOfSet[i] = it.value();
+    }
+
+    // --- One categorical evaluation per group ---
+    QtConcurrent::blockingMap(groups, [&](Group &group) {
+        if (group.bitmapIndex) {
+            group.candidateRows = group.bitmapIndex->evaluateCategorical(parameterSets[group.members.first()]).toRows();
+            return;
+        }
+        const ProgramFilter filter(*group.dataset, parameterSets[group.members.first()]);
+        for (int row = 0; row < group.dataset->rowCount(); ++row)
+            if (filter.matchesCategorical(row))
+                group.candidateRows.append(row);
+    });
+
+    // --- Residual predicates per parameter set ---
+    QVector<int> setIndexes(parameterSets.size());
+    std::iota(setIndexes.begin(), setIndexes.end(), 0);
+    std::atomic<qint64> candidateRowCount{0};
+    std::atomic<qint64> scannedRowCount{0};
+    QtConcurrent::blockingMap(setIndexes, [&](int setIndex) {
+        if (groupOfSet[setIndex] < 0)
+            return;
+        const Group &group = groups[groupOfSet[setIndex]];
+        const AcademyScopeParameters &parameters = parameterSets[setIndex];
+        const ProgramFilter filter(*group.dataset, parameters);
+
+        // Blocks whose min/max cannot satisfy the score or quota ranges are never touched
+        const QVector<ZoneMap::Range> ranges = filter.getPrunableRanges();
+        QVector<int> candidates;
+        if (group.zoneMap && !ranges.isEmpty()) {
+            const QVector<int> zoneRows = group.zoneMap->candidateRows(ranges);
+            std::set_intersection(group.candidateRows.cbegin(), group.candidateRows.cend(),
+                                  zoneRows.cbegin(), zoneRows.cend(), std::back_inserter(candidates));
+        } else {
+            candidates = group.candidateRows;
+        }
+        candidateRowCount += group.candidateRows.size();
+        scannedRowCount += candidates.size();
+
+        QVector<int> rows = filter.filterRows(candidates, true);
+
+        BatchQueryResult &result = results[setIndex];
+        result.count = rows.size();
+        if (countsOnly)
+            return;
+
+        QVector<RankSorter::Key> rankKeys;
+        for (const SortKey &key : parameters.order.sortKeys()) {
+            const int column = group.dataset->columnIndex(QueryBuilder::getDbColumnNameFromProgramTableColumnIndex(key.column));
+            if (column >= 0)
+                rankKeys.append({group.dataset->ranks(column), group.dataset->rankCount(column),
+                                 key.direction == Qt::DescendingOrder});
+        }
+        RankSorter::sortRows(rows, rankKeys);
+
+        result.rowIds.reserve(rows.size());
+        for (int row : rows)
+            result.rowIds.append(group.dataset->rowId(row));
+    });
+
+    const qint64 elapsed = timer.elapsed();
+    const double setsPerSecond = parameterSets.size() * 1000.0 / std::max<qint64>(1, elapsed);
+    const double residualScanFraction = candidateRowCount > 0 ? double(scannedRowCount) / candidateRowCount : 1;
+    qDebug() << "[BatchQueryEvaluator]" << parameterSets.size() << "parameter sets in" << groups.size()
+             << "groups," << elapsed << "ms," << setsPerSecond << "sets/s, residual scan"
+             << residualScanFraction;
+
+    if (statistics) {
+        statistics->parameterSetCount = parameterSets.size();
+        statistics->groupCount = groups.size();
+        statistics->elapsedMilliseconds = elapsed;
+        statistics->parameterSetsPerSecond = setsPerSecond;
+        statistics->residualScanFraction = residualScanFraction;
+    }
+    return results;
+}
@@ -0,0 +1,43 @@
+/*
+BatchQueryEvaluator class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QVector>
+#include <memory>
+#include "../DataTypeDefinitions.hpp"
+#include "DatasetSnapshot.hpp"
+
+struct BatchQueryResult {
+    QVector<qint64> rowIds; // empty when only counts were requested
+    int count = 0;
+};
+
+struct BatchQueryStatistics {
+    int parameterSetCount = 0;
+    int groupCount = 0;
+    qint64 elapsedMilliseconds = 0;
+    double parameterSetsPerSecond = 0;
+    // Share of categorical candidates the residual predicates still had to check
+    // after zone map pruning
+    double residualScanFraction = 1;
+};
+
+// Evaluates many AcademyScopeParameters at once. Sets sharing the same
+// categorical predicates are grouped and their common candidate rows are
+// computed once from the snapshot's bitmap index; the per-set residual
+// predicates then run on the Qt global thread pool.
+class BatchQueryEvaluator
+{
+public:
+    static QVector<BatchQueryResult> evaluate(const DatasetSnapshot &snapshot,
+                                              const QVector<AcademyScopeParameters> &parameterSets,
+                                              bool countsOnly,
+                                              BatchQueryStatistics *statistics = nullptr);
+};
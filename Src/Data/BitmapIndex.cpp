@@ -0,0 +1,176 @@
+/*
+BitmapIndex class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "BitmapIndex.hpp"
+#include <QStringList>
+#include <QDebug>
+#include <cmath>
+#include "ProgramFilter.hpp"
+
+namespace {
+const QStringList valueColumns = {
+    "PuanTuru", "UlkeKodu", "Lisans", "DevletUniversitesi", "KKTCUyruklu", "MTOK", "UcretDurumu"
+};
+const QStringList presenceColumns = {
+    "GenelKontenjan", "OkulBirincisiKontenjan", "SehitGaziKontenjan", "DepremzedeKontenjan", "Kadin34Kontenjan"
+};
+}
+
+std::shared_ptr<const BitmapIndex> BitmapIndex::build(const ProgramDataset &dataset)
+{
+    auto index = std::make_shared<BitmapIndex>();
+    index->rowCount = dataset.rowCount();
+
+    for (const QString &name : valueColumns + presenceColumns) {
+        const int column = dataset.columnIndex(name);
+        if (column < 0)
+            continue;
+        const bool indexValues = valueColumns.contains(name);
+        const bool isText = dataset.isTextColumn(column);
+
+        // Rows are visited in order, so every list is already sorted
+        QHash<QString, QVector<int>> rowsByValue;
+        QVector<int> notNullRows;
+        for (int row = 0; row < dataset.rowCount(); ++row) {
+            QString value;
+            if (isText) {
+                const QStringView text = dataset.text(column, row);
+                if (text.isNull())
+                    continue;
+                value = text.toString();
+            } else {
+                const double number = dataset.number(column, row);
+                if (std::isnan(number))
+                    continue;
+                value = QString::number(number);
+            }
+            notNullRows.append(row);
+            if (indexValues)
+                rowsByValue[value].append(row);
+        }
+
+        auto store = [&index](QHash<QString, ColumnArray<quint64>> &bitmaps, const QString &key,
+                              const QVector<int> &rows) {
+            index->bitmapStorage.append(RowBitmap::fromSortedRows(rows).toFlat());
+            bitmaps.insert(key, index->bitmapStorage.last());
+        };
+        store(index->notNullBitmaps, name, notNullRows);
+        for (auto it = rowsByValue.cbegin(); it != rowsByValue.cend(); ++it)
+            store(index->bitmapsByValue, valueKey(name, it.key()), it.value());
+    }
+    return index;
+}
+
+QString BitmapIndex::valueKey(const QString &column, const QString &value)
+{
+    return column + '=' + value;
+}
+
+RowBitmap BitmapIndex::unpack(const QHash<QString, ColumnArray<quint64>> &bitmaps, const QString &key) const
+{
+    const auto it = bitmaps.constFind(key);
+    if (it == bitmaps.constEnd())
+        return {};
+    // Attached bitmaps were checked when the image was read; this only fails on a corrupted mapping
+    std::optional<RowBitmap> bitmap = RowBitmap::fromFlat(it.value(), rowCount);
+    if (!bitmap) {
+        qWarning() << "[BitmapIndex] Malformed bitmap for" << key;
+        return {};
+    }
+    return std::move(*bitmap);
+}
+
+RowBitmap BitmapIndex::equals(const QString &column, double value) const
+{
+    return unpack(bitmapsByValue, valueKey(column, QString::number(value)));
+}
+
+RowBitmap BitmapIndex::equals(const QString &column, const QString &text) const
+{
+    return unpack(bitmapsByValue, valueKey(column, text));
+}
+
+RowBitmap BitmapIndex::notNull(const QString &column) const
+{
+    return unpack(notNullBitmaps, column);
+}
+
+RowBitmap BitmapIndex::evaluateCategorical(const AcademyScopeParameters &parameters) const
+{
+    RowBitmap rows = RowBitmap::allRows(rowCount);
+
+    switch (parameters.country) {
+    case Country::Turkiye:          rows = rows & equals("UlkeKodu", 90); break;
+    case Country::Cyprus:           rows = rows & equals("UlkeKodu", 357); break;
+    case Country::ForeignCountries:
+        rows = rows & notNull("UlkeKodu").andNot(equals("UlkeKodu", 90) | equals("UlkeKodu", 357));
+        break;
+    case Country::AllCountries:
+        break;
+    }
+
+    if (parameters.degreeType == DegreeType::Bachelor)       rows = rows & equals("Lisans", 1);
+    else if (parameters.degreeType == DegreeType::Associate) rows = rows & equals("Lisans", 0);
+
+    if (parameters.universityType == UniversityType::Government)   rows = rows & equals("DevletUniversitesi", 1);
+    else if (parameters.universityType == UniversityType::Private) rows = rows & equals("DevletUniversitesi", 0);
+
+    const QString trackName = ProgramFilter::trackNameOf(parameters.trackType);
+    if (!trackName.isEmpty())
+        rows = rows & equals("PuanTuru", trackName);
+
+    const SelectedQuotaTypes &quotas = parameters.selectedQuotaTypes;
+    if (!quotas.trncNationalsQuota) rows = rows & equals("KKTCUyruklu", 0);
+    if (!quotas.mtokQuota)          rows = rows & equals("MTOK", 0);
+
+    RowBitmap anyQuota;
+    bool quotaSelected = false;
+    auto addQuota = [&](bool selected, const RowBitmap &bitmap) {
+        if (!selected)
+            return;
+        anyQuota = anyQuota | bitmap;
+        quotaSelected = true;
+    };
+    addQuota(quotas.regularQuota,                  notNull("GenelKontenjan"));
+    addQuota(quotas.highSchoolValedictoriansQuota, notNull("OkulBirincisiKontenjan"));
+    addQuota(quotas.martyrsAndVeteransQuota,       notNull("SehitGaziKontenjan"));
+    addQuota(quotas.earthquakeVictimsQuota,        notNull("DepremzedeKontenjan"));
+    addQuota(quotas.women34PlusQuota,              notNull("Kadin34Kontenjan"));
+    addQuota(quotas.trncNationalsQuota,            equals("KKTCUyruklu", 1));
+    addQuota(quotas.mtokQuota,                     equals("MTOK", 1));
+    if (quotaSelected)
+        rows = rows & anyQuota;
+
+    RowBitmap tuition;
+    bool tuitionSelected = false;
+    auto addTuition = [&](bool selected, double value) {
+        if (!selected)
+            return;
+        tuition = tuition | equals("UcretDurumu", value);
+        tuitionSelected = true;
+    };
+    addTuition(parameters.selectedTuitionFeeTypes.free, 0);
+    addTuition(parameters.selectedTuitionFeeTypes.discounted, 50);
+    addTuition(parameters.selectedTuitionFeeTypes.paid, 100);
+    if (tuitionSelected)
+        rows = rows & tuition;
+
+    return rows;
+}
+
+qint64 BitmapIndex::estimatedMemoryBytes() const
+{
+    qint64 bytes = sizeof(*this)
+                   + (bitmapsByValue.capacity() + notNullBitmaps.capacity())
+                         * qint64(sizeof(QString) + sizeof(ColumnArray<quint64>));
+    for (const QVector<quint64> &flat : bitmapStorage)
+        bytes += flat.capacity() * qint64(sizeof(quint64));
+    return bytes;
+}
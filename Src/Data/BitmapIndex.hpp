@@ -0,0 +1,51 @@
+/*
+BitmapIndex class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QHash>
+#include <QString>
+#include <memory>
+#include "../DataTypeDefinitions.hpp"
+#include "ProgramDataset.hpp"
+#include "RowBitmap.hpp"
+
+// One RowBitmap per value of the low-cardinality filter columns, plus a
+// presence bitmap per quota column. The categorical part of a filter (see
+// ProgramFilter::matchesCategorical) becomes a handful of AND/OR operations.
+// Bitmaps are kept in RowBitmap's flat form, read from a mapped
+// SnapshotImage when the index is attached, and unpacked per lookup.
+class BitmapIndex
+{
+public:
+    static std::shared_ptr<const BitmapIndex> build(const ProgramDataset &dataset);
+
+    // Rows passing ProgramFilter::matchesCategorical for the parameters
+    RowBitmap evaluateCategorical(const AcademyScopeParameters &parameters) const;
+
+    // Empty bitmaps for columns or values that are not indexed
+    RowBitmap equals(const QString &column, double value) const;
+    RowBitmap equals(const QString &column, const QString &text) const;
+    RowBitmap notNull(const QString &column) const;
+
+    qint64 estimatedMemoryBytes() const;
+
+private:
+    friend class SnapshotImage;
+
+    static QString valueKey(const QString &column, const QString &value);
+    RowBitmap unpack(const QHash<QString, ColumnArray<quint64>> &bitmaps, const QString &key) const;
+
+    int rowCount = 0;
+    QHash<QString, ColumnArray<quint64>> bitmapsByValue; // "column=value"
+    QHash<QString, ColumnArray<quint64>> notNullBitmaps; // by column
+    // Backing of the flat bitmaps above for an index built in this process
+    QVector<QVector<quint64>> bitmapStorage;
+    std::shared_ptr<const void> image; // keeps an attached image mapped
+};
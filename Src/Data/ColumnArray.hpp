@@ -0,0 +1,35 @@
+/*
+ColumnArray class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QVector>
+
+// Read-only view of a column's values. The values belong either to the
+// dataset that loaded them or to a mapped SnapshotImage; readers cannot tell
+// the two apart. A view made from a QVector must not outlive the vector.
+template <typename T>
+class ColumnArray
+{
+public:
+    ColumnArray() = default;
+    ColumnArray(const T *values, qsizetype size) : values(values), count(size) {}
+    ColumnArray(const QVector<T> &vector) : values(vector.constData()), count(vector.size()) {}
+
+    const T &operator[](qsizetype index) const { return values[index]; }
+    qsizetype size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    const T *constData() const { return values; }
+    const T *begin() const { return values; }
+    const T *end() const { return values + count; }
+
+private:
+    const T *values = nullptr;
+    qsizetype count = 0;
+};
@@ -0,0 +1,429 @@
+/*
+DatasetManager class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "DatasetManager.hpp"
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
+#include "../LookupLists.hpp"
+#include "../ProgramTableColumnDefinitions.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+#include "../Utils/MemoryUtil.hpp"
+#include "SnapshotImage.hpp"
+
+DatasetManager::DatasetManager(QObject *parent)
+    : QObject(parent)
+{
+    // Publishers usually write the file in several steps; wait until it settles
+    debounceTimer.setSingleShot(true);
+    debounceTimer.setInterval(1000);
+    connect(&debounceTimer, &QTimer::timeout, this, &DatasetManager::reload);
+    connect(&watcher, &QFileSystemWatcher::fileChanged, this, &DatasetManager::onDatabaseFileChanged);
+    connect(&watcher, &QFileSystemWatcher::directoryChanged, this, &DatasetManager::onDatabaseFileChanged);
+    connect(&reloadWatcher, &QFutureWatcher<std::shared_ptr<DatasetSnapshot>>::finished,
+            this, &DatasetManager::onReloadFinished);
+}
+
+DatasetManager::~DatasetManager()
+{
+    reloadWatcher.waitForFinished();
+}
+
+bool DatasetManager::loadInitial(const QString &path)
+{
+    databasePath = path;
+    removeStaleFiles(databasePath, fileStampOf(databasePath));
+    return publish(buildSnapshot(databasePath, nextVersion++, snapshotSharing));
+}
+
+void DatasetManager::loadInitialAsync(const QString &path)
+{
+    databasePath = path;
+    removeStaleFiles(databasePath, fileStampOf(databasePath));
+    if (reloadWatcher.isRunning()) {
+        reloadPending = true;
+        return;
+    }
+
+    emit reloadStarted();
+    const int version = nextVersion++;
+    const SnapshotSharing sharing = snapshotSharing;
+    reloadWatcher.setFuture(QtConcurrent::run([path, version, sharing]() {
+        return buildSnapshot(path, version, sharing);
+    }));
+}
+
+void DatasetManager::setWatchingEnabled(bool enabled)
+{
+    if (!watcher.files().isEmpty()) watcher.removePaths(watcher.files());
+    if (!watcher.directories().isEmpty()) watcher.removePaths(watcher.directories());
+    if (!enabled || databasePath.isEmpty())
+        return;
+
+    // The directory is watched too: replacing the file by rename drops the file watch
+    watcher.addPath(databasePath);
+    watcher.addPath(QFileInfo(databasePath).absolutePath());
+}
+
+void DatasetManager::setSnapshotSharing(SnapshotSharing sharing)
+{
+    snapshotSharing = sharing;
+}
+
+void DatasetManager::reload()
+{
+    if (reloadWatcher.isRunning()) {
+        reloadPending = true;
+        return;
+    }
+
+    // A process that had to load privately attaches once the publisher has caught up
+    const std::shared_ptr<const DatasetSnapshot> current = getCurrentSnapshot();
+    if (current && current->getFileStamp() == fileStampOf(databasePath)) {
+        const bool canAttach = snapshotSharing == SnapshotSharing::Attach && current->getSharedBytes() == 0
+                               && SnapshotImage::fileStampOf(SnapshotImage::imagePathFor(databasePath))
+                                      == current->getFileStamp();
+        if (!canAttach)
+            return;
+    }
+
+    emit reloadStarted();
+    const QString path = databasePath;
+    const int version = nextVersion++;
+    const SnapshotSharing sharing = snapshotSharing;
+    reloadWatcher.setFuture(QtConcurrent::run([path, version, sharing]() {
+        return buildSnapshot(path, version, sharing);
+    }));
+}
+
+std::shared_ptr<const DatasetSnapshot> DatasetManager::getCurrentSnapshot() const
+{
+    return std::atomic_load(&currentSnapshot);
+}
+
+QString DatasetManager::fileStampOf(const QString &path)
+{
+    const QFileInfo info(path);
+    if (!info.exists())
+        return {};
+    return QString("%1-%2").arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+}
+
+void DatasetManager::onDatabaseFileChanged()
+{
+    if (QFileInfo::exists(databasePath) && !watcher.files().contains(databasePath))
+        watcher.addPath(databasePath);
+    debounceTimer.start();
+}
+
+void DatasetManager::onReloadFinished()
+{
+    const std::shared_ptr<DatasetSnapshot> snapshot = reloadWatcher.result();
+    if (!snapshot)
+        emit reloadFailed("Dataset could not be loaded from " + databasePath);
+    else
+        publish(snapshot);
+
+    if (reloadPending) {
+        reloadPending = false;
+        reload();
+    }
+}
+
+QString DatasetManager::versionedPathFor(const QString &path, const QString &fileStamp)
+{
+    return QString("%1.%2.version").arg(path, fileStamp);
+}
+
+namespace {
+// Runs work on a connection of its own; connections cannot cross threads.
+// Versioned files never change and are opened immutable; the watched file is
+// opened read-only.
+template <typename Work>
+bool withConnection(const QString &connectionName, const QString &path, bool immutable, Work work)
+{
+    bool opened = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        if (immutable) {
+            opened = SQLiteUtil::openImmutable(db, path);
+        } else {
+            db.setDatabaseName(path);
+            db.setConnectOptions("QSQLITE_OPEN_READONLY");
+            opened = db.open();
+        }
+        if (!opened) {
+            qWarning() << "[DatasetManager] Database could not be opened:" << db.lastError().text();
+        } else {
+            SQLiteUtil::configureConnection(db);
+            work(db);
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return opened;
+}
+}
+
+std::shared_ptr<DatasetSnapshot> DatasetManager::buildSnapshot(const QString &path, int version,
+                                                               SnapshotSharing sharing)
+{
+    if (sharing == SnapshotSharing::Attach) {
+        if (std::shared_ptr<DatasetSnapshot> snapshot = attachSnapshot(path, version))
+            return snapshot;
+        qDebug() << "[DatasetManager] No current snapshot image for" << path << "- loading privately";
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto snapshot = std::make_shared<DatasetSnapshot>(version, path, fileStampOf(path));
+    if (!openVersionedFile(*snapshot))
+        return nullptr;
+    const QString loaderName = QString("dataset-loader-%1").arg(version);
+    // Everything below reads the versioned file, never the watched one
+    const QString &snapshotPath = snapshot->getSnapshotFilePath();
+
+    // The file is only read; indexes are written by the database build step
+    // (SQLiteUtil::prepareDatabase), so the stamp stays valid and read-only installs work
+    const bool opened = withConnection(loaderName, snapshotPath, true, [](QSqlDatabase &db) {
+        for (const QString &table : { QString("YKS"), QString("EkTercihDetayli") }) {
+            const QStringList missing = SQLiteUtil::missingIndexes(db, table, SQLiteUtil::indexedColumns());
+            if (!missing.isEmpty())
+                qWarning() << "[DatasetManager]" << table << "has no index on" << missing
+                           << "- quota range filters will scan the table";
+        }
+    });
+    if (!opened)
+        return nullptr;
+    const qint64 indexesMilliseconds = timer.elapsed();
+
+    // Both tables and the lookup lists load in parallel, each on its own connection
+    auto loadTable = [&snapshotPath](const QString &connectionName, const QString &table,
+                                     DatasetSnapshot *target, bool additional) {
+        withConnection(connectionName, snapshotPath, true, [&](QSqlDatabase &db) {
+            std::shared_ptr<const ProgramDataset> dataset = ProgramDataset::load(db, table);
+            if (dataset)
+                buildIndexes(*target, dataset, additional);
+        });
+    };
+    QFuture<void> additional = QtConcurrent::run([&]() {
+        loadTable(loaderName + "-additional", "EkTercihDetayli", snapshot.get(), true);
+    });
+    QFuture<void> lookups = QtConcurrent::run([&]() {
+        withConnection(loaderName + "-lookups", snapshotPath, true, [&](QSqlDatabase &db) {
+            snapshot->universities = LookupLists::loadUniversities(db);
+            snapshot->departments = LookupLists::loadDepartments(db);
+        });
+    });
+    // The regular table is the largest; it loads on this thread while the others run
+    loadTable(loaderName + "-regular", "YKS", snapshot.get(), false);
+    additional.waitForFinished();
+    lookups.waitForFinished();
+
+    if (snapshot->regularDataset && snapshot->additionalDataset)
+        snapshot->programJoinIndex = ProgramJoinIndex::build(*snapshot->regularDataset, *snapshot->additionalDataset);
+
+    qDebug() << "[DatasetManager] Built snapshot version" << version << "in" << timer.elapsed() << "ms"
+             << "(index check" << indexesMilliseconds << "ms)";
+    if (!snapshot->regularDataset)
+        return nullptr;
+
+    if (sharing == SnapshotSharing::Publish) {
+        timer.restart();
+        if (SnapshotImage::write(*snapshot, SnapshotImage::imagePathFor(path)))
+            qDebug() << "[DatasetManager] Wrote snapshot image in" << timer.elapsed() << "ms";
+    }
+    return snapshot;
+}
+
+std::shared_ptr<DatasetSnapshot> DatasetManager::attachSnapshot(const QString &path, int version)
+{
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 rssBefore = MemoryUtil::residentSetSizeBytes();
+
+    const QString fileStamp = fileStampOf(path);
+    std::optional<SnapshotImage::Contents> contents = SnapshotImage::attach(SnapshotImage::imagePathFor(path),
+                                                                            fileStamp);
+    if (!contents)
+        return nullptr;
+    const qint64 attachMilliseconds = timer.elapsed();
+
+    auto snapshot = std::make_shared<DatasetSnapshot>(version, path, fileStamp);
+    // Rows are still fetched through SQLite, from the shared versioned file the image was written from
+    if (!openVersionedFile(*snapshot))
+        return nullptr;
+    // Datasets and indexes alike point into the mapping; nothing is rebuilt per process
+    warnAboutMissingColumns(*contents->regularDataset);
+    if (contents->additionalDataset)
+        warnAboutMissingColumns(*contents->additionalDataset);
+    snapshot->regularDataset = std::move(contents->regularDataset);
+    snapshot->additionalDataset = std::move(contents->additionalDataset);
+    snapshot->regularScoreIndex = std::move(contents->regularScoreIndex);
+    snapshot->additionalScoreIndex = std::move(contents->additionalScoreIndex);
+    snapshot->regularBitmapIndex = std::move(contents->regularBitmapIndex);
+    snapshot->additionalBitmapIndex = std::move(contents->additionalBitmapIndex);
+    snapshot->regularZoneMap = std::move(contents->regularZoneMap);
+    snapshot->additionalZoneMap = std::move(contents->additionalZoneMap);
+    snapshot->programJoinIndex = std::move(contents->programJoinIndex);
+    snapshot->universities = std::move(contents->universities);
+    snapshot->departments = std::move(contents->departments);
+    snapshot->sharedBytes = contents->mappedBytes;
+
+    // Growth of this process only: mapped pages already resident through another process are not counted again
+    qDebug() << "[DatasetManager] Attached snapshot image version" << version << "in" << attachMilliseconds
+             << "ms - shared"
+             << MemoryUtil::toMegabytes(snapshot->sharedBytes) << "MB, private"
+             << MemoryUtil::toMegabytes(snapshot->estimatedMemoryBytes()) << "MB, RSS grew"
+             << MemoryUtil::toMegabytes(MemoryUtil::residentSetSizeBytes() - rssBefore) << "MB";
+    return snapshot;
+}
+
+bool DatasetManager::openVersionedFile(DatasetSnapshot &snapshot)
+{
+    // A reader of the watched file would see a publisher overwriting it in
+    // place; snapshots read a file per version that nothing writes to once
+    // it exists. The first process to need a version writes it for all of them.
+    // Read-only installs cannot hold versioned files; whatever updates them replaces the file as a whole
+    if (!QFileInfo(QFileInfo(snapshot.databasePath).absolutePath()).isWritable()) {
+        snapshot.snapshotFilePath = snapshot.databasePath;
+        return true;
+    }
+    const QString target = versionedPathFor(snapshot.databasePath, snapshot.fileStamp);
+    snapshot.snapshotFilePath = target;
+    if (QFileInfo::exists(target))
+        return true;
+
+    // VACUUM INTO reads one transaction, committed -wal content included, and
+    // writes a self-contained file; a plain copy could tear or miss the WAL
+    const QString partial = QString("%1.%2.tmp").arg(target).arg(QCoreApplication::applicationPid());
+    QFile::remove(partial);
+    bool written = false;
+    withConnection(QString("dataset-versioner-%1").arg(snapshot.version), snapshot.databasePath, false,
+                   [&](QSqlDatabase &db) {
+        QSqlQuery query(db);
+        written = SQLiteUtil::exec(query, "VACUUM INTO ?", { partial });
+        if (!written)
+            qWarning() << "[DatasetManager] Database could not be written to" << partial << ":"
+                       << query.lastError().text();
+    });
+    // The stamp is what the version is named after; a file that changed meanwhile may be newer
+    if (written && fileStampOf(snapshot.databasePath) != snapshot.fileStamp) {
+        qWarning() << "[DatasetManager]" << snapshot.databasePath << "changed while it was versioned";
+        written = false;
+    }
+    if (!written) {
+        QFile::remove(partial);
+        return false;
+    }
+
+    // The rename is atomic; it fails when another process published the same version first
+    if (!QFile::rename(partial, target)) {
+        QFile::remove(partial);
+        if (!QFileInfo::exists(target)) {
+            qWarning() << "[DatasetManager] Versioned file could not be created:" << target;
+            return false;
+        }
+    }
+    return true;
+}
+
+void DatasetManager::removeStaleFiles(const QString &path, const QString &keepFileStamp)
+{
+    // Versions of this database other than the kept one. Processes still
+    // reading one keep their open connections; where open files cannot be
+    // removed, the next sweep retries.
+    const QFileInfo database(path);
+    const QString keep = QFileInfo(versionedPathFor(path, keepFileStamp)).fileName();
+    const QDateTime abandoned = QDateTime::currentDateTime().addSecs(-3600);
+    const QFileInfoList versions = database.absoluteDir().entryInfoList(
+        { database.fileName() + ".*.version", database.fileName() + ".*.version.*.tmp" }, QDir::Files);
+    for (const QFileInfo &file : versions) {
+        if (file.fileName() == keep)
+            continue;
+        // Another process may still be writing a partial file; only crashed writers leave old ones
+        if (file.suffix() == "tmp" && file.lastModified() > abandoned)
+            continue;
+        if (QFile::remove(file.absoluteFilePath()))
+            qDebug() << "[DatasetManager] Removed stale version" << file.fileName();
+    }
+
+    // Private copies earlier releases took in the temporary directory
+    const QFileInfoList copies = QDir(QDir::tempPath()).entryInfoList({ "AcademyScope-*.sqlite" }, QDir::Files);
+    for (const QFileInfo &file : copies)
+        QFile::remove(file.absoluteFilePath());
+}
+
+void DatasetManager::buildIndexes(DatasetSnapshot &snapshot, const std::shared_ptr<const ProgramDataset> &dataset,
+                                  bool additional)
+{
+    warnAboutMissingColumns(*dataset);
+    auto scoreIndex = ScoreIndex::build(*dataset);
+    auto bitmapIndex = BitmapIndex::build(*dataset);
+    auto zoneMap = ZoneMap::build(*dataset);
+    if (additional) {
+        snapshot.additionalDataset = dataset;
+        snapshot.additionalScoreIndex = scoreIndex;
+        snapshot.additionalBitmapIndex = bitmapIndex;
+        snapshot.additionalZoneMap = zoneMap;
+    } else {
+        snapshot.regularDataset = dataset;
+        snapshot.regularScoreIndex = scoreIndex;
+        snapshot.regularBitmapIndex = bitmapIndex;
+        snapshot.regularZoneMap = zoneMap;
+    }
+}
+
+void DatasetManager::warnAboutMissingColumns(const ProgramDataset &dataset)
+{
+    QStringList columnNames;
+    for (int column = 0; column < dataset.columnCount(); ++column)
+        columnNames << dataset.columnName(column);
+    const QStringList missing = ProgramTableColumns::missingColumns(columnNames);
+    if (!missing.isEmpty())
+        qWarning() << "[DatasetManager]" << dataset.tableName() << "lacks schema columns:" << missing;
+}
+
+bool DatasetManager::publish(const std::shared_ptr<DatasetSnapshot> &snapshot)
+{
+    if (!snapshot)
+        return false;
+
+    // The publishing thread owns the snapshot's connection; opening is cheap,
+    // everything expensive was done by the loader.
+    snapshot->connectionName = QString("dataset-%1").arg(snapshot->version);
+    snapshot->connectionOwner = this;
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", snapshot->connectionName);
+    if (!SQLiteUtil::openImmutable(db, snapshot->snapshotFilePath)) {
+        qWarning() << "[DatasetManager] Snapshot connection could not be opened:" << db.lastError().text();
+        return false;
+    }
+    SQLiteUtil::configureConnection(db);
+
+    const qint64 rssBefore = MemoryUtil::residentSetSizeBytes();
+    std::atomic_store(&currentSnapshot, std::shared_ptr<const DatasetSnapshot>(snapshot));
+    qDebug() << "[DatasetManager] Published snapshot version" << snapshot->version
+             << "- dataset" << MemoryUtil::toMegabytes(snapshot->estimatedMemoryBytes()) << "MB,"
+             << "shared" << MemoryUtil::toMegabytes(snapshot->sharedBytes) << "MB,"
+             << "RSS" << MemoryUtil::toMegabytes(rssBefore) << "MB,"
+             << "live snapshots:" << DatasetSnapshot::liveSnapshotCount();
+
+    removeStaleFiles(snapshot->databasePath, snapshot->fileStamp);
+    emit snapshotPublished(snapshot->version);
+    return true;
+}
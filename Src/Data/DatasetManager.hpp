@@ -0,0 +1,86 @@
+/*
+DatasetManager class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <memory>
+#include "DatasetSnapshot.hpp"
+
+// How the datasets of a snapshot are shared between back-end processes on one host
+enum class SnapshotSharing {
+    Private, // every process loads its own copy from SQLite
+    Publish, // loads from SQLite and writes a SnapshotImage for the other processes
+    Attach   // maps the SnapshotImage, datasets and indexes, read-only; loads privately while it is missing or stale
+};
+
+// Owns the published DatasetSnapshot. The database file is watched; when it
+// changes, the new version is written once to a versioned file next to it
+// (see versionedPathFor), shared by every process of the host, and the next
+// snapshot is built from that file on a worker thread, then published with an atomic pointer swap. Readers call getCurrentSnapshot() without locking and
+// keep their snapshot alive for as long as they use it.
+class DatasetManager : public QObject {
+    Q_OBJECT
+signals:
+    void reloadStarted() const;
+    void snapshotPublished(int version) const;
+    void reloadFailed(const QString &reason) const;
+public:
+    explicit DatasetManager(QObject *parent = nullptr);
+    ~DatasetManager();
+
+    // Builds and publishes the first snapshot on the calling thread
+    bool loadInitial(const QString &databasePath);
+    // Builds the first snapshot on a worker thread; snapshotPublished or
+    // reloadFailed follows on this object's thread
+    void loadInitialAsync(const QString &databasePath);
+    void setWatchingEnabled(bool enabled);
+    // Takes effect from the next snapshot that is built
+    void setSnapshotSharing(SnapshotSharing sharing);
+    void reload();
+
+    std::shared_ptr<const DatasetSnapshot> getCurrentSnapshot() const;
+    static QString fileStampOf(const QString &databasePath);
+    // <database>.<file stamp>.version; read-only once written
+    static QString versionedPathFor(const QString &databasePath, const QString &fileStamp);
+
+private slots:
+    void onDatabaseFileChanged();
+    void onReloadFinished();
+
+private:
+    static std::shared_ptr<DatasetSnapshot> buildSnapshot(const QString &databasePath, int version,
+                                                          SnapshotSharing sharing);
+    static std::shared_ptr<DatasetSnapshot> attachSnapshot(const QString &databasePath, int version);
+    // Points the snapshot at the versioned file of its stamp, writing it when
+    // no process has yet; false when the watched file changed meanwhile
+    static bool openVersionedFile(DatasetSnapshot &snapshot);
+    // Removes versioned files of other stamps and partial ones left by a
+    // crash; on startup and after every publish
+    static void removeStaleFiles(const QString &databasePath, const QString &keepFileStamp);
+    // Score, bitmap and zone indexes of a dataset loaded from SQLite; an
+    // attached snapshot reads them from the SnapshotImage instead
+    static void buildIndexes(DatasetSnapshot &snapshot, const std::shared_ptr<const ProgramDataset> &dataset,
+                             bool additional);
+    // The model projects every stored schema column; name the ones a file lacks up front
+    static void warnAboutMissingColumns(const ProgramDataset &dataset);
+    bool publish(const std::shared_ptr<DatasetSnapshot> &snapshot);
+
+    std::shared_ptr<const DatasetSnapshot> currentSnapshot; // accessed with std::atomic_load/store only
+    QString databasePath;
+    int nextVersion = 1;
+    bool reloadPending = false;
+    SnapshotSharing snapshotSharing = SnapshotSharing::Private;
+    QFileSystemWatcher watcher;
+    QTimer debounceTimer;
+    QFutureWatcher<std::shared_ptr<DatasetSnapshot>> reloadWatcher;
+};
@@ -0,0 +1,142 @@
+/*
+DatasetSnapshot class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "DatasetSnapshot.hpp"
+#include <QDebug>
+#include <QThread>
+#include <atomic>
+#include "../Utils/MemoryUtil.hpp"
+
+namespace {
+std::atomic_int liveSnapshots{0};
+
+void releaseConnection(const QString &connectionName)
+{
+    if (connectionName.isEmpty())
+        return;
+    QSqlDatabase::database(connectionName, false).close();
+    QSqlDatabase::removeDatabase(connectionName);
+}
+}
+
+DatasetSnapshot::DatasetSnapshot(int version, const QString &databasePath, const QString &fileStamp)
+    : version(version), databasePath(databasePath), fileStamp(fileStamp)
+{
+    ++liveSnapshots;
+}
+
+DatasetSnapshot::~DatasetSnapshot()
+{
+    // The last reference may be dropped on any thread, but the connection may
+    // only be closed by the thread that opened it
+    QObject *owner = connectionOwner.data();
+    if (owner && owner->thread() != QThread::currentThread()) {
+        QMetaObject::invokeMethod(owner, [connectionName = connectionName]() {
+            releaseConnection(connectionName);
+        }, Qt::QueuedConnection);
+    } else {
+        releaseConnection(connectionName);
+    }
+    regularDataset.reset();
+    additionalDataset.reset();
+
+    const int remaining = --liveSnapshots;
+    qDebug() << "[DatasetSnapshot] Released version" << version << "- live snapshots:" << remaining
+             << "RSS:" << MemoryUtil::toMegabytes(MemoryUtil::residentSetSizeBytes()) << "MB";
+}
+
+int DatasetSnapshot::getVersion() const
+{
+    return version;
+}
+
+const QString &DatasetSnapshot::getDatabasePath() const
+{
+    return databasePath;
+}
+
+const QString &DatasetSnapshot::getFileStamp() const
+{
+    return fileStamp;
+}
+
+const QString &DatasetSnapshot::getSnapshotFilePath() const
+{
+    return snapshotFilePath;
+}
+
+QSqlDatabase DatasetSnapshot::getDatabase() const
+{
+    return QSqlDatabase::database(connectionName, false);
+}
+
+std::shared_ptr<const ProgramDataset> DatasetSnapshot::getDataset(PlacementType placementType) const
+{
+    return placementType == PlacementType::Additional ? additionalDataset : regularDataset;
+}
+
+std::shared_ptr<const ScoreIndex> DatasetSnapshot::getScoreIndex(PlacementType placementType) const
+{
+    return placementType == PlacementType::Additional ? additionalScoreIndex : regularScoreIndex;
+}
+
+std::shared_ptr<const BitmapIndex> DatasetSnapshot::getBitmapIndex(PlacementType placementType) const
+{
+    return placementType == PlacementType::Additional ? additionalBitmapIndex : regularBitmapIndex;
+}
+
+std::shared_ptr<const ZoneMap> DatasetSnapshot::getZoneMap(PlacementType placementType) const
+{
+    return placementType == PlacementType::Additional ? additionalZoneMap : regularZoneMap;
+}
+
+std::shared_ptr<const ProgramJoinIndex> DatasetSnapshot::getProgramJoinIndex() const
+{
+    return programJoinIndex;
+}
+
+const QList<University> &DatasetSnapshot::getUniversities() const
+{
+    return universities;
+}
+
+const QList<QString> &DatasetSnapshot::getDepartments() const
+{
+    return departments;
+}
+
+qint64 DatasetSnapshot::estimatedMemoryBytes() const
+{
+    qint64 bytes = sizeof(*this);
+    if (regularDataset) bytes += regularDataset->estimatedMemoryBytes();
+    if (additionalDataset) bytes += additionalDataset->estimatedMemoryBytes();
+    if (regularScoreIndex) bytes += regularScoreIndex->estimatedMemoryBytes();
+    if (additionalScoreIndex) bytes += additionalScoreIndex->estimatedMemoryBytes();
+    if (regularBitmapIndex) bytes += regularBitmapIndex->estimatedMemoryBytes();
+    if (additionalBitmapIndex) bytes += additionalBitmapIndex->estimatedMemoryBytes();
+    if (regularZoneMap) bytes += regularZoneMap->estimatedMemoryBytes();
+    if (additionalZoneMap) bytes += additionalZoneMap->estimatedMemoryBytes();
+    if (programJoinIndex) bytes += programJoinIndex->estimatedMemoryBytes();
+    for (const University &university : universities)
+        bytes += qint64(sizeof(University)) + university.name.capacity() * qint64(sizeof(QChar));
+    for (const QString &department : departments)
+        bytes += qint64(sizeof(QString)) + department.capacity() * qint64(sizeof(QChar));
+    return bytes;
+}
+
+qint64 DatasetSnapshot::getSharedBytes() const
+{
+    return sharedBytes;
+}
+
+int DatasetSnapshot::liveSnapshotCount()
+{
+    return liveSnapshots.load();
+}
@@ -0,0 +1,84 @@
+/*
+DatasetSnapshot class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QList>
+#include <QString>
+#include <QSqlDatabase>
+#include <QPointer>
+#include <QObject>
+#include <memory>
+#include "../DataTypeDefinitions.hpp"
+#include "ProgramDataset.hpp"
+#include "ScoreIndex.hpp"
+#include "BitmapIndex.hpp"
+#include "ZoneMap.hpp"
+#include "ProgramJoinIndex.hpp"
+
+// Everything derived from one version of the database file: the versioned
+// file of that version with its own SQLite connection, the in-memory datasets
+// and the lookup lists. Snapshots never change after they are published; whoever
+// holds one keeps reading that version, even after the file on disk has been
+// replaced or overwritten in place.
+class DatasetSnapshot
+{
+public:
+    DatasetSnapshot(int version, const QString &databasePath, const QString &fileStamp);
+    ~DatasetSnapshot();
+    DatasetSnapshot(const DatasetSnapshot &) = delete;
+    DatasetSnapshot &operator=(const DatasetSnapshot &) = delete;
+
+    int getVersion() const;
+    // The watched database file; see getSnapshotFilePath for what is actually read
+    const QString &getDatabasePath() const;
+    const QString &getFileStamp() const;
+    // Versioned file of the database (DatasetManager::versionedPathFor), shared
+    // with other processes; it never changes, so open it with SQLiteUtil::openImmutable
+    const QString &getSnapshotFilePath() const;
+
+    // Connection of the thread that published the snapshot (the GUI thread)
+    QSqlDatabase getDatabase() const;
+    std::shared_ptr<const ProgramDataset> getDataset(PlacementType placementType) const;
+    std::shared_ptr<const ScoreIndex> getScoreIndex(PlacementType placementType) const;
+    std::shared_ptr<const BitmapIndex> getBitmapIndex(PlacementType placementType) const;
+    std::shared_ptr<const ZoneMap> getZoneMap(PlacementType placementType) const;
+    // Null when the additional table could not be loaded
+    std::shared_ptr<const ProgramJoinIndex> getProgramJoinIndex() const;
+    const QList<University> &getUniversities() const;
+    const QList<QString> &getDepartments() const;
+
+    // Memory of this process only; see getSharedBytes for a mapped SnapshotImage
+    qint64 estimatedMemoryBytes() const;
+    // Size of the SnapshotImage the datasets are attached to, 0 when they were loaded privately
+    qint64 getSharedBytes() const;
+    static int liveSnapshotCount();
+
+private:
+    friend class DatasetManager;
+
+    int version;
+    QString databasePath;
+    QString fileStamp;
+    QString snapshotFilePath;
+    QString connectionName;
+    QPointer<QObject> connectionOwner; // lives on the thread that opened the connection
+    std::shared_ptr<const ProgramDataset> regularDataset;
+    std::shared_ptr<const ProgramDataset> additionalDataset;
+    std::shared_ptr<const ScoreIndex> regularScoreIndex;
+    std::shared_ptr<const ScoreIndex> additionalScoreIndex;
+    std::shared_ptr<const BitmapIndex> regularBitmapIndex;
+    std::shared_ptr<const BitmapIndex> additionalBitmapIndex;
+    std::shared_ptr<const ZoneMap> regularZoneMap;
+    std::shared_ptr<const ZoneMap> additionalZoneMap;
+    std::shared_ptr<const ProgramJoinIndex> programJoinIndex;
+    QList<University> universities;
+    QList<QString> departments;
+    qint64 sharedBytes = 0;
+};
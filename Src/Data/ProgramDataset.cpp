@@ -0,0 +1,300 @@
+/*
+ProgramDataset class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramDataset.hpp"
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlError>
+#include <QCollator>
+#include <QLocale>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include "../Utils/TurkishText.hpp"
+
+namespace {
+bool isNumericVariant(const QVariant &value)
+{
+    switch (value.typeId()) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Bool:
+    case QMetaType::Double:
+        return true;
+    default:
+        return false;
+    }
+}
+}
+
+std::shared_ptr<const ProgramDataset> ProgramDataset::load(const QSqlDatabase &db, const QString &tableName)
+{
+    if (!db.isOpen()) {
+        qWarning() << "[ProgramDataset] Database is not open!";
+        return nullptr;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec(QString("SELECT rowid, * FROM %1 ORDER BY ProgramKodu ASC").arg(tableName))) {
+        qWarning() << "[ProgramDataset] Load failed:" << query.lastError().text();
+        return nullptr;
+    }
+
+    auto dataset = std::make_shared<ProgramDataset>();
+    dataset->table = tableName;
+
+    const QSqlRecord record = query.record();
+    const int columnCount = record.count() - 1;
+    dataset->columns.resize(columnCount);
+    for (int i = 0; i < columnCount; ++i) {
+        dataset->columns[i].name = record.fieldName(i + 1);
+        dataset->columnIndexByName.insert(dataset->columns[i].name, i);
+    }
+
+    // Values are staged as variants first; SQLite is dynamically typed so a
+    // column's storage class is only known after every row has been seen.
+    QVector<QVector<QVariant>> staged(columnCount);
+    while (query.next()) {
+        dataset->rowIdStorage.append(query.value(0).toLongLong());
+        for (int i = 0; i < columnCount; ++i)
+            staged[i].append(query.value(i + 1));
+    }
+
+    const int rowCount = dataset->rowIdStorage.size();
+    dataset->rowIds = dataset->rowIdStorage;
+    dataset->rowsByRowIdStorage.resize(rowCount);
+    std::iota(dataset->rowsByRowIdStorage.begin(), dataset->rowsByRowIdStorage.end(), 0);
+    std::sort(dataset->rowsByRowIdStorage.begin(), dataset->rowsByRowIdStorage.end(),
+              [&](int a, int b) { return dataset->rowIdStorage[a] < dataset->rowIdStorage[b]; });
+    dataset->rowsByRowId = dataset->rowsByRowIdStorage;
+
+    for (int i = 0; i < columnCount; ++i) {
+        Column &column = dataset->columns[i];
+        const QVector<QVariant> &values = staged[i];
+
+        for (const QVariant &value : values) {
+            if (value.isNull())
+                continue;
+            if (!isNumericVariant(value))
+                column.isText = true;
+            else if (value.typeId() == QMetaType::Double)
+                column.isInteger = false;
+        }
+
+        if (column.isText) {
+            QHash<QString, quint32> codeByText;
+            column.codeStorage.resize(rowCount);
+            for (int row = 0; row < rowCount; ++row) {
+                if (values[row].isNull()) {
+                    column.codeStorage[row] = nullCode;
+                    continue;
+                }
+                const QString text = values[row].toString();
+                auto it = codeByText.constFind(text);
+                if (it == codeByText.constEnd()) {
+                    it = codeByText.insert(text, quint32(column.dictionary.size()));
+                    column.dictionary.append(text);
+                }
+                column.codeStorage[row] = it.value();
+            }
+            column.codes = column.codeStorage;
+            column.foldedDictionary.reserve(column.dictionary.size());
+            for (const QString &text : column.dictionary)
+                column.foldedDictionary.append(TurkishText::folded(text));
+        } else {
+            column.numberStorage.resize(rowCount);
+            for (int row = 0; row < rowCount; ++row)
+                column.numberStorage[row] = values[row].isNull()
+                                                ? std::numeric_limits<double>::quiet_NaN()
+                                                : values[row].toDouble();
+            column.numbers = column.numberStorage;
+        }
+        staged[i].clear();
+        staged[i].squeeze();
+
+        dataset->buildRanks(column);
+    }
+
+    qDebug() << "[ProgramDataset] Loaded" << tableName << rowCount << "rows in" << timer.elapsed() << "ms";
+    return dataset;
+}
+
+void ProgramDataset::buildRanks(Column &column) const
+{
+    const int rowCount = rowIds.size();
+    column.rankStorage.resize(rowCount);
+
+    if (column.isText) {
+        // Collate the dictionary once instead of every row
+        QVector<int> order(column.dictionary.size());
+        std::iota(order.begin(), order.end(), 0);
+        QCollator collator(QLocale(QLocale::Turkish, QLocale::Turkey));
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return collator.compare(column.dictionary[a], column.dictionary[b]) < 0;
+        });
+
+        QVector<quint32> rankByCode(column.dictionary.size());
+        quint32 rank = 0;
+        for (int i = 0; i < order.size(); ++i) {
+            if (i > 0 && collator.compare(column.dictionary[order[i - 1]], column.dictionary[order[i]]) != 0)
+                ++rank;
+            rankByCode[order[i]] = rank;
+        }
+        const quint32 nullRank = order.isEmpty() ? 0 : rank + 1;
+
+        for (int row = 0; row < rowCount; ++row) {
+            const quint32 code = column.codes[row];
+            column.rankStorage[row] = code == nullCode ? nullRank : rankByCode[code];
+        }
+        column.ranks = column.rankStorage;
+        column.rankCount = nullRank + 1;
+        return;
+    }
+
+    QVector<int> order(rowCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        const double x = column.numbers[a];
+        const double y = column.numbers[b];
+        if (std::isnan(x)) return false;
+        if (std::isnan(y)) return true;
+        return x < y;
+    });
+
+    // NULLs are ordered last and take the rank after the largest value, which
+    // is reserved even when the column has none
+    quint32 nullRank = 0;
+    for (int i = 0; i < rowCount; ++i) {
+        const double current = column.numbers[order[i]];
+        if (!std::isnan(current) && (i == 0 || current != column.numbers[order[i - 1]]))
+            ++nullRank;
+        column.rankStorage[order[i]] = std::isnan(current) ? nullRank : nullRank - 1;
+    }
+    column.ranks = column.rankStorage;
+    column.rankCount = nullRank + 1;
+}
+
+const QString &ProgramDataset::tableName() const
+{
+    return table;
+}
+
+int ProgramDataset::rowCount() const
+{
+    return rowIds.size();
+}
+
+int ProgramDataset::columnCount() const
+{
+    return columns.size();
+}
+
+int ProgramDataset::columnIndex(const QString &dbColumnName) const
+{
+    return columnIndexByName.value(dbColumnName, -1);
+}
+
+QString ProgramDataset::columnName(int column) const
+{
+    return columns[column].name;
+}
+
+bool ProgramDataset::isTextColumn(int column) const
+{
+    return columns[column].isText;
+}
+
+qint64 ProgramDataset::rowId(int row) const
+{
+    return rowIds[row];
+}
+
+int ProgramDataset::rowIndexOfRowId(qint64 rowId) const
+{
+    const auto it = std::lower_bound(rowsByRowId.begin(), rowsByRowId.end(), rowId,
+                                     [this](int row, qint64 value) { return rowIds[row] < value; });
+    return it != rowsByRowId.end() && rowIds[*it] == rowId ? *it : -1;
+}
+
+double ProgramDataset::number(int column, int row) const
+{
+    const Column &c = columns[column];
+    return c.isText ? std::numeric_limits<double>::quiet_NaN() : c.numbers[row];
+}
+
+QStringView ProgramDataset::text(int column, int row) const
+{
+    const Column &c = columns[column];
+    if (!c.isText || c.codes[row] == nullCode)
+        return {};
+    return c.dictionary[c.codes[row]];
+}
+
+QStringView ProgramDataset::foldedText(int column, int row) const
+{
+    const Column &c = columns[column];
+    if (!c.isText || c.codes[row] == nullCode)
+        return {};
+    return c.foldedDictionary[c.codes[row]];
+}
+
+QVariant ProgramDataset::value(int row, int column) const
+{
+    const Column &c = columns[column];
+    if (c.isText) {
+        if (c.codes[row] == nullCode)
+            return {};
+        // Deep copy: an attached dictionary entry points into the snapshot image,
+        // and the value may outlive the dataset
+        const QString &entry = c.dictionary[c.codes[row]];
+        return QVariant(QString(entry.constData(), entry.size()));
+    }
+
+    const double number = c.numbers[row];
+    if (std::isnan(number))
+        return {};
+    return c.isInteger ? QVariant(qlonglong(number)) : QVariant(number);
+}
+
+ColumnArray<quint32> ProgramDataset::ranks(int column) const
+{
+    return columns[column].ranks;
+}
+
+quint32 ProgramDataset::rankCount(int column) const
+{
+    return columns[column].rankCount;
+}
+
+qint64 ProgramDataset::estimatedMemoryBytes() const
+{
+    qint64 bytes = sizeof(*this)
+                   + rowIdStorage.capacity() * qint64(sizeof(qint64))
+                   + rowsByRowIdStorage.capacity() * qint64(sizeof(int));
+    for (const Column &column : columns) {
+        bytes += column.numberStorage.capacity() * qint64(sizeof(double))
+                 + column.codeStorage.capacity() * qint64(sizeof(quint32))
+                 + column.rankStorage.capacity() * qint64(sizeof(quint32));
+        for (const QString &text : column.dictionary)
+            bytes += qint64(sizeof(QString)) + text.capacity() * qint64(sizeof(QChar));
+        for (const QString &text : column.foldedDictionary)
+            bytes += qint64(sizeof(QString)) + text.capacity() * qint64(sizeof(QChar));
+    }
+    return bytes;
+}
@@ -0,0 +1,90 @@
+/*
+ProgramDataset class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QString>
+#include <QStringView>
+#include <QVector>
+#include <QHash>
+#include <QVariant>
+#include <QSqlDatabase>
+#include <memory>
+#include "ColumnArray.hpp"
+
+// Immutable, column-oriented copy of a program table (YKS or EkTercihDetayli).
+// Rows are stored in ProgramKodu order. Text columns are dictionary encoded and
+// every column carries a precomputed rank array, so re-sorting a set of rows
+// never has to go back to SQLite. A dataset attached from a SnapshotImage
+// reads all of this straight from the mapped file.
+class ProgramDataset {
+public:
+    static constexpr quint32 nullCode = 0xFFFFFFFFu;
+
+    static std::shared_ptr<const ProgramDataset> load(const QSqlDatabase &db, const QString &tableName);
+
+    const QString &tableName() const;
+    int rowCount() const;
+    int columnCount() const;
+    int columnIndex(const QString &dbColumnName) const;
+    QString columnName(int column) const;
+    bool isTextColumn(int column) const;
+
+    qint64 rowId(int row) const;
+    int rowIndexOfRowId(qint64 rowId) const;
+
+    // NaN when the cell is NULL or the column is a text column
+    double number(int column, int row) const;
+    // Empty view when the cell is NULL or the column is numeric
+    QStringView text(int column, int row) const;
+    // text() in TurkishText's folded form, computed once per dictionary entry
+    QStringView foldedText(int column, int row) const;
+    // Text values own their characters, also when the dataset is attached to an image
+    QVariant value(int row, int column) const;
+
+    // Dense ranks (Turkish collation for text, numeric order otherwise).
+    // Equal values share a rank; rankCount() is one past the largest rank,
+    // and that largest rank, rankCount() - 1, is always reserved for NULL.
+    ColumnArray<quint32> ranks(int column) const;
+    quint32 rankCount(int column) const;
+
+    // Memory of this process only; mapped image pages are shared and not counted
+    qint64 estimatedMemoryBytes() const;
+
+private:
+    friend class SnapshotImage;
+
+    struct Column {
+        QString name;
+        bool isText = false;
+        bool isInteger = true;
+        ColumnArray<double> numbers;
+        ColumnArray<quint32> codes;
+        ColumnArray<quint32> ranks;
+        // Attached dictionaries wrap the mapped characters (QString::fromRawData)
+        QVector<QString> dictionary;
+        QVector<QString> foldedDictionary;
+        quint32 rankCount = 0;
+        // Backing of the arrays above for a dataset loaded from SQLite
+        QVector<double> numberStorage;
+        QVector<quint32> codeStorage;
+        QVector<quint32> rankStorage;
+    };
+
+    void buildRanks(Column &column) const;
+
+    QString table;
+    ColumnArray<qint64> rowIds;
+    ColumnArray<int> rowsByRowId; // rows in ascending rowid order, for rowIndexOfRowId
+    QVector<Column> columns;
+    QHash<QString, int> columnIndexByName;
+    QVector<qint64> rowIdStorage;
+    QVector<int> rowsByRowIdStorage;
+    std::shared_ptr<const void> image; // keeps an attached image mapped
+};
@@ -0,0 +1,297 @@
+/*
+ProgramFilter class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramFilter.hpp"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include "DatasetSnapshot.hpp"
+#include "../ParametersJson.hpp"
+#include "../Utils/TurkishText.hpp"
+
+ProgramFilter::ProgramFilter(const ProgramDataset &dataset, const AcademyScopeParameters &parameters)
+    : dataset(dataset), parameters(parameters)
+{
+    universityNameColumn = dataset.columnIndex("UniversiteAdi");
+    programNameColumn    = dataset.columnIndex("ProgramAdi");
+    countryCodeColumn    = dataset.columnIndex("UlkeKodu");
+    bachelorColumn       = dataset.columnIndex("Lisans");
+    governmentColumn     = dataset.columnIndex("DevletUniversitesi");
+    trackColumn          = dataset.columnIndex("PuanTuru");
+    minScoreColumn       = dataset.columnIndex("GenelEnKucukPuan");
+    maxScoreColumn       = dataset.columnIndex("GenelEnBuyukPuan");
+    trncColumn           = dataset.columnIndex("KKTCUyruklu");
+    mtokColumn           = dataset.columnIndex("MTOK");
+    tuitionColumn        = dataset.columnIndex("UcretDurumu");
+
+    // Folded like QueryBuilder's bind values, whose SQL folds the column with
+    // tr_fold; both paths match the same names, İ/ı mismatches included
+    if (!parameters.universityName.trimmed().isEmpty())
+        universityPattern = TurkishText::folded(parameters.universityName);
+    if (!parameters.departmentName.trimmed().isEmpty())
+        departmentPattern = TurkishText::folded(TurkishText::title(parameters.departmentName));
+    trackName = trackNameOf(parameters.trackType);
+
+    // Same bounds as the SQL score range
+    const double minScore = parameters.scoreInterval.minimum.value_or(0);
+    const double maxScore = parameters.scoreInterval.maximum.value_or(0);
+    if (minScore > 100) scoreAbove = minScore;
+    if (maxScore < 560) scoreBelow = maxScore;
+
+    const SelectedQuotaTypes &quotas = parameters.selectedQuotaTypes;
+    if (quotas.regularQuota)                  quotaPresenceColumns << dataset.columnIndex("GenelKontenjan");
+    if (quotas.highSchoolValedictoriansQuota) quotaPresenceColumns << dataset.columnIndex("OkulBirincisiKontenjan");
+    if (quotas.martyrsAndVeteransQuota)       quotaPresenceColumns << dataset.columnIndex("SehitGaziKontenjan");
+    if (quotas.earthquakeVictimsQuota)        quotaPresenceColumns << dataset.columnIndex("DepremzedeKontenjan");
+    if (quotas.women34PlusQuota)              quotaPresenceColumns << dataset.columnIndex("Kadin34Kontenjan");
+
+    // A range only applies while its quota type is selected, as in the SQL
+    auto addRange = [&](bool selected, const QString &column, const Interval &interval, bool onlyForTrnc) {
+        if (selected && (interval.minimum.has_value() || interval.maximum.has_value()))
+            quotaRanges << Range{dataset.columnIndex(column), interval.minimum, interval.maximum, onlyForTrnc};
+    };
+    addRange(quotas.regularQuota,                  "GenelKontenjan",         parameters.regularQuotaInterval, false);
+    addRange(quotas.highSchoolValedictoriansQuota, "OkulBirincisiKontenjan", parameters.highSchoolValedictoriansQuotaInterval, false);
+    addRange(quotas.women34PlusQuota,              "Kadin34Kontenjan",       parameters.women34PlusQuotaInterval, false);
+    addRange(quotas.earthquakeVictimsQuota,        "DepremzedeKontenjan",    parameters.earthquakeVictimsQuotaInterval, false);
+    addRange(quotas.martyrsAndVeteransQuota,       "SehitGaziKontenjan",     parameters.martyrsAndVeteransQuotaInterval, false);
+    addRange(quotas.trncNationalsQuota,            "GenelKontenjan",         parameters.trncNationalsQuotaInterval, true);
+
+    if (parameters.selectedTuitionFeeTypes.free)       tuitionValues << 0;
+    if (parameters.selectedTuitionFeeTypes.discounted) tuitionValues << 50;
+    if (parameters.selectedTuitionFeeTypes.paid)       tuitionValues << 100;
+}
+
+bool ProgramFilter::equals(int column, int row, double value) const
+{
+    return column >= 0 && dataset.number(column, row) == value;
+}
+
+bool ProgramFilter::isNotNull(int column, int row) const
+{
+    if (column < 0)
+        return false;
+    return dataset.isTextColumn(column) ? !dataset.text(column, row).isNull()
+                                        : !std::isnan(dataset.number(column, row));
+}
+
+bool ProgramFilter::inRange(const Range &range, int row) const
+{
+    // SQL: (KKTCUyruklu = FALSE OR (range)); a NULL KKTCUyruklu must pass the range
+    if (range.onlyForTrnc && equals(trncColumn, row, 0))
+        return true;
+    if (range.column < 0)
+        return false;
+    const double value = dataset.number(range.column, row);
+    if (std::isnan(value))
+        return false;
+    if (range.minimum.has_value() && value < *range.minimum)
+        return false;
+    if (range.maximum.has_value() && value > *range.maximum)
+        return false;
+    return true;
+}
+
+bool ProgramFilter::matches(int row) const
+{
+    return matchesCategorical(row) && matchesResidual(row);
+}
+
+bool ProgramFilter::matchesCategorical(int row) const
+{
+    switch (parameters.country) {
+    case Country::Turkiye:
+        if (!equals(countryCodeColumn, row, 90)) return false;
+        break;
+    case Country::Cyprus:
+        if (!equals(countryCodeColumn, row, 357)) return false;
+        break;
+    case Country::ForeignCountries:
+        if (!isNotNull(countryCodeColumn, row) || equals(countryCodeColumn, row, 90)
+            || equals(countryCodeColumn, row, 357))
+            return false;
+        break;
+    case Country::AllCountries:
+        break;
+    }
+
+    if (parameters.degreeType == DegreeType::Bachelor && !equals(bachelorColumn, row, 1)) return false;
+    if (parameters.degreeType == DegreeType::Associate && !equals(bachelorColumn, row, 0)) return false;
+
+    if (parameters.universityType == UniversityType::Government && !equals(governmentColumn, row, 1)) return false;
+    if (parameters.universityType == UniversityType::Private && !equals(governmentColumn, row, 0)) return false;
+
+    if (!trackName.isEmpty() && (trackColumn < 0 || dataset.text(trackColumn, row) != trackName))
+        return false;
+
+    const SelectedQuotaTypes &quotas = parameters.selectedQuotaTypes;
+    if (!quotas.trncNationalsQuota && !equals(trncColumn, row, 0)) return false;
+    if (!quotas.mtokQuota && !equals(mtokColumn, row, 0)) return false;
+
+    if (!quotaPresenceColumns.isEmpty() || quotas.trncNationalsQuota || quotas.mtokQuota) {
+        bool anyQuota = (quotas.trncNationalsQuota && equals(trncColumn, row, 1))
+                        || (quotas.mtokQuota && equals(mtokColumn, row, 1));
+        for (int i = 0; !anyQuota && i < quotaPresenceColumns.size(); ++i)
+            anyQuota = isNotNull(quotaPresenceColumns[i], row);
+        if (!anyQuota)
+            return false;
+    }
+
+    if (!tuitionValues.isEmpty()) {
+        if (tuitionColumn < 0)
+            return false;
+        const double tuition = dataset.number(tuitionColumn, row);
+        if (!tuitionValues.contains(tuition))
+            return false;
+    }
+
+    return true;
+}
+
+bool ProgramFilter::matchesResidual(int row) const
+{
+    if (!universityPattern.isEmpty()
+        && (universityNameColumn < 0
+            || !dataset.foldedText(universityNameColumn, row).contains(universityPattern)))
+        return false;
+
+    if (!departmentPattern.isEmpty()
+        && (programNameColumn < 0
+            || !dataset.foldedText(programNameColumn, row).contains(departmentPattern)))
+        return false;
+
+    if (scoreAbove.has_value()) {
+        const double score = minScoreColumn < 0 ? NAN : dataset.number(minScoreColumn, row);
+        if (!(score > *scoreAbove))
+            return false;
+    }
+    if (scoreBelow.has_value()) {
+        const double score = maxScoreColumn < 0 ? NAN : dataset.number(maxScoreColumn, row);
+        if (!(score < *scoreBelow))
+            return false;
+    }
+
+    for (const Range &range : quotaRanges)
+        if (!inRange(range, row))
+            return false;
+
+    return true;
+}
+
+bool ProgramFilter::hasResidualPredicates() const
+{
+    return !universityPattern.isEmpty() || !departmentPattern.isEmpty()
+           || scoreAbove.has_value() || scoreBelow.has_value() || !quotaRanges.isEmpty();
+}
+
+QVector<int> ProgramFilter::filterRows() const
+{
+    QVector<int> rows;
+    for (int row = 0; row < dataset.rowCount(); ++row)
+        if (matches(row))
+            rows.append(row);
+    return rows;
+}
+
+QVector<int> ProgramFilter::filterRows(const QVector<int> &candidateRows, bool categoricalAlreadyApplied) const
+{
+    if (categoricalAlreadyApplied && !hasResidualPredicates())
+        return candidateRows;
+
+    QVector<int> rows;
+    for (int row : candidateRows)
+        if ((categoricalAlreadyApplied || matchesCategorical(row)) && matchesResidual(row))
+            rows.append(row);
+    return rows;
+}
+
+QVector<int> ProgramFilter::filterRows(const DatasetSnapshot &snapshot, const AcademyScopeParameters &parameters)
+{
+    const std::shared_ptr<const ProgramDataset> dataset = snapshot.getDataset(parameters.placementType);
+    if (!dataset)
+        return {};
+    const ProgramFilter filter(*dataset, parameters);
+
+    // Blocks whose min/max cannot satisfy the score or quota ranges are never touched
+    const QVector<ZoneMap::Range> ranges = filter.getPrunableRanges();
+    const std::shared_ptr<const ZoneMap> zoneMap = snapshot.getZoneMap(parameters.placementType);
+    const bool pruned = zoneMap && !ranges.isEmpty();
+    const QVector<int> zoneRows = pruned ? zoneMap->candidateRows(ranges) : QVector<int>();
+
+    const std::shared_ptr<const BitmapIndex> bitmapIndex = snapshot.getBitmapIndex(parameters.placementType);
+    if (!bitmapIndex)
+        return pruned ? filter.filterRows(zoneRows, false) : filter.filterRows();
+
+    const QVector<int> categoricalRows = bitmapIndex->evaluateCategorical(parameters).toRows();
+    if (!pruned)
+        return filter.filterRows(categoricalRows, true);
+    QVector<int> candidates;
+    std::set_intersection(categoricalRows.cbegin(), categoricalRows.cend(),
+                          zoneRows.cbegin(), zoneRows.cend(), std::back_inserter(candidates));
+    return filter.filterRows(candidates, true);
+}
+
+QVector<ZoneMap::Range> ProgramFilter::getPrunableRanges() const
+{
+    QVector<ZoneMap::Range> ranges;
+    if (scoreAbove.has_value())
+        ranges << ZoneMap::Range{minScoreColumn, scoreAbove, std::nullopt};
+    if (scoreBelow.has_value())
+        ranges << ZoneMap::Range{maxScoreColumn, std::nullopt, scoreBelow};
+    for (const Range &range : quotaRanges)
+        if (!range.onlyForTrnc)
+            ranges << ZoneMap::Range{range.column, range.minimum, range.maximum};
+    return ranges;
+}
+
+QString ProgramFilter::trackNameOf(TrackType trackType)
+{
+    switch (trackType) {
+    case TrackType::Science:     return "SAY";
+    case TrackType::EqualWeight: return "EA";
+    case TrackType::Humanities:  return "SÖZ";
+    case TrackType::TYT:         return "TYT";
+    case TrackType::Language:    return "DİL";
+    case TrackType::Undefined:   break;
+    }
+    return {};
+}
+
+QString ProgramFilter::filterKey(const AcademyScopeParameters &parameters)
+{
+    QJsonObject object = ParametersJson::toJson(parameters);
+    object.remove("order");
+    object.remove("topK");
+    return QString::fromUtf8(QJsonDocument(object).toJson(QJsonDocument::Compact));
+}
+
+QString ProgramFilter::categoricalKey(const AcademyScopeParameters &parameters)
+{
+    const SelectedQuotaTypes &quotas = parameters.selectedQuotaTypes;
+    const SelectedTuitionFeeTypes &tuition = parameters.selectedTuitionFeeTypes;
+    return QString("%1|%2|%3|%4|%5|%6%7%8%9%10%11%12|%13%14%15")
+        .arg(int(parameters.placementType))
+        .arg(int(parameters.country))
+        .arg(int(parameters.degreeType))
+        .arg(int(parameters.universityType))
+        .arg(int(parameters.trackType))
+        .arg(int(quotas.regularQuota))
+        .arg(int(quotas.martyrsAndVeteransQuota))
+        .arg(int(quotas.earthquakeVictimsQuota))
+        .arg(int(quotas.highSchoolValedictoriansQuota))
+        .arg(int(quotas.women34PlusQuota))
+        .arg(int(quotas.trncNationalsQuota))
+        .arg(int(quotas.mtokQuota))
+        .arg(int(tuition.free))
+        .arg(int(tuition.discounted))
+        .arg(int(tuition.paid));
+}
@@ -0,0 +1,80 @@
+/*
+ProgramFilter class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QString>
+#include <QVector>
+#include "../DataTypeDefinitions.hpp"
+#include "ProgramDataset.hpp"
+#include "ZoneMap.hpp"
+
+class DatasetSnapshot;
+
+// In-memory counterpart of QueryBuilder::buildFilterSql. The predicates are
+// split in two: the categorical part (country, degree, university type, track,
+// quota presence, tuition) that many parameter sets share, and the residual
+// part (name matches, score bounds, quota ranges) that is checked per row.
+class ProgramFilter
+{
+public:
+    ProgramFilter(const ProgramDataset &dataset, const AcademyScopeParameters &parameters);
+
+    bool matches(int row) const;
+    bool matchesCategorical(int row) const;
+    bool matchesResidual(int row) const;
+    bool hasResidualPredicates() const;
+
+    // Rows of the dataset passing the filter, in dataset (ProgramKodu) order
+    QVector<int> filterRows() const;
+    QVector<int> filterRows(const QVector<int> &candidateRows, bool categoricalAlreadyApplied) const;
+    // Same for the snapshot's dataset of the placement type: the categorical
+    // part is answered by its BitmapIndex and the ranges prune ZoneMap blocks
+    // before the per-row check; empty without a dataset
+    static QVector<int> filterRows(const DatasetSnapshot &snapshot, const AcademyScopeParameters &parameters);
+
+    // Residual range predicates a ZoneMap can prune blocks with (score bounds
+    // and quota ranges; the TRNC range also admits non-TRNC rows and is left out)
+    QVector<ZoneMap::Range> getPrunableRanges() const;
+
+    // PuanTuru value of a track; empty for TrackType::Undefined
+    static QString trackNameOf(TrackType trackType);
+    // Equal keys mean equal categorical predicates
+    static QString categoricalKey(const AcademyScopeParameters &parameters);
+    // Equal keys mean equal filters; order and top-k are left out
+    static QString filterKey(const AcademyScopeParameters &parameters);
+
+private:
+    struct Range {
+        int column = -1;
+        std::optional<double> minimum;
+        std::optional<double> maximum;
+        bool onlyForTrnc = false;
+    };
+
+    bool equals(int column, int row, double value) const;
+    bool isNotNull(int column, int row) const;
+    bool inRange(const Range &range, int row) const;
+
+    const ProgramDataset &dataset;
+    AcademyScopeParameters parameters;
+
+    int universityNameColumn, programNameColumn, countryCodeColumn, bachelorColumn,
+        governmentColumn, trackColumn, minScoreColumn, maxScoreColumn, trncColumn,
+        mtokColumn, tuitionColumn;
+    QVector<int> quotaPresenceColumns;
+    QVector<Range> quotaRanges;
+
+    QString universityPattern;  // both folded, matched against ProgramDataset::foldedText
+    QString departmentPattern;
+    QString trackName;
+    std::optional<double> scoreAbove;
+    std::optional<double> scoreBelow;
+    QVector<double> tuitionValues;
+};
@@ -0,0 +1,116 @@
+/*
+ProgramJoinIndex class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramJoinIndex.hpp"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+std::shared_ptr<const ProgramJoinIndex> ProgramJoinIndex::build(const ProgramDataset &regular,
+                                                                const ProgramDataset &additional)
+{
+    auto index = std::make_shared<ProgramJoinIndex>();
+    QVector<Pair> &pairs = index->pairStorage;
+    QVector<int> &pairIndexByRegularRow = index->pairIndexByRegularRowStorage;
+    QVector<int> &pairIndexByAdditionalRow = index->pairIndexByAdditionalRowStorage;
+    QVector<int> &pairIndexesByProgramCode = index->pairIndexesByProgramCodeStorage;
+    pairIndexByRegularRow.fill(-1, regular.rowCount());
+    pairIndexByAdditionalRow.fill(-1, additional.rowCount());
+    auto publishViews = [&index]() {
+        index->pairs = index->pairStorage;
+        index->pairIndexesByProgramCode = index->pairIndexesByProgramCodeStorage;
+        index->pairIndexByRegularRow = index->pairIndexByRegularRowStorage;
+        index->pairIndexByAdditionalRow = index->pairIndexByAdditionalRowStorage;
+    };
+
+    const int regularCodeColumn = regular.columnIndex("ProgramKodu");
+    const int additionalCodeColumn = additional.columnIndex("ProgramKodu");
+    if (regularCodeColumn < 0 || additionalCodeColumn < 0) {
+        qWarning() << "[ProgramJoinIndex] ProgramKodu column is missing";
+        publishViews();
+        return index;
+    }
+
+    auto codeAt = [](const ProgramDataset &dataset, int column, int row) {
+        const double code = dataset.number(column, row);
+        return std::isnan(code) ? -1 : qint64(code);
+    };
+
+    pairs.reserve(std::max(regular.rowCount(), additional.rowCount()));
+    int r = 0, a = 0;
+    while (r < regular.rowCount() || a < additional.rowCount()) {
+        const qint64 regularCode = r < regular.rowCount() ? codeAt(regular, regularCodeColumn, r) : -1;
+        const qint64 additionalCode = a < additional.rowCount() ? codeAt(additional, additionalCodeColumn, a) : -1;
+
+        Pair pair;
+        if (a == additional.rowCount() || (r < regular.rowCount() && regularCode < additionalCode)) {
+            pair = Pair{regularCode, r++, -1};
+        } else if (r == regular.rowCount() || additionalCode < regularCode) {
+            pair = Pair{additionalCode, -1, a++};
+        } else {
+            pair = Pair{regularCode, r++, a++};
+        }
+        // Rows without a ProgramKodu cannot be joined; they stay one-sided
+        if (pair.programCode < 0) {
+            if (pair.regularRow >= 0 && pair.additionalRow >= 0) {
+                pairs.append(Pair{-1, pair.regularRow, -1});
+                pair.regularRow = -1;
+            }
+        } else {
+            pairIndexesByProgramCode.append(pairs.size());
+        }
+        pairs.append(pair);
+    }
+    // Already ascending unless a dataset is out of ProgramKodu order
+    std::stable_sort(pairIndexesByProgramCode.begin(), pairIndexesByProgramCode.end(), [&pairs](int x, int y) {
+        return pairs[x].programCode < pairs[y].programCode;
+    });
+
+    for (int i = 0; i < pairs.size(); ++i) {
+        const Pair &pair = pairs[i];
+        if (pair.regularRow >= 0)
+            pairIndexByRegularRow[pair.regularRow] = i;
+        if (pair.additionalRow >= 0)
+            pairIndexByAdditionalRow[pair.additionalRow] = i;
+    }
+    publishViews();
+    return index;
+}
+
+int ProgramJoinIndex::pairCount() const
+{
+    return pairs.size();
+}
+
+const ProgramJoinIndex::Pair &ProgramJoinIndex::pair(int index) const
+{
+    return pairs[index];
+}
+
+int ProgramJoinIndex::pairIndexOfProgramCode(qint64 programCode) const
+{
+    const int *it = std::lower_bound(pairIndexesByProgramCode.begin(), pairIndexesByProgramCode.end(), programCode,
+                                     [this](int pairIndex, qint64 code) { return pairs[pairIndex].programCode < code; });
+    return it != pairIndexesByProgramCode.end() && pairs[*it].programCode == programCode ? *it : -1;
+}
+
+int ProgramJoinIndex::pairIndexOfRow(PlacementType side, int row) const
+{
+    const ColumnArray<int> &pairIndexes = side == PlacementType::Additional ? pairIndexByAdditionalRow
+                                                                            : pairIndexByRegularRow;
+    return row >= 0 && row < pairIndexes.size() ? pairIndexes[row] : -1;
+}
+
+qint64 ProgramJoinIndex::estimatedMemoryBytes() const
+{
+    return sizeof(*this) + pairStorage.capacity() * qint64(sizeof(Pair))
+           + (pairIndexesByProgramCodeStorage.capacity() + pairIndexByRegularRowStorage.capacity()
+              + pairIndexByAdditionalRowStorage.capacity()) * qint64(sizeof(int));
+}
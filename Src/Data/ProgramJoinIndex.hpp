@@ -0,0 +1,54 @@
+/*
+ProgramJoinIndex class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QVector>
+#include <memory>
+#include "../DataTypeDefinitions.hpp"
+#include "ProgramDataset.hpp"
+
+// ProgramKodu join of the regular (YKS) and additional (EkTercihDetayli)
+// datasets. Both are stored in ProgramKodu order, so the pairs come from one
+// merge pass and are themselves in ProgramKodu order. An attached index reads
+// its arrays from the mapped SnapshotImage.
+class ProgramJoinIndex
+{
+public:
+    struct Pair {
+        qint64 programCode = 0;
+        int regularRow = -1;    // -1 when the program has no regular placement
+        int additionalRow = -1; // -1 when the program has no additional placement
+    };
+
+    static std::shared_ptr<const ProgramJoinIndex> build(const ProgramDataset &regular, const ProgramDataset &additional);
+
+    int pairCount() const;
+    const Pair &pair(int index) const;
+    // -1 when the program is in neither table
+    int pairIndexOfProgramCode(qint64 programCode) const;
+    int pairIndexOfRow(PlacementType side, int row) const;
+
+    // Memory of this process only; mapped image pages are shared and not counted
+    qint64 estimatedMemoryBytes() const;
+
+private:
+    friend class SnapshotImage;
+
+    ColumnArray<Pair> pairs;
+    ColumnArray<int> pairIndexesByProgramCode; // pairs with a ProgramKodu, ascending by it
+    ColumnArray<int> pairIndexByRegularRow;
+    ColumnArray<int> pairIndexByAdditionalRow;
+    // Backing of the arrays above for an index built in this process
+    QVector<Pair> pairStorage;
+    QVector<int> pairIndexesByProgramCodeStorage;
+    QVector<int> pairIndexByRegularRowStorage;
+    QVector<int> pairIndexByAdditionalRowStorage;
+    std::shared_ptr<const void> image; // keeps an attached image mapped
+};
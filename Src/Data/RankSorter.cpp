@@ -0,0 +1,87 @@
+/*
+RankSorter class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "RankSorter.hpp"
+#include <algorithm>
+#include <array>
+
+namespace {
+// The last rank belongs to NULL and stays last in both directions
+quint32 orderedRank(quint32 rank, quint32 lastRank, bool descending)
+{
+    return descending && rank != lastRank ? lastRank - 1 - rank : rank;
+}
+}
+
+void RankSorter::sortRows(QVector<int> &rows, const QVector<Key> &keys)
+{
+    for (auto key = keys.crbegin(); key != keys.crend(); ++key)
+        sortRows(rows, key->ranks, key->rankCount, key->descending);
+}
+
+void RankSorter::selectTopRows(QVector<int> &rows, const QVector<Key> &keys, int k)
+{
+    k = std::max(0, std::min<int>(k, rows.size()));
+    auto before = [&keys](int a, int b) {
+        for (const Key &key : keys) {
+            const quint32 lastRank = key.rankCount - 1;
+            const quint32 x = orderedRank(key.ranks[a], lastRank, key.descending);
+            const quint32 y = orderedRank(key.ranks[b], lastRank, key.descending);
+            if (x != y)
+                return x < y;
+        }
+        return a < b;
+    };
+    std::partial_sort(rows.begin(), rows.begin() + k, rows.end(), before);
+    rows.resize(k);
+}
+
+void RankSorter::sortRows(QVector<int> &rows, ColumnArray<quint32> ranks, quint32 rankCount, bool descending)
+{
+    if (rows.size() < 2 || rankCount < 2)
+        return;
+
+    constexpr int digitBits = 11;
+    constexpr quint32 digitMask = (1u << digitBits) - 1;
+
+    int passes = 0;
+    for (quint32 remaining = rankCount - 1; remaining != 0; remaining >>= digitBits)
+        ++passes;
+
+    const quint32 lastRank = rankCount - 1;
+    auto rankOf = [&](int row) { return orderedRank(ranks[row], lastRank, descending); };
+
+    QVector<int> buffer(rows.size());
+    QVector<int> *source = &rows;
+    QVector<int> *target = &buffer;
+
+    for (int pass = 0; pass < passes; ++pass) {
+        const int shift = pass * digitBits;
+        std::array<int, digitMask + 1> offsets{};
+
+        for (int row : *source)
+            ++offsets[(rankOf(row) >> shift) & digitMask];
+
+        int sum = 0;
+        for (int &offset : offsets) {
+            const int count = offset;
+            offset = sum;
+            sum += count;
+        }
+
+        for (int row : *source)
+            (*target)[offsets[(rankOf(row) >> shift) & digitMask]++] = row;
+
+        std::swap(source, target);
+    }
+
+    if (source != &rows)
+        rows = std::move(*source);
+}
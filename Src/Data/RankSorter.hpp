@@ -0,0 +1,34 @@
+/*
+RankSorter class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QVector>
+#include "ColumnArray.hpp"
+
+// Reorders dataset row indexes by a precomputed rank array. The sort is a
+// stable LSD radix sort, so rows with equal ranks keep their incoming order.
+// The last rank of a key is NULL's and sorts last whichever the direction.
+class RankSorter
+{
+public:
+    struct Key {
+        ColumnArray<quint32> ranks;
+        quint32 rankCount = 0;
+        bool descending = false;
+    };
+
+    static void sortRows(QVector<int> &rows, ColumnArray<quint32> ranks, quint32 rankCount, bool descending = false);
+    // Keys in priority order; sorted least significant first so every key stays stable
+    static void sortRows(QVector<int> &rows, const QVector<Key> &keys);
+    // Keeps only the first k rows of what sortRows would produce for rows in
+    // ascending index order. A bounded partial sort: O(n log k) instead of
+    // ordering every row.
+    static void selectTopRows(QVector<int> &rows, const QVector<Key> &keys, int k);
+};
@@ -0,0 +1,452 @@
+/*
+ResultCache class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ResultCache.hpp"
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include "ProgramFilter.hpp"
+#include "RankSorter.hpp"
+#include "../ParametersJson.hpp"
+#include "../QueryBuilder.hpp"
+
+// File layout, little-endian:
+//   header     "ASRC", format version, entry count, stamp size (4 x 32 bit),
+//              stamp bytes padded to 8
+//   directory  one 32-byte record per entry, sorted by key:
+//              key (64), data offset (64), code count, result count, hits, JSON size (32 each)
+//   data       per entry: canonical parameter JSON padded to 8, then the ProgramKodu values (64 each)
+namespace {
+const char magic[4] = {'A', 'S', 'R', 'C'};
+constexpr quint32 formatVersion = 3;
+constexpr qint64 headerSize = 16;
+constexpr qint64 directoryEntrySize = 32;
+// Result count of an entry whose parameters are kept but whose result is stale
+constexpr quint32 noResult = 0xFFFFFFFFu;
+// Lookups, this one included, before a result is worth storing
+constexpr quint32 hotHitCount = 2;
+
+qint64 padded(qint64 size)
+{
+    return (size + 7) & ~qint64(7);
+}
+
+template <typename T>
+void appendValue(QByteArray &bytes, T value)
+{
+    const T littleEndian = qToLittleEndian(value);
+    bytes.append(reinterpret_cast<const char *>(&littleEndian), sizeof(T));
+}
+
+void appendPadding(QByteArray &bytes)
+{
+    bytes.append(QByteArray(padded(bytes.size()) - bytes.size(), '\0'));
+}
+}
+
+ResultCache::ResultCache(int capacity)
+    : capacity(capacity)
+{
+}
+
+ResultCache::~ResultCache()
+{
+    unmapFile();
+}
+
+QString ResultCache::cachePathFor(const QString &databasePath)
+{
+    return databasePath + ".results";
+}
+
+bool ResultCache::isCacheable(const AcademyScopeParameters &parameters)
+{
+    return !parameters.year.has_value();
+}
+
+std::optional<CachedResult> ResultCache::compute(const DatasetSnapshot &snapshot,
+                                                 const AcademyScopeParameters &parameters)
+{
+    if (!isCacheable(parameters))
+        return std::nullopt;
+    const std::shared_ptr<const ProgramDataset> dataset = snapshot.getDataset(parameters.placementType);
+    if (!dataset)
+        return std::nullopt;
+    const int programCodeColumn = dataset->columnIndex("ProgramKodu");
+    if (programCodeColumn < 0)
+        return std::nullopt;
+
+    QVector<int> rows = ProgramFilter::filterRows(snapshot, parameters);
+
+    // Same order as the back end: NULLs last, ties by ProgramKodu ascending
+    QVector<RankSorter::Key> rankKeys;
+    for (const SortKey &key : parameters.order.sortKeys()) {
+        const int column = dataset->columnIndex(QueryBuilder::getDbColumnNameFromProgramTableColumnIndex(key.column));
+        if (column < 0)
+            return std::nullopt;
+        rankKeys.append({dataset->ranks(column), dataset->rankCount(column), key.direction == Qt::DescendingOrder});
+    }
+    RankSorter::sortRows(rows, rankKeys);
+
+    CachedResult result;
+    result.count = rows.size();
+    result.programCodes.reserve(rows.size());
+    for (int row : rows)
+        result.programCodes.append(qint64(dataset->number(programCodeColumn, row)));
+    return result;
+}
+
+void ResultCache::open(const QString &databasePath, const QString &stamp)
+{
+    const QString path = cachePathFor(databasePath);
+    if (path == cachePath && stamp == fileStamp)
+        return;
+
+    unmapFile();
+    mapAttempted = false;
+    if (stamp != fileStamp) {
+        for (Entry &entry : entries) {
+            entry.current = false;
+            entry.result = CachedResult();
+        }
+    }
+    cachePath = path;
+    fileStamp = stamp;
+}
+
+std::optional<CachedResult> ResultCache::lookup(const AcademyScopeParameters &parameters)
+{
+    if (!isCacheable(parameters) || cachePath.isEmpty())
+        return std::nullopt;
+
+    const QByteArray canonicalJson = canonicalJsonOf(parameters);
+    const quint64 key = keyOf(canonicalJson);
+
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        // First touch in this process: the file may know the key from earlier runs
+        Entry entry{canonicalJson, 0, false, {}};
+        if (!mapAttempted)
+            mapFile();
+        const std::optional<FileEntry> fileEntry = findFileEntry(key);
+        if (fileEntry && fileJsonOf(*fileEntry) == canonicalJson) {
+            entry.hits = fileEntry->hits;
+            entry.saved = true;
+            if (fileIsCurrent && fileEntry->resultCount != noResult) {
+                entry.current = true;
+                entry.result.count = int(fileEntry->resultCount);
+                entry.result.programCodes = fileCodesOf(*fileEntry);
+            }
+        }
+        it = entries.insert(key, entry);
+    } else if (it->canonicalJson != canonicalJson) {
+        return std::nullopt; // hash collision; the older entry keeps the slot
+    }
+
+    ++it->hits;
+    if (!it->current)
+        return std::nullopt;
+    return it->result;
+}
+
+void ResultCache::store(const AcademyScopeParameters &parameters, const CachedResult &result)
+{
+    if (!isCacheable(parameters) || cachePath.isEmpty())
+        return;
+
+    const QByteArray canonicalJson = canonicalJsonOf(parameters);
+    Entry &entry = entries[keyOf(canonicalJson)];
+    if (!entry.canonicalJson.isEmpty() && entry.canonicalJson != canonicalJson)
+        return;
+    entry.canonicalJson = canonicalJson;
+    entry.hits = std::max<quint32>(entry.hits, 1);
+    entry.current = true;
+    entry.result = result;
+    entry.saved = false;
+}
+
+bool ResultCache::wantsResult(const AcademyScopeParameters &parameters) const
+{
+    if (!isCacheable(parameters) || cachePath.isEmpty())
+        return false;
+
+    // lookup() has already counted this request, so one hit is a first sighting
+    const QByteArray canonicalJson = canonicalJsonOf(parameters);
+    const auto it = entries.constFind(keyOf(canonicalJson));
+    return it != entries.cend() && it->canonicalJson == canonicalJson && !it->current && it->hits >= hotHitCount;
+}
+
+QVector<AcademyScopeParameters> ResultCache::staleHotParameters()
+{
+    absorbFileEntries();
+
+    QVector<const Entry *> stale;
+    for (const Entry &entry : entries)
+        if (!entry.current)
+            stale.append(&entry);
+    std::sort(stale.begin(), stale.end(), [](const Entry *a, const Entry *b) { return a->hits > b->hits; });
+    stale.resize(std::min<qsizetype>(stale.size(), capacity));
+
+    QVector<AcademyScopeParameters> parameterSets;
+    for (const Entry *entry : stale)
+        parameterSets.append(ParametersJson::fromJson(QJsonDocument::fromJson(entry->canonicalJson).object()));
+    return parameterSets;
+}
+
+bool ResultCache::save()
+{
+    if (cachePath.isEmpty())
+        return false;
+
+    // Entries of the file nobody asked for in this process are carried over
+    // from the mapping, without being kept in memory afterwards
+    if (!mapAttempted)
+        mapFile();
+    QHash<quint64, Entry> merged = entries;
+    for (int index = 0; index < fileEntryCount; ++index) {
+        const FileEntry fileEntry = fileEntryAt(index);
+        if (fileEntry.jsonSize == 0 || merged.contains(fileEntry.key))
+            continue;
+        Entry entry{fileJsonOf(fileEntry), fileEntry.hits, false, {}};
+        if (fileIsCurrent && fileEntry.resultCount != noResult) {
+            entry.current = true;
+            entry.result.count = int(fileEntry.resultCount);
+            entry.result.programCodes = fileCodesOf(fileEntry);
+        }
+        merged.insert(fileEntry.key, entry);
+    }
+
+    QVector<quint64> keys = merged.keys();
+    std::sort(keys.begin(), keys.end(), [&merged](quint64 a, quint64 b) {
+        return merged.constFind(a)->hits > merged.constFind(b)->hits;
+    });
+    keys.resize(std::min<qsizetype>(keys.size(), capacity));
+    std::sort(keys.begin(), keys.end());
+
+    const QByteArray stamp = fileStamp.toUtf8();
+    QByteArray header;
+    header.append(magic, sizeof(magic));
+    appendValue<quint32>(header, formatVersion);
+    appendValue<quint32>(header, keys.size());
+    appendValue<quint32>(header, stamp.size());
+    header.append(stamp);
+    appendPadding(header);
+
+    QByteArray directory;
+    QByteArray data;
+    const qint64 dataStart = header.size() + keys.size() * directoryEntrySize;
+    for (quint64 key : keys) {
+        const Entry &entry = *merged.constFind(key);
+        const QVector<qint64> &codes = entry.result.programCodes;
+        appendValue<quint64>(directory, key);
+        appendValue<qint64>(directory, dataStart + data.size());
+        appendValue<quint32>(directory, entry.current ? codes.size() : 0);
+        appendValue<quint32>(directory, entry.current ? quint32(entry.result.count) : noResult);
+        appendValue<quint32>(directory, entry.hits);
+        appendValue<quint32>(directory, entry.canonicalJson.size());
+
+        data.append(entry.canonicalJson);
+        appendPadding(data);
+        if (entry.current)
+            for (qint64 code : codes)
+                appendValue<qint64>(data, code);
+    }
+
+    // A mapped file cannot be replaced on every platform; it is mapped again on the next lookup
+    unmapFile();
+    mapAttempted = false;
+
+    QSaveFile out(cachePath);
+    if (!out.open(QIODevice::WriteOnly)) {
+        qWarning() << "[ResultCache] Cache file could not be written:" << out.errorString();
+        return false;
+    }
+    out.write(header);
+    out.write(directory);
+    out.write(data);
+    if (!out.commit()) {
+        qWarning() << "[ResultCache] Cache file could not be written:" << out.errorString();
+        return false;
+    }
+    for (quint64 key : keys) {
+        auto it = entries.find(key);
+        if (it != entries.end())
+            it->saved = true;
+    }
+    qDebug() << "[ResultCache] Saved" << keys.size() << "results to" << cachePath;
+    return true;
+}
+
+qint64 ResultCache::estimatedMemoryBytes() const
+{
+    // An empty cache has nothing to release
+    if (entries.isEmpty())
+        return 0;
+    qint64 bytes = sizeof(*this);
+    for (const Entry &entry : entries)
+        bytes += entryBytes(entry);
+    return bytes;
+}
+
+qint64 ResultCache::releaseMemory(qint64 targetBytes)
+{
+    // Only what the file holds may be dropped; hits gained since the last save
+    // are forgotten with it, they only rank entries
+    QVector<quint64> keys;
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it)
+        if (it->saved)
+            keys.append(it.key());
+    std::sort(keys.begin(), keys.end(), [this](quint64 a, quint64 b) {
+        return entries.constFind(a)->hits < entries.constFind(b)->hits;
+    });
+    qint64 freed = 0;
+    for (quint64 key : keys) {
+        if (freed >= targetBytes)
+            break;
+        freed += entryBytes(*entries.constFind(key));
+        entries.remove(key);
+    }
+    return freed;
+}
+
+qint64 ResultCache::entryBytes(const Entry &entry)
+{
+    return qint64(sizeof(quint64) + sizeof(Entry)) + entry.canonicalJson.capacity()
+           + entry.result.programCodes.capacity() * qint64(sizeof(qint64));
+}
+
+QByteArray ResultCache::canonicalJsonOf(const AcademyScopeParameters &parameters)
+{
+    // QJsonObject keeps its keys sorted, so equal parameters give equal bytes
+    QJsonObject object = ParametersJson::toJson(parameters);
+    object.remove("topK");
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+quint64 ResultCache::keyOf(const QByteArray &canonicalJson)
+{
+    const QByteArray digest = QCryptographicHash::hash(canonicalJson, QCryptographicHash::Sha1);
+    return qFromLittleEndian<quint64>(digest.constData());
+}
+
+bool ResultCache::mapFile()
+{
+    mapAttempted = true;
+    file.setFileName(cachePath);
+    if (!file.exists() || !file.open(QIODevice::ReadOnly))
+        return false;
+
+    mappedSize = file.size();
+    mapped = mappedSize >= headerSize ? file.map(0, mappedSize) : nullptr;
+    if (!mapped) {
+        unmapFile();
+        return false;
+    }
+
+    const quint32 version = qFromLittleEndian<quint32>(mapped + 4);
+    const quint32 entryCount = qFromLittleEndian<quint32>(mapped + 8);
+    const quint32 stampSize = qFromLittleEndian<quint32>(mapped + 12);
+    directoryOffset = headerSize + padded(stampSize);
+    if (memcmp(mapped, magic, sizeof(magic)) != 0 || version != formatVersion
+        || directoryOffset + qint64(entryCount) * directoryEntrySize > mappedSize) {
+        qWarning() << "[ResultCache] Ignoring unreadable cache file" << cachePath;
+        unmapFile();
+        return false;
+    }
+
+    fileEntryCount = int(entryCount);
+    fileIsCurrent = QString::fromUtf8(reinterpret_cast<const char *>(mapped + headerSize), stampSize) == fileStamp;
+    return true;
+}
+
+void ResultCache::unmapFile()
+{
+    if (mapped)
+        file.unmap(const_cast<uchar *>(mapped));
+    file.close();
+    mapped = nullptr;
+    mappedSize = 0;
+    fileEntryCount = 0;
+    fileIsCurrent = false;
+}
+
+ResultCache::FileEntry ResultCache::fileEntryAt(int index) const
+{
+    const uchar *record = mapped + directoryOffset + index * directoryEntrySize;
+    FileEntry entry;
+    entry.key = qFromLittleEndian<quint64>(record);
+    entry.dataOffset = qFromLittleEndian<qint64>(record + 8);
+    entry.codeCount = qFromLittleEndian<quint32>(record + 16);
+    entry.resultCount = qFromLittleEndian<quint32>(record + 20);
+    entry.hits = qFromLittleEndian<quint32>(record + 24);
+    entry.jsonSize = qFromLittleEndian<quint32>(record + 28);
+    // A truncated file yields no entry rather than a read past the mapping
+    if (entry.dataOffset < 0 || entry.dataOffset + padded(entry.jsonSize) + qint64(entry.codeCount) * 8 > mappedSize)
+        return FileEntry();
+    return entry;
+}
+
+std::optional<ResultCache::FileEntry> ResultCache::findFileEntry(quint64 key) const
+{
+    if (!mapped)
+        return std::nullopt;
+    int low = 0, high = fileEntryCount;
+    while (low < high) {
+        const int middle = (low + high) / 2;
+        const quint64 middleKey = qFromLittleEndian<quint64>(mapped + directoryOffset + middle * directoryEntrySize);
+        if (middleKey < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == fileEntryCount)
+        return std::nullopt;
+    const FileEntry entry = fileEntryAt(low);
+    if (entry.key != key)
+        return std::nullopt;
+    return entry;
+}
+
+QByteArray ResultCache::fileJsonOf(const FileEntry &entry) const
+{
+    return QByteArray(reinterpret_cast<const char *>(mapped + entry.dataOffset), entry.jsonSize);
+}
+
+QVector<qint64> ResultCache::fileCodesOf(const FileEntry &entry) const
+{
+    const uchar *codes = mapped + entry.dataOffset + padded(entry.jsonSize);
+    QVector<qint64> programCodes(entry.codeCount);
+    for (quint32 i = 0; i < entry.codeCount; ++i)
+        programCodes[i] = qFromLittleEndian<qint64>(codes + i * 8);
+    return programCodes;
+}
+
+void ResultCache::absorbFileEntries()
+{
+    if (!mapAttempted)
+        mapFile();
+    for (int index = 0; index < fileEntryCount; ++index) {
+        const FileEntry fileEntry = fileEntryAt(index);
+        if (fileEntry.jsonSize == 0 || entries.contains(fileEntry.key))
+            continue;
+        Entry entry{fileJsonOf(fileEntry), fileEntry.hits, false, {}};
+        if (fileIsCurrent && fileEntry.resultCount != noResult) {
+            entry.current = true;
+            entry.result.count = int(fileEntry.resultCount);
+            entry.result.programCodes = fileCodesOf(fileEntry);
+        }
+        entry.saved = true;
+        entries.insert(fileEntry.key, entry);
+    }
+}
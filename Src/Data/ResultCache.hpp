@@ -0,0 +1,102 @@
+/*
+ResultCache class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <optional>
+#include "../DataTypeDefinitions.hpp"
+#include "DatasetSnapshot.hpp"
+
+struct CachedResult {
+    QVector<qint64> programCodes; // display order
+    int count = 0;                // size of the filtered set
+};
+
+// Ordered results of popular parameter sets, kept across restarts in a file
+// next to the database (<database>.results). The file is stamped with the
+// dataset's file stamp and memory-mapped on the first lookup; entries of a
+// different stamp are never served, but their parameters tell which results
+// to recompute. Only parameter sets the in-memory datasets can answer
+// (sorted, current year) are cached; topK is not part of the key.
+class ResultCache
+{
+public:
+    explicit ResultCache(int capacity = 32);
+    ~ResultCache();
+
+    static QString cachePathFor(const QString &databasePath);
+    static bool isCacheable(const AcademyScopeParameters &parameters);
+    // Filters and orders on the snapshot's datasets exactly like the rank path of the back end
+    static std::optional<CachedResult> compute(const DatasetSnapshot &snapshot,
+                                               const AcademyScopeParameters &parameters);
+
+    // Results of another stamp stop being served; their hit counts are kept
+    void open(const QString &databasePath, const QString &fileStamp);
+    std::optional<CachedResult> lookup(const AcademyScopeParameters &parameters);
+    void store(const AcademyScopeParameters &parameters, const CachedResult &result);
+    // True for parameters looked up often enough to be hot and without a result
+    // for the current stamp; the back end stores only those
+    bool wantsResult(const AcademyScopeParameters &parameters) const;
+    // Hottest parameter sets without a result for the current stamp
+    QVector<AcademyScopeParameters> staleHotParameters();
+    // Writes the hottest entries; the file is replaced atomically
+    bool save();
+
+    qint64 estimatedMemoryBytes() const;
+    // Forgets the least hit entries the file already holds; they are read from
+    // it again on demand. Never writes the file itself.
+    qint64 releaseMemory(qint64 targetBytes);
+
+private:
+    struct Entry {
+        QByteArray canonicalJson;
+        quint32 hits = 0;
+        bool current = false; // result belongs to the opened stamp
+        CachedResult result;
+        bool saved = false;   // the file holds this entry, result included
+    };
+    struct FileEntry {
+        quint64 key = 0;
+        qint64 dataOffset = 0;
+        quint32 codeCount = 0;
+        quint32 resultCount = 0;
+        quint32 hits = 0;
+        quint32 jsonSize = 0;
+    };
+
+    static qint64 entryBytes(const Entry &entry);
+    static QByteArray canonicalJsonOf(const AcademyScopeParameters &parameters);
+    static quint64 keyOf(const QByteArray &canonicalJson);
+    bool mapFile();
+    void unmapFile();
+    std::optional<FileEntry> findFileEntry(quint64 key) const;
+    FileEntry fileEntryAt(int index) const;
+    QByteArray fileJsonOf(const FileEntry &entry) const;
+    QVector<qint64> fileCodesOf(const FileEntry &entry) const;
+    // Every entry of the file not yet in memory, results included when current
+    void absorbFileEntries();
+
+    int capacity;
+    QString cachePath;
+    QString fileStamp;
+    QHash<quint64, Entry> entries; // touched in this process
+
+    QFile file;
+    const uchar *mapped = nullptr;
+    qint64 mappedSize = 0;
+    bool mapAttempted = false;
+    bool fileIsCurrent = false;
+    int fileEntryCount = 0;
+    qint64 directoryOffset = 0;
+};
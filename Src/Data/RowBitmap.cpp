@@ -0,0 +1,326 @@
+/*
+RowBitmap class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "RowBitmap.hpp"
+#include <QtGlobal>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+RowBitmap RowBitmap::fromSortedRows(const QVector<int> &rows)
+{
+    RowBitmap bitmap;
+    for (int row : rows) {
+        const quint16 key = quint16(quint32(row) >> 16);
+        if (bitmap.containers.isEmpty() || bitmap.containers.last().key != key)
+            bitmap.containers.append(Container{key, 0, {}, {}});
+        Container &container = bitmap.containers.last();
+        container.values.append(quint16(row & 0xFFFF));
+        ++container.cardinality;
+    }
+    for (Container &container : bitmap.containers)
+        optimize(container);
+    return bitmap;
+}
+
+RowBitmap RowBitmap::allRows(int rowCount)
+{
+    RowBitmap bitmap;
+    for (int start = 0; start < rowCount; start += 65536) {
+        Container container;
+        container.key = quint16(start >> 16);
+        container.cardinality = std::min(65536, rowCount - start);
+        container.words.resize(wordCount);
+        for (int low = 0; low < container.cardinality; ++low)
+            container.words[low >> 6] |= quint64(1) << (low & 63);
+        optimize(container);
+        bitmap.containers.append(container);
+    }
+    return bitmap;
+}
+
+bool RowBitmap::Container::contains(quint16 low) const
+{
+    if (isDense())
+        return words[low >> 6] & (quint64(1) << (low & 63));
+    return std::binary_search(values.cbegin(), values.cend(), low);
+}
+
+QVector<quint64> RowBitmap::toWords(const Container &container)
+{
+    if (container.isDense())
+        return container.words;
+    QVector<quint64> words(wordCount, 0);
+    for (quint16 low : container.values)
+        words[low >> 6] |= quint64(1) << (low & 63);
+    return words;
+}
+
+void RowBitmap::optimize(Container &container)
+{
+    if (container.isDense() && container.cardinality <= arrayLimit) {
+        QVector<quint16> values;
+        values.reserve(container.cardinality);
+        for (int word = 0; word < wordCount; ++word) {
+            quint64 bits = container.words[word];
+            while (bits) {
+                values.append(quint16(word * 64 + qCountTrailingZeroBits(bits)));
+                bits &= bits - 1;
+            }
+        }
+        container.values = std::move(values);
+        container.words.clear();
+    } else if (!container.isDense() && container.cardinality > arrayLimit) {
+        container.words = toWords(container);
+        container.values.clear();
+    }
+}
+
+RowBitmap::Container RowBitmap::intersect(const Container &a, const Container &b)
+{
+    Container result;
+    result.key = a.key;
+    if (a.isDense() && b.isDense()) {
+        result.words.resize(wordCount);
+        for (int word = 0; word < wordCount; ++word) {
+            result.words[word] = a.words[word] & b.words[word];
+            result.cardinality += qPopulationCount(result.words[word]);
+        }
+    } else if (a.isDense() || b.isDense()) {
+        const Container &dense = a.isDense() ? a : b;
+        const Container &sparse = a.isDense() ? b : a;
+        for (quint16 low : sparse.values)
+            if (dense.contains(low))
+                result.values.append(low);
+        result.cardinality = result.values.size();
+    } else {
+        std::set_intersection(a.values.cbegin(), a.values.cend(), b.values.cbegin(), b.values.cend(),
+                              std::back_inserter(result.values));
+        result.cardinality = result.values.size();
+    }
+    optimize(result);
+    return result;
+}
+
+RowBitmap::Container RowBitmap::unite(const Container &a, const Container &b)
+{
+    Container result;
+    result.key = a.key;
+    if (a.isDense() || b.isDense() || a.cardinality + b.cardinality > arrayLimit) {
+        result.words = toWords(a);
+        const QVector<quint64> other = toWords(b);
+        for (int word = 0; word < wordCount; ++word) {
+            result.words[word] |= other[word];
+            result.cardinality += qPopulationCount(result.words[word]);
+        }
+    } else {
+        std::set_union(a.values.cbegin(), a.values.cend(), b.values.cbegin(), b.values.cend(),
+                       std::back_inserter(result.values));
+        result.cardinality = result.values.size();
+    }
+    optimize(result);
+    return result;
+}
+
+RowBitmap::Container RowBitmap::subtract(const Container &a, const Container &b)
+{
+    Container result;
+    result.key = a.key;
+    if (a.isDense()) {
+        result.words = a.words;
+        const QVector<quint64> other = toWords(b);
+        for (int word = 0; word < wordCount; ++word) {
+            result.words[word] &= ~other[word];
+            result.cardinality += qPopulationCount(result.words[word]);
+        }
+    } else {
+        for (quint16 low : a.values)
+            if (!b.contains(low))
+                result.values.append(low);
+        result.cardinality = result.values.size();
+    }
+    optimize(result);
+    return result;
+}
+
+RowBitmap RowBitmap::operator&(const RowBitmap &other) const
+{
+    RowBitmap result;
+    int i = 0, j = 0;
+    while (i < containers.size() && j < other.containers.size()) {
+        if (containers[i].key < other.containers[j].key) {
+            ++i;
+        } else if (containers[i].key > other.containers[j].key) {
+            ++j;
+        } else {
+            Container container = intersect(containers[i++], other.containers[j++]);
+            if (container.cardinality > 0)
+                result.containers.append(std::move(container));
+        }
+    }
+    return result;
+}
+
+RowBitmap RowBitmap::operator|(const RowBitmap &other) const
+{
+    RowBitmap result;
+    int i = 0, j = 0;
+    while (i < containers.size() || j < other.containers.size()) {
+        if (j == other.containers.size() || (i < containers.size() && containers[i].key < other.containers[j].key))
+            result.containers.append(containers[i++]);
+        else if (i == containers.size() || containers[i].key > other.containers[j].key)
+            result.containers.append(other.containers[j++]);
+        else
+            result.containers.append(unite(containers[i++], other.containers[j++]));
+    }
+    return result;
+}
+
+RowBitmap RowBitmap::andNot(const RowBitmap &other) const
+{
+    RowBitmap result;
+    int j = 0;
+    for (const Container &container : containers) {
+        while (j < other.containers.size() && other.containers[j].key < container.key)
+            ++j;
+        if (j == other.containers.size() || other.containers[j].key != container.key) {
+            result.containers.append(container);
+            continue;
+        }
+        Container remaining = subtract(container, other.containers[j]);
+        if (remaining.cardinality > 0)
+            result.containers.append(std::move(remaining));
+    }
+    return result;
+}
+
+bool RowBitmap::contains(int row) const
+{
+    const quint16 key = quint16(quint32(row) >> 16);
+    const auto it = std::lower_bound(containers.cbegin(), containers.cend(), key,
+                                     [](const Container &container, quint16 k) { return container.key < k; });
+    return it != containers.cend() && it->key == key && it->contains(quint16(row & 0xFFFF));
+}
+
+bool RowBitmap::isEmpty() const
+{
+    return containers.isEmpty();
+}
+
+int RowBitmap::cardinality() const
+{
+    int count = 0;
+    for (const Container &container : containers)
+        count += container.cardinality;
+    return count;
+}
+
+QVector<int> RowBitmap::toRows() const
+{
+    QVector<int> rows;
+    rows.reserve(cardinality());
+    for (const Container &container : containers) {
+        const int high = int(container.key) << 16;
+        if (!container.isDense()) {
+            for (quint16 low : container.values)
+                rows.append(high | low);
+            continue;
+        }
+        for (int word = 0; word < wordCount; ++word) {
+            quint64 bits = container.words[word];
+            while (bits) {
+                rows.append(high | (word * 64 + qCountTrailingZeroBits(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+    return rows;
+}
+
+qint64 RowBitmap::estimatedMemoryBytes() const
+{
+    qint64 bytes = sizeof(*this);
+    for (const Container &container : containers)
+        bytes += qint64(sizeof(Container)) + container.values.capacity() * qint64(sizeof(quint16))
+                 + container.words.capacity() * qint64(sizeof(quint64));
+    return bytes;
+}
+
+QVector<quint64> RowBitmap::toFlat() const
+{
+    QVector<quint64> flat;
+    for (const Container &container : containers) {
+        flat.append(quint64(container.key) | (quint64(container.cardinality) << 16)
+                    | (container.isDense() ? quint64(1) << 40 : 0));
+        if (container.isDense()) {
+            flat.append(container.words);
+            continue;
+        }
+        QVector<quint64> packed((container.values.size() + 3) / 4, 0);
+        std::memcpy(packed.data(), container.values.constData(), container.values.size() * sizeof(quint16));
+        flat.append(packed);
+    }
+    return flat;
+}
+
+std::optional<RowBitmap> RowBitmap::fromFlat(ColumnArray<quint64> flat, int rowCount)
+{
+    RowBitmap bitmap;
+    qsizetype offset = 0;
+    int previousKey = -1;
+    while (offset < flat.size()) {
+        const quint64 header = flat[offset++];
+        Container container;
+        container.key = quint16(header & 0xFFFF);
+        container.cardinality = int((header >> 16) & 0x1FFFF);
+        const bool dense = (header >> 40) & 1;
+        // Rows past the dataset would be read as dataset rows by every caller
+        const qint64 high = qint64(container.key) << 16;
+        const int limit = int(std::min<qint64>(65536, rowCount - high));
+        if (container.key <= previousKey || limit <= 0 || container.cardinality <= 0
+            || container.cardinality > limit)
+            return std::nullopt;
+        previousKey = container.key;
+
+        if (dense) {
+            if (flat.size() - offset < wordCount)
+                return std::nullopt;
+            container.words.resize(wordCount);
+            std::memcpy(container.words.data(), flat.constData() + offset, wordCount * sizeof(quint64));
+            offset += wordCount;
+            int count = 0;
+            for (int word = 0; word < wordCount; ++word) {
+                // Bits at or past the limit must be clear
+                const int first = word * 64;
+                const quint64 allowed = first >= limit ? 0
+                                        : limit - first >= 64 ? ~quint64(0)
+                                                              : (quint64(1) << (limit - first)) - 1;
+                if (container.words[word] & ~allowed)
+                    return std::nullopt;
+                count += qPopulationCount(container.words[word]);
+            }
+            if (count != container.cardinality)
+                return std::nullopt;
+        } else {
+            const qsizetype packedWords = (container.cardinality + 3) / 4;
+            if (flat.size() - offset < packedWords)
+                return std::nullopt;
+            container.values.resize(container.cardinality);
+            std::memcpy(container.values.data(), flat.constData() + offset, container.cardinality * sizeof(quint16));
+            offset += packedWords;
+            for (int i = 0; i < container.values.size(); ++i) {
+                if (container.values[i] >= limit || (i > 0 && container.values[i] <= container.values[i - 1]))
+                    return std::nullopt;
+            }
+        }
+        bitmap.containers.append(std::move(container));
+    }
+    return bitmap;
+}
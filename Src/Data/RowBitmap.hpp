@@ -0,0 +1,66 @@
+/*
+RowBitmap class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QVector>
+#include <optional>
+#include "ColumnArray.hpp"
+
+// Compressed set of dataset rows in the Roaring layout: rows are split into
+// chunks of 65536 by their high 16 bits, and every chunk is stored either as
+// a sorted array of low bits (sparse) or as a 65536-bit bitset (dense).
+class RowBitmap
+{
+public:
+    static RowBitmap fromSortedRows(const QVector<int> &rows);
+    static RowBitmap allRows(int rowCount);
+
+    RowBitmap operator&(const RowBitmap &other) const;
+    RowBitmap operator|(const RowBitmap &other) const;
+    // Rows of this bitmap that are not in the other one
+    RowBitmap andNot(const RowBitmap &other) const;
+
+    bool contains(int row) const;
+    bool isEmpty() const;
+    int cardinality() const;
+    // Ascending
+    QVector<int> toRows() const;
+    qint64 estimatedMemoryBytes() const;
+
+    // Flat form for a bitmap kept outside the heap, e.g. in a SnapshotImage:
+    // per container one header word (key, cardinality, dense flag), then its
+    // 1024 bitset words or its low bits packed four to a word
+    QVector<quint64> toFlat() const;
+    // Empty when the words are not a flat bitmap of rows below rowCount
+    static std::optional<RowBitmap> fromFlat(ColumnArray<quint64> flat, int rowCount);
+
+private:
+    static constexpr int arrayLimit = 4096; // above this a bitset is smaller
+    static constexpr int wordCount = 65536 / 64;
+
+    struct Container {
+        quint16 key = 0;
+        int cardinality = 0;
+        QVector<quint16> values; // sparse form
+        QVector<quint64> words;  // dense form; empty when sparse
+
+        bool isDense() const { return !words.isEmpty(); }
+        bool contains(quint16 low) const;
+    };
+
+    static Container intersect(const Container &a, const Container &b);
+    static Container unite(const Container &a, const Container &b);
+    static Container subtract(const Container &a, const Container &b);
+    static QVector<quint64> toWords(const Container &container);
+    // Picks the smaller form for the container's cardinality
+    static void optimize(Container &container);
+
+    QVector<Container> containers; // ascending keys, no empty containers
+};
@@ -0,0 +1,136 @@
+/*
+ScoreIndex class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ScoreIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include "ProgramFilter.hpp"
+
+std::shared_ptr<const ScoreIndex> ScoreIndex::build(const ProgramDataset &dataset)
+{
+    auto index = std::make_shared<ScoreIndex>();
+    const int trackColumn = dataset.columnIndex("PuanTuru");
+    const int programCodeColumn = dataset.columnIndex("ProgramKodu");
+    if (trackColumn < 0 || programCodeColumn < 0)
+        return index;
+
+    QHash<QString, std::array<QVector<Entry>, int(ColumnTypes::Women34Plus) + 1>> entriesByTrack;
+    for (int quota = int(ColumnTypes::Regular); quota <= int(ColumnTypes::Women34Plus); ++quota) {
+        const int scoreColumn = dataset.columnIndex(minimumScoreColumnOf(ColumnTypes(quota)));
+        if (scoreColumn < 0)
+            continue;
+        for (int row = 0; row < dataset.rowCount(); ++row) {
+            const double score = dataset.number(scoreColumn, row);
+            if (std::isnan(score))
+                continue;
+            entriesByTrack[dataset.text(trackColumn, row).toString()][quota].append(Entry{score, row});
+        }
+    }
+
+    for (auto it = entriesByTrack.begin(); it != entriesByTrack.end(); ++it) {
+        EntriesByQuota &views = index->entriesByTrack[it.key()];
+        for (int quota = 0; quota < int(views.size()); ++quota) {
+            QVector<Entry> &entries = it.value()[quota];
+            std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+                return a.minimumScore < b.minimumScore || (a.minimumScore == b.minimumScore && a.row < b.row);
+            });
+            index->entryStorage.append(std::move(entries));
+            views[quota] = index->entryStorage.last();
+        }
+    }
+    return index;
+}
+
+QString ScoreIndex::minimumScoreColumnOf(ColumnTypes quotaType)
+{
+    switch (quotaType) {
+    case ColumnTypes::Regular:                  return "GenelEnKucukPuan";
+    case ColumnTypes::HighSchoolValedictorians: return "OkulBirincisiEnKucukPuan";
+    case ColumnTypes::MartyrsAndVeterans:       return "SehitGaziEnKucukPuan";
+    case ColumnTypes::EarthquakeVictims:        return "DepremzedeEnKucukPuan";
+    case ColumnTypes::Women34Plus:              return "Kadin34EnKucukPuan";
+    case ColumnTypes::Base:                     break;
+    }
+    return {};
+}
+
+const ColumnArray<ScoreIndex::Entry> *ScoreIndex::entriesOf(const QString &trackName, ColumnTypes quotaType) const
+{
+    if (quotaType == ColumnTypes::Base)
+        return nullptr;
+    const auto it = entriesByTrack.constFind(trackName);
+    return it == entriesByTrack.constEnd() ? nullptr : &(*it)[int(quotaType)];
+}
+
+int ScoreIndex::cutoffOf(const ColumnArray<Entry> &entries, double score)
+{
+    // First entry above the score; everything before it is reachable
+    return int(std::upper_bound(entries.begin(), entries.end(), score,
+                                [](double value, const Entry &entry) { return value < entry.minimumScore; })
+               - entries.begin());
+}
+
+QVector<ReachableProgram> ScoreIndex::findReachable(const ProgramDataset &dataset, double score, TrackType trackType,
+                                                    ColumnTypes quotaType, int k, const ProgramFilter *filter) const
+{
+    QStringList trackNames;
+    if (trackType == TrackType::Undefined)
+        trackNames = entriesByTrack.keys();
+    else
+        trackNames << ProgramFilter::trackNameOf(trackType);
+
+    const int programCodeColumn = dataset.columnIndex("ProgramKodu");
+    QVector<ReachableProgram> reachable;
+    for (const QString &trackName : std::as_const(trackNames)) {
+        const ColumnArray<Entry> *entries = entriesOf(trackName, quotaType);
+        if (!entries)
+            continue;
+
+        int found = 0;
+        for (int i = cutoffOf(*entries, score) - 1; i >= 0 && found < k; --i) {
+            const Entry &entry = (*entries)[i];
+            if (filter && !filter->matches(entry.row))
+                continue;
+            reachable.append(ReachableProgram{
+                entry.row, dataset.rowId(entry.row), qint64(dataset.number(programCodeColumn, entry.row)),
+                entry.minimumScore, score - entry.minimumScore });
+            ++found;
+        }
+    }
+
+    // Several tracks each contributed their own top k
+    if (trackNames.size() > 1) {
+        const int keep = std::min<int>(k, reachable.size());
+        std::partial_sort(reachable.begin(), reachable.begin() + keep, reachable.end(),
+                          [](const ReachableProgram &a, const ReachableProgram &b) { return a.margin < b.margin; });
+        reachable.resize(keep);
+    }
+    return reachable;
+}
+
+int ScoreIndex::reachableCount(double score, TrackType trackType, ColumnTypes quotaType) const
+{
+    int count = 0;
+    const QStringList trackNames = trackType == TrackType::Undefined
+                                       ? entriesByTrack.keys()
+                                       : QStringList{ ProgramFilter::trackNameOf(trackType) };
+    for (const QString &trackName : trackNames)
+        if (const ColumnArray<Entry> *entries = entriesOf(trackName, quotaType))
+            count += cutoffOf(*entries, score);
+    return count;
+}
+
+qint64 ScoreIndex::estimatedMemoryBytes() const
+{
+    qint64 bytes = sizeof(*this) + entriesByTrack.capacity() * qint64(sizeof(QString) + sizeof(EntriesByQuota));
+    for (const QVector<Entry> &entries : entryStorage)
+        bytes += entries.capacity() * qint64(sizeof(Entry));
+    return bytes;
+}
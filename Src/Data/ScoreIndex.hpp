@@ -0,0 +1,69 @@
+/*
+ScoreIndex class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <memory>
+#include "../DataTypeDefinitions.hpp"
+#include "../ProgramTableColumnDefinitions.hpp"
+#include "ProgramDataset.hpp"
+
+class ProgramFilter;
+
+struct ReachableProgram {
+    int row = -1;            // dataset row
+    qint64 rowId = 0;
+    qint64 programCode = 0;
+    double minimumScore = 0; // cutoff of the quota group
+    double margin = 0;       // score - minimumScore
+};
+
+// Minimum scores per PuanTuru and quota group, sorted ascending. The cutoff for
+// a score is one binary search; reachable programs are read backwards from it,
+// so the closest (most competitive) reachable programs come first. An
+// attached index reads the entries from the mapped SnapshotImage.
+class ScoreIndex
+{
+public:
+    static std::shared_ptr<const ScoreIndex> build(const ProgramDataset &dataset);
+    static QString minimumScoreColumnOf(ColumnTypes quotaType);
+
+    // Up to k reachable programs passing the filter, smallest margin first.
+    // TrackType::Undefined merges every track.
+    QVector<ReachableProgram> findReachable(const ProgramDataset &dataset, double score, TrackType trackType,
+                                            ColumnTypes quotaType, int k, const ProgramFilter *filter) const;
+    // Number of programs with a cutoff at or below the score, ignoring other filters
+    int reachableCount(double score, TrackType trackType, ColumnTypes quotaType) const;
+
+    // Memory of this process only; mapped image pages are shared and not counted
+    qint64 estimatedMemoryBytes() const;
+
+private:
+    friend class SnapshotImage;
+
+    // Written to a SnapshotImage as is, so the padding is spelled out
+    struct Entry {
+        double minimumScore;
+        int row;
+        int reserved = 0;
+    };
+    using EntriesByQuota = std::array<ColumnArray<Entry>, int(ColumnTypes::Women34Plus) + 1>;
+
+    const ColumnArray<Entry> *entriesOf(const QString &trackName, ColumnTypes quotaType) const;
+    static int cutoffOf(const ColumnArray<Entry> &entries, double score);
+
+    QHash<QString, EntriesByQuota> entriesByTrack;
+    // Backing of the entries above for an index built in this process
+    QVector<QVector<Entry>> entryStorage;
+    std::shared_ptr<const void> image; // keeps an attached image mapped
+};
@@ -0,0 +1,518 @@
+/*
+SnapshotImage class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "SnapshotImage.hpp"
+#include <QSaveFile>
+#include <QDebug>
+#include <cstring>
+#include "DatasetSnapshot.hpp"
+
+namespace {
+const char magic[8] = {'A', 'S', 'S', 'I', '0', '0', '0', '3'};
+// Written as a native quint64; an image from a host of the other byte order reads it reversed
+constexpr quint64 byteOrderMark = 0x0102030405060708ULL;
+constexpr quint64 regularPresent = 1;
+constexpr quint64 additionalPresent = 2;
+constexpr quint64 joinIndexPresent = 4;
+constexpr quint64 textFlag = 1;
+constexpr quint64 integerFlag = 2;
+
+qint64 padded(qint64 size)
+{
+    return (size + 7) & ~qint64(7);
+}
+}
+
+// Every scalar is 8 bytes and every array is padded to 8 bytes, so all arrays
+// start aligned for any element type
+class SnapshotImage::Writer
+{
+public:
+    void raw(const char *bytes, qint64 size)
+    {
+        data.append(bytes, size);
+        data.append(padded(size) - size, '\0');
+    }
+
+    void number(quint64 value)
+    {
+        raw(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    void array(const T *values, qint64 count)
+    {
+        number(quint64(count));
+        raw(reinterpret_cast<const char *>(values), count * qint64(sizeof(T)));
+    }
+
+    void string(const QString &text)
+    {
+        array(text.utf16(), text.size());
+    }
+
+    QByteArray data;
+};
+
+// Every read is bounds checked; the first failure clears ok and later reads return nothing
+class SnapshotImage::Reader
+{
+public:
+    Reader(const uchar *data, qint64 size) : data(data), size(size) {}
+
+    bool raw(const char *expected, qint64 length)
+    {
+        ok = ok && offset + padded(length) <= size && std::memcmp(data + offset, expected, length) == 0;
+        if (ok)
+            offset += padded(length);
+        return ok;
+    }
+
+    quint64 number()
+    {
+        ok = ok && offset + qint64(sizeof(quint64)) <= size;
+        if (!ok)
+            return 0;
+        quint64 value;
+        std::memcpy(&value, data + offset, sizeof(value));
+        offset += sizeof(value);
+        return value;
+    }
+
+    template <typename T>
+    ColumnArray<T> array()
+    {
+        const quint64 count = number();
+        ok = ok && count <= quint64(size - offset) / sizeof(T)
+             && padded(qint64(count * sizeof(T))) <= size - offset;
+        if (!ok)
+            return {};
+        const ColumnArray<T> values(reinterpret_cast<const T *>(data + offset), qsizetype(count));
+        offset += padded(qint64(count * sizeof(T)));
+        return values;
+    }
+
+    // Copied out of the mapping; for names and other short strings
+    QString string()
+    {
+        const ColumnArray<char16_t> characters = array<char16_t>();
+        return QString(reinterpret_cast<const QChar *>(characters.constData()), characters.size());
+    }
+
+    // Points into the mapping
+    QString rawString()
+    {
+        const ColumnArray<char16_t> characters = array<char16_t>();
+        return QString::fromRawData(reinterpret_cast<const QChar *>(characters.constData()), characters.size());
+    }
+
+    bool ok = true;
+
+private:
+    const uchar *data;
+    qint64 size;
+    qint64 offset = 0;
+};
+
+SnapshotImage::~SnapshotImage()
+{
+    if (mapped)
+        file.unmap(const_cast<uchar *>(mapped));
+}
+
+QString SnapshotImage::imagePathFor(const QString &databasePath)
+{
+    return databasePath + ".snapshot";
+}
+
+bool SnapshotImage::write(const DatasetSnapshot &snapshot, const QString &imagePath)
+{
+    const std::shared_ptr<const ProgramDataset> regular = snapshot.getDataset(PlacementType::Regular);
+    const std::shared_ptr<const ProgramDataset> additional = snapshot.getDataset(PlacementType::Additional);
+    const std::shared_ptr<const ProgramJoinIndex> joinIndex = snapshot.getProgramJoinIndex();
+    if (!regular) {
+        qWarning() << "[SnapshotImage] Snapshot has no regular dataset to write";
+        return false;
+    }
+    auto indexed = [&snapshot](PlacementType placementType) {
+        return snapshot.getScoreIndex(placementType) && snapshot.getBitmapIndex(placementType)
+               && snapshot.getZoneMap(placementType);
+    };
+    if (!indexed(PlacementType::Regular) || (additional && !indexed(PlacementType::Additional))) {
+        qWarning() << "[SnapshotImage] Snapshot has a dataset without its indexes";
+        return false;
+    }
+
+    Writer writer;
+    writer.raw(magic, sizeof(magic));
+    writer.number(byteOrderMark);
+    writer.string(snapshot.getFileStamp());
+    writer.number(regularPresent | (additional ? additionalPresent : 0)
+                  | (additional && joinIndex ? joinIndexPresent : 0));
+    // Every dataset is followed by its indexes
+    for (PlacementType placementType : { PlacementType::Regular, PlacementType::Additional }) {
+        const std::shared_ptr<const ProgramDataset> dataset = snapshot.getDataset(placementType);
+        if (!dataset)
+            continue;
+        writeDataset(writer, *dataset);
+        writeScoreIndex(writer, *snapshot.getScoreIndex(placementType));
+        writeBitmapIndex(writer, *snapshot.getBitmapIndex(placementType));
+        writeZoneMap(writer, *snapshot.getZoneMap(placementType));
+    }
+    if (additional && joinIndex)
+        writeJoinIndex(writer, *joinIndex);
+
+    writer.number(quint64(snapshot.getUniversities().size()));
+    for (const University &university : snapshot.getUniversities()) {
+        writer.number(quint64(qint64(university.id)));
+        writer.string(university.name);
+    }
+    writer.number(quint64(snapshot.getDepartments().size()));
+    for (const QString &department : snapshot.getDepartments())
+        writer.string(department);
+
+    QSaveFile file(imagePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(writer.data) != writer.data.size() || !file.commit()) {
+        qWarning() << "[SnapshotImage] Image could not be written to" << imagePath << ":" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void SnapshotImage::writeDataset(Writer &writer, const ProgramDataset &dataset)
+{
+    writer.string(dataset.table);
+    writer.array(dataset.rowIds.constData(), dataset.rowIds.size());
+    writer.array(dataset.rowsByRowId.constData(), dataset.rowsByRowId.size());
+    writer.number(quint64(dataset.columns.size()));
+    for (const ProgramDataset::Column &column : dataset.columns) {
+        writer.string(column.name);
+        writer.number((column.isText ? textFlag : 0) | (column.isInteger ? integerFlag : 0));
+        writer.number(column.rankCount);
+        if (column.isText) {
+            writer.array(column.codes.constData(), column.codes.size());
+            writer.number(quint64(column.dictionary.size()));
+            for (const QString &text : column.dictionary)
+                writer.string(text);
+            for (const QString &text : column.foldedDictionary)
+                writer.string(text);
+        } else {
+            writer.array(column.numbers.constData(), column.numbers.size());
+        }
+        writer.array(column.ranks.constData(), column.ranks.size());
+    }
+}
+
+void SnapshotImage::writeScoreIndex(Writer &writer, const ScoreIndex &index)
+{
+    writer.number(quint64(index.entriesByTrack.size()));
+    for (auto it = index.entriesByTrack.cbegin(); it != index.entriesByTrack.cend(); ++it) {
+        writer.string(it.key());
+        for (const ColumnArray<ScoreIndex::Entry> &entries : it.value())
+            writer.array(entries.constData(), entries.size());
+    }
+}
+
+void SnapshotImage::writeBitmapIndex(Writer &writer, const BitmapIndex &index)
+{
+    writer.number(quint64(index.rowCount));
+    for (const QHash<QString, ColumnArray<quint64>> *bitmaps : { &index.bitmapsByValue, &index.notNullBitmaps }) {
+        writer.number(quint64(bitmaps->size()));
+        for (auto it = bitmaps->cbegin(); it != bitmaps->cend(); ++it) {
+            writer.string(it.key());
+            writer.array(it.value().constData(), it.value().size());
+        }
+    }
+}
+
+void SnapshotImage::writeZoneMap(Writer &writer, const ZoneMap &zoneMap)
+{
+    writer.number(quint64(zoneMap.blockSize));
+    writer.number(quint64(zoneMap.rowCount));
+    writer.array(zoneMap.clusteredRows.constData(), zoneMap.clusteredRows.size());
+    writer.number(quint64(zoneMap.columns.size()));
+    for (const ZoneMap::ColumnZones &zones : zoneMap.columns) {
+        writer.array(zones.minimums.constData(), zones.minimums.size());
+        writer.array(zones.maximums.constData(), zones.maximums.size());
+        writer.array(zones.nullCounts.constData(), zones.nullCounts.size());
+    }
+}
+
+void SnapshotImage::writeJoinIndex(Writer &writer, const ProgramJoinIndex &index)
+{
+    writer.array(index.pairs.constData(), index.pairs.size());
+    writer.array(index.pairIndexesByProgramCode.constData(), index.pairIndexesByProgramCode.size());
+    writer.array(index.pairIndexByRegularRow.constData(), index.pairIndexByRegularRow.size());
+    writer.array(index.pairIndexByAdditionalRow.constData(), index.pairIndexByAdditionalRow.size());
+}
+
+QString SnapshotImage::readHeader(Reader &reader)
+{
+    if (!reader.raw(magic, sizeof(magic)) || reader.number() != byteOrderMark)
+        return {};
+    return reader.string();
+}
+
+QString SnapshotImage::fileStampOf(const QString &imagePath)
+{
+    QFile file(imagePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    // The stamp is a few dozen bytes; the header never needs the whole file
+    const QByteArray head = file.read(4096);
+    Reader reader(reinterpret_cast<const uchar *>(head.constData()), head.size());
+    const QString stamp = readHeader(reader);
+    return reader.ok ? stamp : QString();
+}
+
+std::optional<SnapshotImage::Contents> SnapshotImage::attach(const QString &imagePath, const QString &fileStamp)
+{
+    std::shared_ptr<SnapshotImage> image(new SnapshotImage());
+    image->file.setFileName(imagePath);
+    if (!image->file.open(QIODevice::ReadOnly))
+        return std::nullopt;
+    image->mappedSize = image->file.size();
+    image->mapped = image->mappedSize > 0 ? image->file.map(0, image->mappedSize) : nullptr;
+    if (!image->mapped) {
+        qWarning() << "[SnapshotImage] Image could not be mapped:" << imagePath << image->file.errorString();
+        return std::nullopt;
+    }
+
+    Reader reader(image->mapped, image->mappedSize);
+    const QString stamp = readHeader(reader);
+    if (!reader.ok) {
+        qWarning() << "[SnapshotImage] Not a snapshot image of this format:" << imagePath;
+        return std::nullopt;
+    }
+    if (stamp != fileStamp) {
+        qDebug() << "[SnapshotImage] Image" << imagePath << "belongs to another version of the database";
+        return std::nullopt;
+    }
+
+    Contents contents;
+    const quint64 present = reader.number();
+    auto readIndexedDataset = [&](std::shared_ptr<const ProgramDataset> &dataset,
+                                  std::shared_ptr<const ScoreIndex> &scoreIndex,
+                                  std::shared_ptr<const BitmapIndex> &bitmapIndex,
+                                  std::shared_ptr<const ZoneMap> &zoneMap) {
+        dataset = readDataset(reader, image);
+        // Past a malformed dataset the offsets mean nothing
+        if (!dataset) {
+            reader.ok = false;
+            return;
+        }
+        scoreIndex = readScoreIndex(reader, *dataset, image);
+        bitmapIndex = scoreIndex ? readBitmapIndex(reader, *dataset, image) : nullptr;
+        zoneMap = bitmapIndex ? readZoneMap(reader, *dataset, image) : nullptr;
+        if (!zoneMap)
+            reader.ok = false;
+    };
+    if (present & regularPresent)
+        readIndexedDataset(contents.regularDataset, contents.regularScoreIndex, contents.regularBitmapIndex,
+                           contents.regularZoneMap);
+    if (present & additionalPresent)
+        readIndexedDataset(contents.additionalDataset, contents.additionalScoreIndex,
+                           contents.additionalBitmapIndex, contents.additionalZoneMap);
+    if ((present & joinIndexPresent) && reader.ok && contents.regularDataset && contents.additionalDataset) {
+        contents.programJoinIndex = readJoinIndex(reader, *contents.regularDataset, *contents.additionalDataset,
+                                                  image);
+        if (!contents.programJoinIndex)
+            reader.ok = false;
+    }
+
+    const quint64 universityCount = reader.number();
+    for (quint64 i = 0; reader.ok && i < universityCount; ++i) {
+        University university;
+        university.id = int(qint64(reader.number()));
+        university.name = reader.string();
+        contents.universities.append(university);
+    }
+    const quint64 departmentCount = reader.number();
+    for (quint64 i = 0; reader.ok && i < departmentCount; ++i)
+        contents.departments.append(reader.string());
+
+    if (!reader.ok || !contents.regularDataset
+        || ((present & additionalPresent) && !contents.additionalDataset)) {
+        qWarning() << "[SnapshotImage] Image is truncated or malformed:" << imagePath;
+        return std::nullopt;
+    }
+    contents.mappedBytes = image->mappedSize;
+    return contents;
+}
+
+std::shared_ptr<const ProgramDataset> SnapshotImage::readDataset(Reader &reader,
+                                                                 const std::shared_ptr<const SnapshotImage> &image)
+{
+    auto dataset = std::make_shared<ProgramDataset>();
+    dataset->image = image;
+    dataset->table = reader.string();
+    dataset->rowIds = reader.array<qint64>();
+    dataset->rowsByRowId = reader.array<int>();
+    const qsizetype rowCount = dataset->rowIds.size();
+    if (!reader.ok || dataset->rowsByRowId.size() != rowCount)
+        return nullptr;
+    for (int row : dataset->rowsByRowId) {
+        if (row < 0 || row >= rowCount)
+            return nullptr;
+    }
+
+    const quint64 columnCount = reader.number();
+    for (quint64 i = 0; reader.ok && i < columnCount; ++i) {
+        ProgramDataset::Column column;
+        column.name = reader.string();
+        const quint64 flags = reader.number();
+        column.isText = flags & textFlag;
+        column.isInteger = flags & integerFlag;
+        column.rankCount = quint32(reader.number());
+        if (column.isText) {
+            column.codes = reader.array<quint32>();
+            const quint64 dictionarySize = reader.number();
+            for (quint64 entry = 0; reader.ok && entry < dictionarySize; ++entry)
+                column.dictionary.append(reader.rawString());
+            for (quint64 entry = 0; reader.ok && entry < dictionarySize; ++entry)
+                column.foldedDictionary.append(reader.rawString());
+            // A code past the dictionary would read outside it on every access
+            for (quint32 code : column.codes) {
+                if (code != ProgramDataset::nullCode && code >= dictionarySize)
+                    return nullptr;
+            }
+            if (column.codes.size() != rowCount)
+                return nullptr;
+        } else {
+            column.numbers = reader.array<double>();
+            if (column.numbers.size() != rowCount)
+                return nullptr;
+        }
+        column.ranks = reader.array<quint32>();
+        if (!reader.ok || column.ranks.size() != rowCount)
+            return nullptr;
+        // Sorters index buckets of rankCount entries by rank
+        for (quint32 rank : column.ranks) {
+            if (rank >= column.rankCount)
+                return nullptr;
+        }
+
+        dataset->columnIndexByName.insert(column.name, dataset->columns.size());
+        dataset->columns.append(column);
+    }
+    return reader.ok ? dataset : nullptr;
+}
+
+std::shared_ptr<const ScoreIndex> SnapshotImage::readScoreIndex(Reader &reader, const ProgramDataset &dataset,
+                                                                const std::shared_ptr<const SnapshotImage> &image)
+{
+    auto index = std::make_shared<ScoreIndex>();
+    index->image = image;
+    const quint64 trackCount = reader.number();
+    for (quint64 i = 0; reader.ok && i < trackCount; ++i) {
+        const QString trackName = reader.string();
+        ScoreIndex::EntriesByQuota &entriesByQuota = index->entriesByTrack[trackName];
+        for (ColumnArray<ScoreIndex::Entry> &entries : entriesByQuota) {
+            entries = reader.array<ScoreIndex::Entry>();
+            for (const ScoreIndex::Entry &entry : entries) {
+                if (entry.row < 0 || entry.row >= dataset.rowCount())
+                    return nullptr;
+            }
+        }
+    }
+    return reader.ok ? index : nullptr;
+}
+
+std::shared_ptr<const BitmapIndex> SnapshotImage::readBitmapIndex(Reader &reader, const ProgramDataset &dataset,
+                                                                  const std::shared_ptr<const SnapshotImage> &image)
+{
+    auto index = std::make_shared<BitmapIndex>();
+    index->image = image;
+    index->rowCount = int(reader.number());
+    if (!reader.ok || index->rowCount != dataset.rowCount())
+        return nullptr;
+    for (QHash<QString, ColumnArray<quint64>> *bitmaps : { &index->bitmapsByValue, &index->notNullBitmaps }) {
+        const quint64 bitmapCount = reader.number();
+        for (quint64 i = 0; reader.ok && i < bitmapCount; ++i) {
+            const QString key = reader.string();
+            const ColumnArray<quint64> flat = reader.array<quint64>();
+            // Lookups unpack the bitmap again; checking it once here keeps their rows inside the dataset
+            if (!reader.ok || !RowBitmap::fromFlat(flat, index->rowCount))
+                return nullptr;
+            bitmaps->insert(key, flat);
+        }
+    }
+    return reader.ok ? index : nullptr;
+}
+
+std::shared_ptr<const ZoneMap> SnapshotImage::readZoneMap(Reader &reader, const ProgramDataset &dataset,
+                                                          const std::shared_ptr<const SnapshotImage> &image)
+{
+    auto zoneMap = std::make_shared<ZoneMap>();
+    zoneMap->image = image;
+    zoneMap->blockSize = int(reader.number());
+    zoneMap->rowCount = int(reader.number());
+    zoneMap->clusteredRows = reader.array<int>();
+    if (!reader.ok || zoneMap->blockSize < 1 || zoneMap->rowCount != dataset.rowCount()
+        || zoneMap->clusteredRows.size() != zoneMap->rowCount)
+        return nullptr;
+    for (int row : zoneMap->clusteredRows) {
+        if (row < 0 || row >= zoneMap->rowCount)
+            return nullptr;
+    }
+
+    const quint64 columnCount = reader.number();
+    if (!reader.ok || columnCount != quint64(dataset.columnCount()))
+        return nullptr;
+    const qsizetype blocks = zoneMap->blockCount();
+    zoneMap->columns.resize(dataset.columnCount());
+    for (ZoneMap::ColumnZones &zones : zoneMap->columns) {
+        zones.minimums = reader.array<double>();
+        zones.maximums = reader.array<double>();
+        zones.nullCounts = reader.array<int>();
+        // Text columns have no zones; the others one entry per block
+        const qsizetype size = zones.minimums.size();
+        if (!reader.ok || (size != 0 && size != blocks) || zones.maximums.size() != size
+            || zones.nullCounts.size() != size)
+            return nullptr;
+    }
+    return zoneMap;
+}
+
+std::shared_ptr<const ProgramJoinIndex> SnapshotImage::readJoinIndex(Reader &reader, const ProgramDataset &regular,
+                                                                     const ProgramDataset &additional,
+                                                                     const std::shared_ptr<const SnapshotImage> &image)
+{
+    auto index = std::make_shared<ProgramJoinIndex>();
+    index->image = image;
+    index->pairs = reader.array<ProgramJoinIndex::Pair>();
+    index->pairIndexesByProgramCode = reader.array<int>();
+    index->pairIndexByRegularRow = reader.array<int>();
+    index->pairIndexByAdditionalRow = reader.array<int>();
+    if (!reader.ok || index->pairIndexByRegularRow.size() != regular.rowCount()
+        || index->pairIndexByAdditionalRow.size() != additional.rowCount())
+        return nullptr;
+
+    const int pairCount = int(index->pairs.size());
+    for (const ProgramJoinIndex::Pair &pair : index->pairs) {
+        if (pair.regularRow < -1 || pair.regularRow >= regular.rowCount()
+            || pair.additionalRow < -1 || pair.additionalRow >= additional.rowCount())
+            return nullptr;
+    }
+    for (const ColumnArray<int> &pairIndexes : { index->pairIndexByRegularRow, index->pairIndexByAdditionalRow }) {
+        for (int pairIndex : pairIndexes) {
+            if (pairIndex < -1 || pairIndex >= pairCount)
+                return nullptr;
+        }
+    }
+    // Binary searched by ProgramKodu
+    qint64 previousCode = -1;
+    for (int pairIndex : index->pairIndexesByProgramCode) {
+        if (pairIndex < 0 || pairIndex >= pairCount || index->pairs[pairIndex].programCode < previousCode)
+            return nullptr;
+        previousCode = index->pairs[pairIndex].programCode;
+    }
+    return index;
+}
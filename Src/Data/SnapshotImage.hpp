@@ -0,0 +1,92 @@
+/*
+SnapshotImage class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <memory>
+#include <optional>
+#include "../DataTypeDefinitions.hpp"
+#include "ProgramDataset.hpp"
+#include "ScoreIndex.hpp"
+#include "BitmapIndex.hpp"
+#include "ZoneMap.hpp"
+#include "ProgramJoinIndex.hpp"
+
+class DatasetSnapshot;
+
+// A snapshot's datasets (columns, dictionaries, ranks), their indexes and the
+// lookup lists laid out in one file next to the database (<database>.snapshot)
+// so that several back-end processes on a host share them. One process loads from SQLite and
+// writes the image; the others map it read-only and their datasets point into
+// the mapping, so the pages are shared through the page cache instead of
+// being copied per process. Offsets are relative to the start of the file and
+// every array is 8-byte aligned; the image is only valid on a host of the
+// same byte order and is stamped with the database's file stamp.
+class SnapshotImage
+{
+public:
+    struct Contents {
+        std::shared_ptr<const ProgramDataset> regularDataset;
+        std::shared_ptr<const ProgramDataset> additionalDataset; // null when the table was not loaded
+        std::shared_ptr<const ScoreIndex> regularScoreIndex;
+        std::shared_ptr<const ScoreIndex> additionalScoreIndex;
+        std::shared_ptr<const BitmapIndex> regularBitmapIndex;
+        std::shared_ptr<const BitmapIndex> additionalBitmapIndex;
+        std::shared_ptr<const ZoneMap> regularZoneMap;
+        std::shared_ptr<const ZoneMap> additionalZoneMap;
+        std::shared_ptr<const ProgramJoinIndex> programJoinIndex; // null without the additional dataset
+        QList<University> universities;
+        QList<QString> departments;
+        qint64 mappedBytes = 0;
+    };
+
+    ~SnapshotImage();
+    SnapshotImage(const SnapshotImage &) = delete;
+    SnapshotImage &operator=(const SnapshotImage &) = delete;
+
+    static QString imagePathFor(const QString &databasePath);
+    // Replaces the image atomically; processes still mapping the old one keep reading it
+    static bool write(const DatasetSnapshot &snapshot, const QString &imagePath);
+    // Reads only the header; empty when the file is missing or malformed
+    static QString fileStampOf(const QString &imagePath);
+    // Empty when the file is missing, malformed or stamped for another database file
+    static std::optional<Contents> attach(const QString &imagePath, const QString &fileStamp);
+
+private:
+    class Writer;
+    class Reader;
+
+    SnapshotImage() = default;
+    static void writeDataset(Writer &writer, const ProgramDataset &dataset);
+    static void writeScoreIndex(Writer &writer, const ScoreIndex &index);
+    static void writeBitmapIndex(Writer &writer, const BitmapIndex &index);
+    static void writeZoneMap(Writer &writer, const ZoneMap &zoneMap);
+    static void writeJoinIndex(Writer &writer, const ProgramJoinIndex &index);
+    // The stamp, or empty when the header is not one of this format
+    static QString readHeader(Reader &reader);
+    static std::shared_ptr<const ProgramDataset> readDataset(Reader &reader,
+                                                             const std::shared_ptr<const SnapshotImage> &image);
+    // Index readers check every row and position against the dataset they were built from
+    static std::shared_ptr<const ScoreIndex> readScoreIndex(Reader &reader, const ProgramDataset &dataset,
+                                                            const std::shared_ptr<const SnapshotImage> &image);
+    static std::shared_ptr<const BitmapIndex> readBitmapIndex(Reader &reader, const ProgramDataset &dataset,
+                                                              const std::shared_ptr<const SnapshotImage> &image);
+    static std::shared_ptr<const ZoneMap> readZoneMap(Reader &reader, const ProgramDataset &dataset,
+                                                      const std::shared_ptr<const SnapshotImage> &image);
+    static std::shared_ptr<const ProgramJoinIndex> readJoinIndex(Reader &reader, const ProgramDataset &regular,
+                                                                 const ProgramDataset &additional,
+                                                                 const std::shared_ptr<const SnapshotImage> &image);
+
+    QFile file;
+    const uchar *mapped = nullptr;
+    qint64 mappedSize = 0;
+};
@@ -0,0 +1,216 @@
+/*
+YearCatalog class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "YearCatalog.hpp"
+#include <QDir>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include "../QueryBuilder.hpp"
+
+namespace {
+const QRegularExpression yearSchemaPattern("^y\\d{4}$");
+
+template <typename T>
+std::optional<T> optionalValue(const QVariant &value)
+{
+    if (value.isNull())
+        return std::nullopt;
+    return value.value<T>();
+}
+}
+
+YearCatalog::YearCatalog(const QString &databaseDirectory)
+    : directory(databaseDirectory)
+{
+}
+
+void YearCatalog::setDatabaseDirectory(const QString &databaseDirectory)
+{
+    QMutexLocker locker(&mutex);
+    directory = databaseDirectory;
+    yearIndexes.clear();
+    indexBuildMilliseconds = 0;
+}
+
+void YearCatalog::clearIndexes()
+{
+    QMutexLocker locker(&mutex);
+    yearIndexes.clear();
+    indexBuildMilliseconds = 0;
+}
+
+qint64 YearCatalog::estimatedMemoryBytes() const
+{
+    QMutexLocker locker(&mutex);
+    qint64 bytes = 0;
+    for (const std::shared_ptr<const YearIndex> &index : yearIndexes)
+        bytes += sizeof(YearIndex)
+                 + index->recordsByProgramCode.capacity() * qint64(sizeof(qint64) + sizeof(ProgramYearRecord));
+    return bytes;
+}
+
+double YearCatalog::getIndexBuildMilliseconds() const
+{
+    QMutexLocker locker(&mutex);
+    return indexBuildMilliseconds;
+}
+
+QList<int> YearCatalog::getAvailableYears() const
+{
+    static const QRegularExpression pattern("^YKS_(\\d{4})\\.sqlite$");
+    QList<int> years;
+    for (const QString &fileName : QDir(directory).entryList({ "YKS_*.sqlite" }, QDir::Files)) {
+        const QRegularExpressionMatch match = pattern.match(fileName);
+        if (match.hasMatch())
+            years << match.captured(1).toInt();
+    }
+    std::sort(years.begin(), years.end());
+    return years;
+}
+
+QString YearCatalog::databasePathForYear(int year) const
+{
+    return QDir(directory).filePath(QString("YKS_%1.sqlite").arg(year));
+}
+
+bool YearCatalog::ensureAttached(const QSqlDatabase &db, int year) const
+{
+    const QString schema = QueryBuilder::yearSchemaName(year);
+
+    // Listed in the order they were attached
+    QStringList attachedYears;
+    QSqlQuery query(db);
+    if (query.exec("PRAGMA database_list")) {
+        while (query.next()) {
+            const QString name = query.value(1).toString();
+            if (name == schema)
+                return true;
+            if (yearSchemaPattern.match(name).hasMatch())
+                attachedYears << name;
+        }
+    }
+
+    const QString path = databasePathForYear(year);
+    if (!QFileInfo::exists(path)) {
+        qWarning() << "[YearCatalog] No database for year" << year << "at" << path;
+        return false;
+    }
+
+    // Every attached year keeps a schema and page cache of its own
+    while (attachedYears.size() >= maximumAttachedYears) {
+        const QString oldest = attachedYears.takeFirst();
+        if (!query.exec(QString("DETACH DATABASE %1").arg(oldest)))
+            qWarning() << "[YearCatalog] DETACH failed for" << oldest << ":" << query.lastError().text();
+    }
+
+    query.prepare(QString("ATTACH DATABASE ? AS %1").arg(schema));
+    query.addBindValue(path);
+    if (!query.exec()) {
+        qWarning() << "[YearCatalog] ATTACH failed for year" << year << ":" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const YearCatalog::YearIndex> YearCatalog::getYearIndex(int year)
+{
+    {
+        QMutexLocker locker(&mutex);
+        const auto it = yearIndexes.constFind(year);
+        if (it != yearIndexes.constEnd())
+            return it.value();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Read on a connection of its own, so nothing of the year stays attached anywhere
+    static std::atomic_int connectionSerial{0};
+    const QString connectionName = QString("year-index-%1-%2").arg(year).arg(++connectionSerial);
+    std::shared_ptr<YearIndex> index;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        db.setDatabaseName(databasePathForYear(year));
+        db.setConnectOptions("QSQLITE_OPEN_READONLY");
+        if (!db.open()) {
+            qWarning() << "[YearCatalog] Database for year" << year << "could not be opened:" << db.lastError().text();
+        } else {
+            QSqlQuery query(db);
+            query.setForwardOnly(true);
+            if (!query.exec("SELECT ProgramKodu, GenelEnKucukPuan, GenelEnBuyukPuan, GenelKontenjan, GenelYerlesen "
+                            "FROM YKS")) {
+                qWarning() << "[YearCatalog] Join index query failed for year" << year << ":"
+                           << query.lastError().text();
+            } else {
+                index = std::make_shared<YearIndex>();
+                while (query.next()) {
+                    ProgramYearRecord record;
+                    record.year = year;
+                    record.minimumScore = optionalValue<double>(query.value(1));
+                    record.maximumScore = optionalValue<double>(query.value(2));
+                    record.quota = optionalValue<int>(query.value(3));
+                    record.placed = optionalValue<int>(query.value(4));
+                    index->recordsByProgramCode.insert(query.value(0).toLongLong(), record);
+                }
+                if (query.lastError().isValid()) {
+                    qWarning() << "[YearCatalog] Join index query failed for year" << year << ":"
+                               << query.lastError().text();
+                    index.reset();
+                }
+            }
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    if (!index)
+        return nullptr;
+    qDebug() << "[YearCatalog] Join index for" << year << "built with"
+             << index->recordsByProgramCode.size() << "programs in" << timer.elapsed() << "ms";
+
+    QMutexLocker locker(&mutex);
+    yearIndexes.insert(year, index);
+    indexBuildMilliseconds += timer.elapsed();
+    return index;
+}
+
+std::optional<QVector<ProgramYearRecord>> YearCatalog::getProgramTrend(qint64 programCode, int fromYear, int toYear)
+{
+    const std::optional<QHash<qint64, QVector<ProgramYearRecord>>> trends
+        = getProgramTrends({ programCode }, fromYear, toYear);
+    if (!trends)
+        return std::nullopt;
+    return trends->value(programCode);
+}
+
+std::optional<QHash<qint64, QVector<ProgramYearRecord>>> YearCatalog::getProgramTrends(
+    const QVector<qint64> &programCodes, int fromYear, int toYear)
+{
+    QHash<qint64, QVector<ProgramYearRecord>> trends;
+    for (int year : getAvailableYears()) {
+        if (year < fromYear || year > toYear)
+            continue;
+        // A trend with a year silently missing would read as a gap in the data
+        const std::shared_ptr<const YearIndex> index = getYearIndex(year);
+        if (!index)
+            return std::nullopt;
+        for (qint64 programCode : programCodes) {
+            const auto it = index->recordsByProgramCode.constFind(programCode);
+            if (it != index->recordsByProgramCode.constEnd())
+                trends[programCode].append(it.value());
+        }
+    }
+    return trends;
+}
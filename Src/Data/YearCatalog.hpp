@@ -0,0 +1,67 @@
+/*
+YearCatalog class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include <optional>
+#include "../DataTypeDefinitions.hpp"
+
+// Per-year databases (Databases/YKS_<year>.sqlite). A year costs nothing until
+// it is queried: a filter on the year ATTACHes its file to the querying
+// connection, and the first trend query touching it builds its ProgramKodu
+// join index on a connection of its own that is closed right after.
+class YearCatalog
+{
+public:
+    explicit YearCatalog(const QString &databaseDirectory = QString());
+
+    void setDatabaseDirectory(const QString &databaseDirectory);
+    // Drops the join indexes; year files may have been replaced along with a new snapshot
+    void clearIndexes();
+    // Join indexes built so far
+    qint64 estimatedMemoryBytes() const;
+    // Time it took to build them
+    double getIndexBuildMilliseconds() const;
+    QList<int> getAvailableYears() const;
+    QString databasePathForYear(int year) const;
+
+    // ATTACHes the year's file as y<year> unless that connection already has
+    // it. At most maximumAttachedYears stay attached per connection; the year
+    // attached longest ago is DETACHed to make room.
+    bool ensureAttached(const QSqlDatabase &db, int year) const;
+
+    // Regular placement records of programs across [fromYear, toYear]. Years
+    // without a file are not part of the range; empty when an existing year
+    // could not be read, rather than a trend with that year missing.
+    std::optional<QVector<ProgramYearRecord>> getProgramTrend(qint64 programCode, int fromYear, int toYear);
+    std::optional<QHash<qint64, QVector<ProgramYearRecord>>> getProgramTrends(const QVector<qint64> &programCodes,
+                                                                              int fromYear, int toYear);
+
+    // Below SQLite's default limit of ten attached databases
+    static constexpr int maximumAttachedYears = 4;
+
+private:
+    struct YearIndex {
+        QHash<qint64, ProgramYearRecord> recordsByProgramCode;
+    };
+
+    std::shared_ptr<const YearIndex> getYearIndex(int year);
+
+    QString directory;
+    mutable QMutex mutex;
+    QHash<int, std::shared_ptr<const YearIndex>> yearIndexes;
+    double indexBuildMilliseconds = 0;
+};
@@ -0,0 +1,122 @@
+/*
+ZoneMap class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ZoneMap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include "RankSorter.hpp"
+
+std::shared_ptr<const ZoneMap> ZoneMap::build(const ProgramDataset &dataset, const QString &clusterColumn,
+                                              int blockSize)
+{
+    auto zoneMap = std::make_shared<ZoneMap>();
+    zoneMap->blockSize = std::max(1, blockSize);
+    zoneMap->rowCount = dataset.rowCount();
+
+    QVector<int> &clusteredRows = zoneMap->clusteredRowStorage;
+    clusteredRows.resize(dataset.rowCount());
+    std::iota(clusteredRows.begin(), clusteredRows.end(), 0);
+    const int cluster = dataset.columnIndex(clusterColumn);
+    if (cluster >= 0)
+        RankSorter::sortRows(clusteredRows, dataset.ranks(cluster), dataset.rankCount(cluster));
+    zoneMap->clusteredRows = clusteredRows;
+
+    const int blocks = zoneMap->blockCount();
+    zoneMap->columns.resize(dataset.columnCount());
+    for (int column = 0; column < dataset.columnCount(); ++column) {
+        if (dataset.isTextColumn(column))
+            continue;
+
+        ColumnZones &zones = zoneMap->columns[column];
+        QVector<double> &minimums = zones.minimumStorage;
+        QVector<double> &maximums = zones.maximumStorage;
+        QVector<int> &nullCounts = zones.nullCountStorage;
+        minimums.fill(std::numeric_limits<double>::quiet_NaN(), blocks);
+        maximums.fill(std::numeric_limits<double>::quiet_NaN(), blocks);
+        nullCounts.fill(0, blocks);
+        for (int i = 0; i < clusteredRows.size(); ++i) {
+            const int block = i / zoneMap->blockSize;
+            const double value = dataset.number(column, clusteredRows[i]);
+            if (std::isnan(value)) {
+                ++nullCounts[block];
+                continue;
+            }
+            // fmin/fmax ignore the NaN the bounds start with
+            minimums[block] = std::fmin(minimums[block], value);
+            maximums[block] = std::fmax(maximums[block], value);
+        }
+        zones.minimums = minimums;
+        zones.maximums = maximums;
+        zones.nullCounts = nullCounts;
+    }
+    return zoneMap;
+}
+
+bool ZoneMap::mayMatch(int block, const Range &range) const
+{
+    if (range.column < 0)
+        return false;
+    if (range.column >= columns.size() || columns[range.column].minimums.isEmpty())
+        return true; // text column, nothing to prune with
+
+    const ColumnZones &zones = columns[range.column];
+    if (std::isnan(zones.minimums[block]))
+        return false; // only NULLs in the block
+    if (range.minimum.has_value() && zones.maximums[block] < *range.minimum)
+        return false;
+    if (range.maximum.has_value() && zones.minimums[block] > *range.maximum)
+        return false;
+    return true;
+}
+
+QVector<int> ZoneMap::candidateRows(const QVector<Range> &ranges, int *blocksSkipped) const
+{
+    int skipped = 0;
+    QVector<int> rows;
+    for (int block = 0; block < blockCount(); ++block) {
+        const bool keep = std::all_of(ranges.cbegin(), ranges.cend(),
+                                      [&](const Range &range) { return mayMatch(block, range); });
+        if (!keep) {
+            ++skipped;
+            continue;
+        }
+        const int begin = block * blockSize;
+        const int end = std::min(begin + blockSize, int(clusteredRows.size()));
+        for (int i = begin; i < end; ++i)
+            rows.append(clusteredRows[i]);
+    }
+    std::sort(rows.begin(), rows.end());
+
+    if (blocksSkipped)
+        *blocksSkipped = skipped;
+    return rows;
+}
+
+int ZoneMap::blockCount() const
+{
+    return (rowCount + blockSize - 1) / blockSize;
+}
+
+int ZoneMap::getBlockSize() const
+{
+    return blockSize;
+}
+
+qint64 ZoneMap::estimatedMemoryBytes() const
+{
+    qint64 bytes = sizeof(*this) + clusteredRowStorage.capacity() * qint64(sizeof(int))
+                   + columns.capacity() * qint64(sizeof(ColumnZones));
+    for (const ColumnZones &zones : columns)
+        bytes += (zones.minimumStorage.capacity() + zones.maximumStorage.capacity()) * qint64(sizeof(double))
+                 + zones.nullCountStorage.capacity() * qint64(sizeof(int));
+    return bytes;
+}
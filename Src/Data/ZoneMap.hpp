@@ -0,0 +1,66 @@
+/*
+ZoneMap class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QString>
+#include <QVector>
+#include <memory>
+#include <optional>
+#include "ProgramDataset.hpp"
+
+// Per-block minimum, maximum and null count of every numeric column. Blocks
+// are cut from the rows clustered by one column (GenelEnKucukPuan by default),
+// so range predicates on that column, and on the correlated GenelEnBuyukPuan,
+// skip all but a few blocks. An attached index reads its arrays from the
+// mapped SnapshotImage.
+class ZoneMap
+{
+public:
+    // Inclusive bounds on a dataset column; NULL never satisfies a range
+    struct Range {
+        int column = -1;
+        std::optional<double> minimum;
+        std::optional<double> maximum;
+    };
+
+    static std::shared_ptr<const ZoneMap> build(const ProgramDataset &dataset,
+                                                const QString &clusterColumn = "GenelEnKucukPuan",
+                                                int blockSize = 256);
+
+    // Rows of the blocks that may satisfy every range, ascending. Without
+    // ranges every row is returned.
+    QVector<int> candidateRows(const QVector<Range> &ranges, int *blocksSkipped = nullptr) const;
+
+    int blockCount() const;
+    int getBlockSize() const;
+    qint64 estimatedMemoryBytes() const;
+
+private:
+    friend class SnapshotImage;
+
+    struct ColumnZones {
+        ColumnArray<double> minimums; // NaN for all-NULL blocks
+        ColumnArray<double> maximums;
+        ColumnArray<int> nullCounts;
+        // Backing of the arrays above for a zone map built in this process
+        QVector<double> minimumStorage;
+        QVector<double> maximumStorage;
+        QVector<int> nullCountStorage;
+    };
+
+    bool mayMatch(int block, const Range &range) const;
+
+    int blockSize = 256;
+    int rowCount = 0;
+    ColumnArray<int> clusteredRows; // dataset rows in cluster order
+    QVector<ColumnZones> columns;   // by dataset column; empty for text columns
+    QVector<int> clusteredRowStorage;
+    std::shared_ptr<const void> image; // keeps an attached image mapped
+};
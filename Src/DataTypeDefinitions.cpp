@@ -10,3 +10,19 @@ You should have received a copy of the GNU General Public License along with thi
 */
 
 #include "DataTypeDefinitions.hpp"
+#include "ProgramTableColumnDefinitions.hpp"
+
+QList<SortKey> OrderParameters::sortKeys() const
+{
+    // Columns the schema does not mark sortable are dropped here, so the SQL
+    // order, the rank sort and the cache key all see the same keys
+    QList<SortKey> sortable;
+    if (!keys.isEmpty()) {
+        for (const SortKey &key : keys)
+            if (ProgramTableColumns::isSortable(key.column))
+                sortable.append(key);
+    } else if (toBeOrdered && ProgramTableColumns::isSortable(column)) {
+        sortable.append(SortKey{column, direction});
+    }
+    return sortable;
+}
@@ -12,6 +12,8 @@ You should have received a copy of the GNU General Public License along with thi
 #include <QObject>
 #include <QString>
 #include <QMap>
+#include <QList>
+#include <optional>
 
 struct University {
     int id;
@@ -79,10 +81,21 @@ enum class PlacementType {
 
 enum class ProgramTableColumn : int;
 
+struct SortKey {
+    ProgramTableColumn column;
+    Qt::SortOrder direction = Qt::SortOrder::AscendingOrder;
+};
+
 struct OrderParameters {
     ProgramTableColumn column;
     Qt::SortOrder direction = Qt::SortOrder::AscendingOrder;
     bool toBeOrdered = false;
+    // Multi-key sort specification. When not empty it takes precedence over
+    // column/direction; ProgramKodu always breaks the remaining ties.
+    QList<SortKey> keys;
+
+    // The effective keys, without columns the schema marks unsortable
+    QList<SortKey> sortKeys() const;
 };
 
 struct AcademyScopeParameters {
@@ -97,16 +110,30 @@ struct AcademyScopeParameters {
     SelectedQuotaTypes selectedQuotaTypes;
     SelectedTuitionFeeTypes selectedTuitionFeeTypes;
     OrderParameters order;
-    Interval regularQuotaInterval,
-        highSchoolValedictoriansQuotaInterval,
-        women34PlusQuotaInterval,
-        earthquakeVictimsQuotaInterval,
-        martyrsAndVeteransQuotaInterval,
-        trncNationalsQuotaInterval;
+    // Quota size ranges (seat counts); unbounded unless set
+    Interval regularQuotaInterval{std::nullopt, std::nullopt},
+        highSchoolValedictoriansQuotaInterval{std::nullopt, std::nullopt},
+        women34PlusQuotaInterval{std::nullopt, std::nullopt},
+        earthquakeVictimsQuotaInterval{std::nullopt, std::nullopt},
+        martyrsAndVeteransQuotaInterval{std::nullopt, std::nullopt},
+        trncNationalsQuotaInterval{std::nullopt, std::nullopt};
+    // Placement year; the bundled YKS.sqlite when unset, Databases/YKS_<year>.sqlite otherwise
+    std::optional<int> year;
+    // When positive only the first topK rows in order are materialized; the
+    // total row count follows once it is known
+    int topK = 0;
+};
+
+struct ProgramYearRecord {
+    int year = 0;
+    std::optional<double> minimumScore;  // GenelEnKucukPuan
+    std::optional<double> maximumScore;  // GenelEnBuyukPuan
+    std::optional<int> quota;            // GenelKontenjan
+    std::optional<int> placed;           // GenelYerlesen
 };
 
 struct DataWindow {
-    int windowSize = 300;
+    int windowSize = 300; // until the viewport height and fetch cost are known
     int beginningIndex = 0;
     int endingIndex = 0;
     int tableRowCount = 0;
@@ -0,0 +1,69 @@
+/*
+LookupLists class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "LookupLists.hpp"
+#include <QSqlQuery>
+#include <QCollator>
+#include <QLocale>
+#include <algorithm>
+
+QList<University> LookupLists::loadUniversities(const QSqlDatabase &db) {
+    QSqlQuery query(db);
+    QList<University> universities;
+
+    if (query.exec("SELECT UniversiteID, UniversiteAdi FROM Universiteler")) {
+        while (query.next()) {
+            University university;
+            university.id = query.value(0).toInt();
+            university.name = query.value(1).toString();
+            universities.append(university);
+        }
+    }
+
+    // Sorts with Turkish collator
+    QCollator collator(QLocale(QLocale::Turkish, QLocale::Turkey));
+    std::sort(universities.begin(), universities.end(),
+              [&](const University &a, const University &b) {
+                  return collator.compare(a.name, b.name) < 0;
+              });
+
+    return universities;
+}
+
+QList<QString> LookupLists::loadDepartments(const QSqlDatabase &db) {
+    QSqlQuery query(db);
+    QList<QString> departments;
+
+    QString selectionQuery = "SELECT DISTINCT\n\
+        TRIM(\n\
+            CASE\n\
+                WHEN instr(ProgramAdi, '(') > 0\n\
+            THEN substr(ProgramAdi, 1, instr(ProgramAdi, '(') - 1)\n\
+            ELSE ProgramAdi\n\
+                END\n\
+            ) AS AnaProgramAdi\n\
+            FROM YKS;\
+           ";
+
+    if (query.exec(selectionQuery)) {
+        while (query.next()) {
+            QString department = query.value(0).toString();
+            departments.append(department);
+        }
+    }
+
+    QCollator collator(QLocale(QLocale::Turkish, QLocale::Turkey));
+    std::sort(departments.begin(), departments.end(),
+              [&](const QString &a, const QString &b) {
+                  return collator.compare(a, b) < 0;
+              });
+
+    return departments;
+}
@@ -0,0 +1,24 @@
+/*
+LookupLists class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QList>
+#include <QString>
+#include <QSqlDatabase>
+#include "DataTypeDefinitions.hpp"
+
+// Universities and department names for the filter combo boxes, sorted with
+// the Turkish collator. Usable from any thread with that thread's connection.
+class LookupLists
+{
+public:
+    static QList<University> loadUniversities(const QSqlDatabase &db);
+    static QList<QString> loadDepartments(const QSqlDatabase &db);
+};
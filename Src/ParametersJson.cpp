@@ -0,0 +1,213 @@
+/*
+ParametersJson class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ParametersJson.hpp"
+#include <QJsonArray>
+#include <algorithm>
+#include "ProgramTableColumnDefinitions.hpp"
+
+namespace {
+template <typename Enum, std::size_t N>
+QString nameOf(Enum value, const std::pair<Enum, const char *> (&names)[N])
+{
+    for (const auto &entry : names)
+        if (entry.first == value)
+            return entry.second;
+    return {};
+}
+
+template <typename Enum, std::size_t N>
+Enum valueOf(const QJsonValue &json, Enum fallback, const std::pair<Enum, const char *> (&names)[N])
+{
+    const QString name = json.toString();
+    for (const auto &entry : names)
+        if (name == QLatin1String(entry.second))
+            return entry.first;
+    return fallback;
+}
+
+const std::pair<PlacementType, const char *> placementTypeNames[] = {
+    { PlacementType::Regular, "regular" },
+    { PlacementType::Additional, "additional" },
+};
+
+const std::pair<UniversityType, const char *> universityTypeNames[] = {
+    { UniversityType::Undefined, "all" },
+    { UniversityType::Government, "government" },
+    { UniversityType::Private, "private" },
+};
+
+const std::pair<TrackType, const char *> trackTypeNames[] = {
+    { TrackType::Undefined, "all" },
+    { TrackType::Science, "SAY" },
+    { TrackType::Humanities, "SOZ" },
+    { TrackType::EqualWeight, "EA" },
+    { TrackType::Language, "DIL" },
+    { TrackType::TYT, "TYT" },
+};
+
+const std::pair<Country, const char *> countryNames[] = {
+    { Country::AllCountries, "all" },
+    { Country::Turkiye, "turkiye" },
+    { Country::Cyprus, "cyprus" },
+    { Country::ForeignCountries, "foreign" },
+};
+
+const std::pair<DegreeType, const char *> degreeTypeNames[] = {
+    { DegreeType::All, "all" },
+    { DegreeType::Bachelor, "bachelor" },
+    { DegreeType::Associate, "associate" },
+};
+
+QJsonValue boundToJson(const std::optional<double> &bound)
+{
+    return bound.has_value() ? QJsonValue(*bound) : QJsonValue(QJsonValue::Null);
+}
+
+// Absent bounds keep their default, explicit nulls clear them
+void boundFromJson(const QJsonObject &object, const QString &key, std::optional<double> &bound)
+{
+    if (!object.contains(key))
+        return;
+    const QJsonValue value = object.value(key);
+    bound = value.isNull() ? std::nullopt : std::optional<double>(value.toDouble());
+}
+
+QJsonObject intervalToJson(const Interval &interval)
+{
+    return QJsonObject{
+        { "min", boundToJson(interval.minimum) },
+        { "max", boundToJson(interval.maximum) },
+    };
+}
+
+void intervalFromJson(const QJsonValue &json, Interval &interval)
+{
+    if (!json.isObject())
+        return;
+    const QJsonObject object = json.toObject();
+    boundFromJson(object, "min", interval.minimum);
+    boundFromJson(object, "max", interval.maximum);
+}
+}
+
+QJsonObject ParametersJson::toJson(const AcademyScopeParameters &parameters)
+{
+    QJsonObject object;
+    object.insert("placementType", nameOf(parameters.placementType, placementTypeNames));
+    object.insert("universityName", parameters.universityName);
+    object.insert("departmentName", parameters.departmentName);
+    object.insert("universityType", nameOf(parameters.universityType, universityTypeNames));
+    object.insert("trackType", nameOf(parameters.trackType, trackTypeNames));
+    object.insert("scoreInterval", intervalToJson(parameters.scoreInterval));
+    object.insert("country", nameOf(parameters.country, countryNames));
+    object.insert("degreeType", nameOf(parameters.degreeType, degreeTypeNames));
+
+    const SelectedQuotaTypes &quotas = parameters.selectedQuotaTypes;
+    object.insert("quotaTypes", QJsonObject{
+        { "regular", quotas.regularQuota },
+        { "martyrsAndVeterans", quotas.martyrsAndVeteransQuota },
+        { "earthquakeVictims", quotas.earthquakeVictimsQuota },
+        { "highSchoolValedictorians", quotas.highSchoolValedictoriansQuota },
+        { "women34Plus", quotas.women34PlusQuota },
+        { "trncNationals", quotas.trncNationalsQuota },
+        { "mtok", quotas.mtokQuota },
+    });
+
+    const SelectedTuitionFeeTypes &tuition = parameters.selectedTuitionFeeTypes;
+    object.insert("tuitionFeeTypes", QJsonObject{
+        { "free", tuition.free },
+        { "discounted", tuition.discounted },
+        { "paid", tuition.paid },
+    });
+
+    QJsonArray order;
+    for (const SortKey &key : parameters.order.sortKeys())
+        order.append(QJsonObject{
+            { "column", int(key.column) },
+            { "descending", key.direction == Qt::DescendingOrder },
+        });
+    object.insert("order", order);
+
+    object.insert("quotaIntervals", QJsonObject{
+        { "regular", intervalToJson(parameters.regularQuotaInterval) },
+        { "highSchoolValedictorians", intervalToJson(parameters.highSchoolValedictoriansQuotaInterval) },
+        { "women34Plus", intervalToJson(parameters.women34PlusQuotaInterval) },
+        { "earthquakeVictims", intervalToJson(parameters.earthquakeVictimsQuotaInterval) },
+        { "martyrsAndVeterans", intervalToJson(parameters.martyrsAndVeteransQuotaInterval) },
+        { "trncNationals", intervalToJson(parameters.trncNationalsQuotaInterval) },
+    });
+    if (parameters.year.has_value())
+        object.insert("year", *parameters.year);
+    if (parameters.topK > 0)
+        object.insert("topK", parameters.topK);
+    return object;
+}
+
+AcademyScopeParameters ParametersJson::fromJson(const QJsonObject &object)
+{
+    AcademyScopeParameters parameters;
+    parameters.country = Country::AllCountries;
+
+    parameters.placementType = valueOf(object.value("placementType"), parameters.placementType, placementTypeNames);
+    parameters.universityName = object.value("universityName").toString();
+    parameters.departmentName = object.value("departmentName").toString();
+    parameters.universityType = valueOf(object.value("universityType"), parameters.universityType, universityTypeNames);
+    parameters.trackType = valueOf(object.value("trackType"), parameters.trackType, trackTypeNames);
+    intervalFromJson(object.value("scoreInterval"), parameters.scoreInterval);
+    parameters.country = valueOf(object.value("country"), parameters.country, countryNames);
+    parameters.degreeType = valueOf(object.value("degreeType"), parameters.degreeType, degreeTypeNames);
+
+    const QJsonObject quotas = object.value("quotaTypes").toObject();
+    SelectedQuotaTypes &selectedQuotas = parameters.selectedQuotaTypes;
+    selectedQuotas.regularQuota = quotas.value("regular").toBool(selectedQuotas.regularQuota);
+    selectedQuotas.martyrsAndVeteransQuota = quotas.value("martyrsAndVeterans").toBool(selectedQuotas.martyrsAndVeteransQuota);
+    selectedQuotas.earthquakeVictimsQuota = quotas.value("earthquakeVictims").toBool(selectedQuotas.earthquakeVictimsQuota);
+    selectedQuotas.highSchoolValedictoriansQuota = quotas.value("highSchoolValedictorians").toBool(selectedQuotas.highSchoolValedictoriansQuota);
+    selectedQuotas.women34PlusQuota = quotas.value("women34Plus").toBool(selectedQuotas.women34PlusQuota);
+    selectedQuotas.trncNationalsQuota = quotas.value("trncNationals").toBool(selectedQuotas.trncNationalsQuota);
+    selectedQuotas.mtokQuota = quotas.value("mtok").toBool(selectedQuotas.mtokQuota);
+
+    const QJsonObject tuition = object.value("tuitionFeeTypes").toObject();
+    SelectedTuitionFeeTypes &selectedTuition = parameters.selectedTuitionFeeTypes;
+    selectedTuition.free = tuition.value("free").toBool(selectedTuition.free);
+    selectedTuition.discounted = tuition.value("discounted").toBool(selectedTuition.discounted);
+    selectedTuition.paid = tuition.value("paid").toBool(selectedTuition.paid);
+
+    for (const QJsonValue &value : object.value("order").toArray()) {
+        const QJsonObject key = value.toObject();
+        const int column = key.value("column").toInt(-1);
+        if (column < int(ProgramTableColumn::ProgramKodu) || column > int(ProgramTableColumn::Kadin34PlusEnKucukPuan))
+            continue;
+        parameters.order.keys.append(SortKey{
+            ProgramTableColumn(column),
+            key.value("descending").toBool() ? Qt::DescendingOrder : Qt::AscendingOrder });
+    }
+    parameters.order.toBeOrdered = !parameters.order.keys.isEmpty();
+    if (parameters.order.toBeOrdered) {
+        parameters.order.column = parameters.order.keys.first().column;
+        parameters.order.direction = parameters.order.keys.first().direction;
+    }
+
+    const QJsonObject quotaIntervals = object.value("quotaIntervals").toObject();
+    intervalFromJson(quotaIntervals.value("regular"), parameters.regularQuotaInterval);
+    intervalFromJson(quotaIntervals.value("highSchoolValedictorians"), parameters.highSchoolValedictoriansQuotaInterval);
+    intervalFromJson(quotaIntervals.value("women34Plus"), parameters.women34PlusQuotaInterval);
+    intervalFromJson(quotaIntervals.value("earthquakeVictims"), parameters.earthquakeVictimsQuotaInterval);
+    intervalFromJson(quotaIntervals.value("martyrsAndVeterans"), parameters.martyrsAndVeteransQuotaInterval);
+    intervalFromJson(quotaIntervals.value("trncNationals"), parameters.trncNationalsQuotaInterval);
+
+    if (object.value("year").isDouble())
+        parameters.year = object.value("year").toInt();
+    if (object.value("topK").isDouble())
+        parameters.topK = std::max(0, object.value("topK").toInt());
+
+    return parameters;
+}
@@ -0,0 +1,22 @@
+/*
+ParametersJson class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QJsonObject>
+#include "DataTypeDefinitions.hpp"
+
+// JSON form of AcademyScopeParameters. Enums are written by name and absent
+// keys keep the struct defaults, so partial objects are valid requests.
+class ParametersJson
+{
+public:
+    static QJsonObject toJson(const AcademyScopeParameters &parameters);
+    static AcademyScopeParameters fromJson(const QJsonObject &object);
+};
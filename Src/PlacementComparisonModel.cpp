@@ -0,0 +1,224 @@
+/*
+PlacementComparisonModel class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "PlacementComparisonModel.hpp"
+#include <QDebug>
+#include <QHash>
+#include <algorithm>
+#include "Data/ProgramFilter.hpp"
+#include "Data/RankSorter.hpp"
+
+PlacementComparisonModel::PlacementComparisonModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+    QList<ProgramTableColumn> compared;
+    for (const ProgramTableColumnSchema &schema : programTableSchema)
+        if (schema.quotaGroup != ColumnTypes::Base && schema.dbName)
+            compared.append(schema.column);
+    rebuildColumns(compared);
+}
+
+void PlacementComparisonModel::setComparedColumns(const QList<ProgramTableColumn> &compared)
+{
+    beginResetModel();
+    rebuildColumns(compared);
+    endResetModel();
+}
+
+void PlacementComparisonModel::rebuildColumns(const QList<ProgramTableColumn> &compared)
+{
+    columns.clear();
+    for (const ProgramTableColumnSchema &schema : programTableSchema)
+        if (schema.quotaGroup == ColumnTypes::Base)
+            columns.append(Column{schema.column, true, PlacementType::Regular});
+    for (ProgramTableColumn column : compared) {
+        if (!ProgramTableColumns::isStored(column) || ProgramTableColumns::schema(column).quotaGroup == ColumnTypes::Base)
+            continue;
+        columns.append(Column{column, false, PlacementType::Regular});
+        columns.append(Column{column, false, PlacementType::Additional});
+    }
+}
+
+void PlacementComparisonModel::setComparison(const std::shared_ptr<const DatasetSnapshot> &newSnapshot,
+                                             const AcademyScopeParameters &parameters)
+{
+    beginResetModel();
+    snapshot = newSnapshot;
+    regular = snapshot ? snapshot->getDataset(PlacementType::Regular) : nullptr;
+    additional = snapshot ? snapshot->getDataset(PlacementType::Additional) : nullptr;
+    joinIndex = snapshot ? snapshot->getProgramJoinIndex() : nullptr;
+    anchorSide = parameters.placementType;
+    filteredPairs.clear();
+    pairRows.clear();
+
+    if (!joinIndex) {
+        qWarning() << "[PlacementComparisonModel] Both placement tables are needed for a comparison";
+        endResetModel();
+        return;
+    }
+    // The in-memory datasets cover the current year only
+    if (parameters.year.has_value())
+        qWarning() << "[PlacementComparisonModel] Comparison ignores the year filter";
+
+    const ProgramDataset &anchor = anchorSide == PlacementType::Additional ? *additional : *regular;
+    const std::shared_ptr<const BitmapIndex> bitmapIndex = snapshot->getBitmapIndex(anchorSide);
+    const ProgramFilter filter(anchor, parameters);
+    const QVector<int> rows = bitmapIndex
+                                  ? filter.filterRows(bitmapIndex->evaluateCategorical(parameters).toRows(), true)
+                                  : filter.filterRows();
+
+    filteredPairs.reserve(rows.size());
+    for (int row : rows)
+        filteredPairs.append(joinIndex->pairIndexOfRow(anchorSide, row));
+    // Anchor rows are in ProgramKodu order and so are the pairs; only unjoinable rows can break it
+    std::sort(filteredPairs.begin(), filteredPairs.end());
+    pairRows = filteredPairs;
+    endResetModel();
+}
+
+void PlacementComparisonModel::clear()
+{
+    beginResetModel();
+    snapshot.reset();
+    regular.reset();
+    additional.reset();
+    joinIndex.reset();
+    filteredPairs = QVector<int>();
+    pairRows = QVector<int>();
+    endResetModel();
+}
+
+const std::shared_ptr<const DatasetSnapshot> &PlacementComparisonModel::getSnapshot() const
+{
+    return snapshot;
+}
+
+qint64 PlacementComparisonModel::estimatedMemoryBytes() const
+{
+    return columns.capacity() * qint64(sizeof(Column))
+           + (filteredPairs.capacity() + pairRows.capacity()) * qint64(sizeof(int));
+}
+
+PlacementComparisonModel::Column PlacementComparisonModel::columnAt(int section) const
+{
+    return columns.value(section);
+}
+
+qint64 PlacementComparisonModel::programCodeAt(int row) const
+{
+    if (row < 0 || row >= pairRows.size())
+        return -1;
+    return joinIndex->pair(pairRows[row]).programCode;
+}
+
+int PlacementComparisonModel::rowCount(const QModelIndex &) const
+{
+    return pairRows.size();
+}
+
+int PlacementComparisonModel::columnCount(const QModelIndex &) const
+{
+    return columns.size();
+}
+
+std::pair<const ProgramDataset *, int> PlacementComparisonModel::sourceOf(int pairIndex, const Column &column) const
+{
+    const ProgramJoinIndex::Pair &pair = joinIndex->pair(pairIndex);
+    // Identity columns come from the side the filters ran on, which always has the row
+    const PlacementType side = column.shared ? anchorSide : column.side;
+    if (side == PlacementType::Additional)
+        return {additional.get(), pair.additionalRow};
+    return {regular.get(), pair.regularRow};
+}
+
+int PlacementComparisonModel::datasetColumnOf(const ProgramDataset *dataset, ProgramTableColumn column) const
+{
+    return dataset ? dataset->columnIndex(ProgramTableColumns::dbName(column)) : -1;
+}
+
+QVariant PlacementComparisonModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return {};
+    if (index.row() >= pairRows.size() || index.column() >= columns.size())
+        return {};
+
+    const Column &column = columns[index.column()];
+    const auto [dataset, row] = sourceOf(pairRows[index.row()], column);
+    const int datasetColumn = datasetColumnOf(dataset, column.column);
+    if (row < 0 || datasetColumn < 0)
+        return QVariant("—");
+
+    const QVariant value = dataset->value(row, datasetColumn);
+    return value.isNull() ? QVariant("—") : value;
+}
+
+QVariant PlacementComparisonModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole)
+        return {};
+
+    if (orientation == Qt::Horizontal && section >= 0 && section < columns.size()) {
+        const Column &column = columns[section];
+        const QString name = ProgramTableColumns::displayName(column.column);
+        if (column.shared)
+            return name;
+        return QString("%1 (%2)").arg(name, column.side == PlacementType::Additional ? "Ek" : "Normal");
+    }
+
+    if (orientation == Qt::Vertical)
+        return QString::number(section + 1);
+
+    return {};
+}
+
+void PlacementComparisonModel::sort(int section, Qt::SortOrder order)
+{
+    if (section < 0 || section >= columns.size() || !joinIndex)
+        return;
+
+    const Column &column = columns[section];
+    if (!ProgramTableColumns::isSortable(column.column))
+        return;
+    const PlacementType side = column.shared ? anchorSide : column.side;
+    const ProgramDataset *dataset = side == PlacementType::Additional ? additional.get() : regular.get();
+    const int datasetColumn = datasetColumnOf(dataset, column.column);
+    if (datasetColumn < 0)
+        return;
+
+    // Ranks of the side's dataset, per pair. Programs missing on that side share
+    // the NULL rank, the last one, which stays last in both directions.
+    const ColumnArray<quint32> ranks = dataset->ranks(datasetColumn);
+    const quint32 rankCount = dataset->rankCount(datasetColumn);
+    const quint32 missingRank = rankCount - 1;
+    QVector<quint32> pairRanks(joinIndex->pairCount(), missingRank);
+    for (int pairIndex : filteredPairs) {
+        const int row = sourceOf(pairIndex, column).second;
+        pairRanks[pairIndex] = row >= 0 ? ranks[row] : missingRank;
+    }
+
+    // Always from ProgramKodu order, so equal values tie-break the same way every time
+    QVector<int> sortedPairs = filteredPairs;
+    RankSorter::sortRows(sortedPairs, pairRanks, rankCount, order == Qt::DescendingOrder);
+
+    emit layoutAboutToBeChanged();
+    const QModelIndexList oldIndexes = persistentIndexList();
+    QHash<int, int> newRowByPair;
+    newRowByPair.reserve(sortedPairs.size());
+    for (int row = 0; row < sortedPairs.size(); ++row)
+        newRowByPair.insert(sortedPairs[row], row);
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.size());
+    for (const QModelIndex &oldIndex : oldIndexes)
+        newIndexes.append(index(newRowByPair.value(pairRows[oldIndex.row()]), oldIndex.column()));
+    pairRows = sortedPairs;
+    changePersistentIndexList(oldIndexes, newIndexes);
+    emit layoutChanged();
+}
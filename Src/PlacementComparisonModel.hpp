@@ -0,0 +1,70 @@
+/*
+PlacementComparisonModel class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QAbstractTableModel>
+#include <QList>
+#include <QVector>
+#include <memory>
+#include "DataTypeDefinitions.hpp"
+#include "ProgramTableColumnDefinitions.hpp"
+#include "Data/DatasetSnapshot.hpp"
+
+// Regular and additional placement of the same programs side by side. The
+// filters select programs on the parameters' placement side; the other side
+// is joined through the snapshot's ProgramJoinIndex, never through SQL. Cells
+// are read from the in-memory datasets on demand, so only visible rows cost
+// anything, and sorting uses the datasets' rank arrays.
+class PlacementComparisonModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    struct Column {
+        ProgramTableColumn column;
+        bool shared = false;                    // identity column, shown once
+        PlacementType side = PlacementType::Regular;
+    };
+
+    explicit PlacementComparisonModel(QObject *parent = nullptr);
+
+    // Columns shown for both sides; identity columns always come first.
+    // Defaults to every stored quota column.
+    void setComparedColumns(const QList<ProgramTableColumn> &columns);
+    void setComparison(const std::shared_ptr<const DatasetSnapshot> &snapshot,
+                       const AcademyScopeParameters &parameters);
+    void clear();
+    // Snapshot the rows were joined on; kept alive until the next comparison or clear()
+    const std::shared_ptr<const DatasetSnapshot> &getSnapshot() const;
+    // Row lists and columns; the datasets belong to the snapshot
+    qint64 estimatedMemoryBytes() const;
+
+    Column columnAt(int section) const;
+    qint64 programCodeAt(int row) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private:
+    // Dataset and row backing a cell; row is -1 when the side has no placement
+    std::pair<const ProgramDataset *, int> sourceOf(int pairIndex, const Column &column) const;
+    int datasetColumnOf(const ProgramDataset *dataset, ProgramTableColumn column) const;
+    void rebuildColumns(const QList<ProgramTableColumn> &compared);
+
+    std::shared_ptr<const DatasetSnapshot> snapshot;
+    std::shared_ptr<const ProgramDataset> regular;
+    std::shared_ptr<const ProgramDataset> additional;
+    std::shared_ptr<const ProgramJoinIndex> joinIndex;
+    PlacementType anchorSide = PlacementType::Regular;
+    QVector<Column> columns;
+    QVector<int> filteredPairs; // pair indexes passing the filters, in ProgramKodu order
+    QVector<int> pairRows;      // filteredPairs in display order
+};
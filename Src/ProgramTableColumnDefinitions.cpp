@@ -11,82 +11,51 @@ You should have received a copy of the GNU General Public License along with thi
 
 #include "ProgramTableColumnDefinitions.hpp"
 
-ProgramTableColumnInfo::ProgramTableColumnInfo(const QString& db, const QString& display)
-    : dbName(db), displayName(display) {}
-
-const QMap<ProgramTableColumn, ProgramTableColumnInfo> ProgramTableColumns::columnMap = {
-    //Base Columns
-    { ProgramTableColumn::ProgramKodu, ProgramTableColumnInfo("ProgramKodu", "Program Kodu")},
-    { ProgramTableColumn::UniversiteAdi, ProgramTableColumnInfo("UniversiteAdi", "Üniversite")},
-    { ProgramTableColumn::FakulteYuksekOkulAdi, ProgramTableColumnInfo("Kampus", "Fakülte/YO")},
-    { ProgramTableColumn::ProgramAdi, ProgramTableColumnInfo("ProgramAdi", "Program")},
-    { ProgramTableColumn::PuanTuru, ProgramTableColumnInfo("PuanTuru", "Puan Türü")},
-    //Optional Columns
-    { ProgramTableColumn::GenelKontenjan, ProgramTableColumnInfo("GenelKontenjan", "Genel Kontenjan")},
-    { ProgramTableColumn::GenelYerlesen, ProgramTableColumnInfo("GenelYerlesen", "Genel Yerleşen")},
-    { ProgramTableColumn::GenelBasariSirasi, ProgramTableColumnInfo("GenelBasariSirasi", "Başarı Sırası")},
-    { ProgramTableColumn::GenelEnKucukPuan, ProgramTableColumnInfo("GenelEnKucukPuan", "En Küçük Puan")},
-    { ProgramTableColumn::OkulBirincisiKontenjan, ProgramTableColumnInfo("OkulBirincisiKontenjan", "Okul Birincisi Kontenjan")},
-    { ProgramTableColumn::OkulBirincisiYerlesen, ProgramTableColumnInfo("OkulBirincisiYerlesen", "Okul Birincisi Yerleşen")},
-    { ProgramTableColumn::OkulBirincisiBasariSirasi, ProgramTableColumnInfo("OkulBirincisiBasariSirasi", "Okul Birincisi Kontenjan")},
-    { ProgramTableColumn::OkulBirincisiEnKucukPuan, ProgramTableColumnInfo("OkulBirincisiEnKucukPuan", "Okul Birincisi En Küçük Puan")},
-    { ProgramTableColumn::SehitGaziYakiniKontenjan, ProgramTableColumnInfo("SehitGaziYakiniKontenjan", "Şehit/Gazi Yakını ")},
-    { ProgramTableColumn::SehitGaziYakiniYerlesen, ProgramTableColumnInfo("SehitGaziYakiniYerlesen", "Şehit/Gazi Yakını Yerleşen")},
-    { ProgramTableColumn::SehitGaziYakiniBasariSirasi, ProgramTableColumnInfo("SehitGaziYakiniBasariSirasi", "Şehit/Gazi Yakını Başarı Sırası")},
-    { ProgramTableColumn::SehitGaziYakiniEnKucukPuan, ProgramTableColumnInfo("SehitGaziYakiniEnKucukPuan", "Şehit/Gazi Yakını En Küçük Puan")},
-    { ProgramTableColumn::DepremzedeKontenjan, ProgramTableColumnInfo("DepremzedeKontenjan", "Depremzede Kontenjan")},
-    { ProgramTableColumn::DepremzedeYerlesen, ProgramTableColumnInfo("DepremzedeYerlesen", "Depremzede Yerleşen")},
-    { ProgramTableColumn::DepremzedeBasariSirasi, ProgramTableColumnInfo("DepremzedeBasariSirasi", "Depremzede ")},
-    { ProgramTableColumn::DepremzedeEnKucukPuan, ProgramTableColumnInfo("DepremzedeEnKucukPuan", "Depremzede En Küçük Puan")},
-    { ProgramTableColumn::Kadin34PlusKontenjan, ProgramTableColumnInfo("Kadin34Kontenjan", "34+ Kadın Kontenjan")},
-    { ProgramTableColumn::Kadin34PlusYerlesen, ProgramTableColumnInfo("Kadin34Yerlesen", "34+ Kadın Yerleşen")},
-    { ProgramTableColumn::Kadin34PlusBasariSirasi, ProgramTableColumnInfo("Kadin34BasariSirasi", "34+ Kadın Başarı Sırası")},
-    { ProgramTableColumn::Kadin34PlusEnKucukPuan, ProgramTableColumnInfo("Kadin34EnKucukPuan", "34+ Kadın En Küçük Puan")}
-};
-
-const QMap<ProgramTableColumn, ProgramTableColumnInfo> ProgramTableColumns::baseColumnMap = {
-    //Base Columns
-    { ProgramTableColumn::ProgramKodu, ProgramTableColumnInfo("ProgramKodu", "Program Kodu")},
-    { ProgramTableColumn::UniversiteAdi, ProgramTableColumnInfo("UniversiteAdi", "Üniversite")},
-    { ProgramTableColumn::FakulteYuksekOkulAdi, ProgramTableColumnInfo("Kampus", "Fakülte/YO")},
-    { ProgramTableColumn::ProgramAdi, ProgramTableColumnInfo("ProgramAdi", "Program")},
-    { ProgramTableColumn::PuanTuru, ProgramTableColumnInfo("PuanTuru", "Puan Türü")},
-};
+QString ProgramTableColumns::dbName(ProgramTableColumn column)
+{
+    const char *name = schema(column).dbName;
+    return name ? QString::fromLatin1(name) : QString();
+}
 
-const QMap<ProgramTableColumn, ProgramTableColumnInfo> ProgramTableColumns::optionalColumnMap = {
-    //Optional Columns
-    { ProgramTableColumn::GenelKontenjan, ProgramTableColumnInfo("GenelKontenjan", "Genel Kontenjan")},
-    { ProgramTableColumn::GenelYerlesen, ProgramTableColumnInfo("GenelYerlesen", "Genel Yerleşen")},
-    { ProgramTableColumn::GenelBasariSirasi, ProgramTableColumnInfo("GenelBasariSirasi", "Başarı Sırası")},
-    { ProgramTableColumn::GenelEnKucukPuan, ProgramTableColumnInfo("GenelEnKucukPuan", "En Küçük Puan")},
-    { ProgramTableColumn::OkulBirincisiKontenjan, ProgramTableColumnInfo("OkulBirincisiKontenjan", "Okul Birincisi Kontenjan")},
-    { ProgramTableColumn::OkulBirincisiYerlesen, ProgramTableColumnInfo("OkulBirincisiYerlesen", "Okul Birincisi Yerleşen")},
-    { ProgramTableColumn::OkulBirincisiBasariSirasi, ProgramTableColumnInfo("OkulBirincisiBasariSirasi", "Okul Birincisi Kontenjan")},
-    { ProgramTableColumn::OkulBirincisiEnKucukPuan, ProgramTableColumnInfo("OkulBirincisiEnKucukPuan", "Okul Birincisi En Küçük Puan")},
-    { ProgramTableColumn::SehitGaziYakiniKontenjan, ProgramTableColumnInfo("SehitGaziYakiniKontenjan", "Şehit/Gazi Yakını ")},
-    { ProgramTableColumn::SehitGaziYakiniYerlesen, ProgramTableColumnInfo("SehitGaziYakiniYerlesen", "Şehit/Gazi Yakını Yerleşen")},
-    { ProgramTableColumn::SehitGaziYakiniBasariSirasi, ProgramTableColumnInfo("SehitGaziYakiniBasariSirasi", "Şehit/Gazi Yakını Başarı Sırası")},
-    { ProgramTableColumn::SehitGaziYakiniEnKucukPuan, ProgramTableColumnInfo("SehitGaziYakiniEnKucukPuan", "Şehit/Gazi Yakını En Küçük Puan")},
-    { ProgramTableColumn::DepremzedeKontenjan, ProgramTableColumnInfo("DepremzedeKontenjan", "Depremzede Kontenjan")},
-    { ProgramTableColumn::DepremzedeYerlesen, ProgramTableColumnInfo("DepremzedeYerlesen", "Depremzede Yerleşen")},
-    { ProgramTableColumn::DepremzedeBasariSirasi, ProgramTableColumnInfo("DepremzedeBasariSirasi", "Depremzede ")},
-    { ProgramTableColumn::DepremzedeEnKucukPuan, ProgramTableColumnInfo("DepremzedeEnKucukPuan", "Depremzede En Küçük Puan")},
-    { ProgramTableColumn::Kadin34PlusKontenjan, ProgramTableColumnInfo("Kadin34Kontenjan", "34+ Kadın Kontenjan")},
-    { ProgramTableColumn::Kadin34PlusYerlesen, ProgramTableColumnInfo("Kadin34Yerlesen", "34+ Kadın Yerleşen")},
-    { ProgramTableColumn::Kadin34PlusBasariSirasi, ProgramTableColumnInfo("Kadin34BasariSirasi", "34+ Kadın Başarı Sırası")},
-    { ProgramTableColumn::Kadin34PlusEnKucukPuan, ProgramTableColumnInfo("Kadin34EnKucukPuan", "34+ Kadın En Küçük Puan")}
-};
+QString ProgramTableColumns::displayName(ProgramTableColumn column)
+{
+    return QString::fromUtf8(schema(column).displayName);
+}
 
-const ProgramTableColumnInfo & ProgramTableColumns::operator[](ProgramTableColumn programTableColumn) {
-    return columnMap[programTableColumn];
+QVariant ProgramTableColumns::decode(ProgramTableColumn column, const QVariant &value)
+{
+    if (value.isNull())
+        return QVariant();
+    switch (schema(column).valueType) {
+    case ColumnValueType::Integer:
+        return value.toLongLong();
+    case ColumnValueType::Real:
+        return value.toDouble();
+    case ColumnValueType::Text:
+        return value.toString();
+    }
+    return value;
 }
 
-QList<ProgramTableColumnInfo> ProgramTableColumns::getColumns()
+QString ProgramTableColumns::selectList(ProgramTableColumnMask columns)
 {
-    return columnMap.values();
+    QStringList terms;
+    for (const ProgramTableColumnSchema &entry : programTableSchema) {
+        if (entry.dbName && (columns & columnBit(entry.column))) {
+            terms << QString::fromLatin1(entry.dbName);
+            continue;
+        }
+        // Keep the position so decoding by index stays aligned
+        terms << QString("NULL AS Column%1").arg(int(entry.column));
+    }
+    return terms.join(", ");
 }
 
-QMap<ProgramTableColumn, ProgramTableColumnInfo> ProgramTableColumns::getColumnMap()
+QStringList ProgramTableColumns::missingColumns(const QStringList &dbColumnNames)
 {
-    return columnMap;
+    QStringList missing;
+    for (const ProgramTableColumnSchema &entry : programTableSchema)
+        if (entry.dbName && !dbColumnNames.contains(QString::fromLatin1(entry.dbName)))
+            missing << QString::fromLatin1(entry.dbName);
+    return missing;
 }
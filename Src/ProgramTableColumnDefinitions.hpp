@@ -11,7 +11,9 @@ You should have received a copy of the GNU General Public License along with thi
 #pragma once
 #include <QObject>
 #include <QString>
-#include <QMap>
+#include <QStringList>
+#include <QVariant>
+#include <array>
 
 enum class ColumnTypes : int {
     Base,
@@ -50,13 +52,102 @@ enum class ProgramTableColumn : int {
     Kadin34PlusEnKucukPuan
 };
 
-struct ProgramTableColumnInfo {
-    QString dbName;
-    QString displayName;
-    ProgramTableColumnInfo() = default;
-    ProgramTableColumnInfo(const QString& db, const QString& display);
+enum class ColumnValueType : int {
+    Integer,
+    Real,
+    Text
 };
 
+struct ProgramTableColumnSchema {
+    ProgramTableColumn column;
+    const char *dbName;      // nullptr when the column is not stored in the database
+    const char *displayName; // UTF-8
+    ColumnValueType valueType;
+    ColumnTypes quotaGroup;
+    bool sortable;
+};
+
+inline constexpr int programTableColumnCount = int(ProgramTableColumn::Kadin34PlusEnKucukPuan) + 1;
+
+// Bit i stands for ProgramTableColumn(i)
+using ProgramTableColumnMask = quint32;
+static_assert(programTableColumnCount <= 32, "ProgramTableColumnMask has one bit per column");
+inline constexpr ProgramTableColumnMask allProgramTableColumns = (ProgramTableColumnMask(1) << programTableColumnCount) - 1;
+
+constexpr ProgramTableColumnMask columnBit(ProgramTableColumn column)
+{
+    return ProgramTableColumnMask(1) << int(column);
+}
+
+// The single description of the program table. Entries are in ProgramTableColumn
+// order, so a column's metadata is one array access; the static_asserts below
+// reject any table that drifts from the enum.
+inline constexpr std::array<ProgramTableColumnSchema, programTableColumnCount> programTableSchema = {{
+    { ProgramTableColumn::ProgramKodu,                 "ProgramKodu",              "Program Kodu",                      ColumnValueType::Integer, ColumnTypes::Base, true },
+    { ProgramTableColumn::UniversiteAdi,               "UniversiteAdi",            "Üniversite",                        ColumnValueType::Text,    ColumnTypes::Base, true },
+    { ProgramTableColumn::FakulteYuksekOkulAdi,        "FakulteYuksekokulAdi",     "Kampüs",                            ColumnValueType::Text,    ColumnTypes::Base, true },
+    { ProgramTableColumn::ProgramAdi,                  "ProgramAdi",               "Program",                           ColumnValueType::Text,    ColumnTypes::Base, true },
+    { ProgramTableColumn::PuanTuru,                    "PuanTuru",                 "Puan Türü",                         ColumnValueType::Text,    ColumnTypes::Base, true },
+    { ProgramTableColumn::GenelKontenjan,              "GenelKontenjan",           "Kontenjan",                         ColumnValueType::Integer, ColumnTypes::Regular, true },
+    { ProgramTableColumn::GenelYerlesen,               "GenelYerlesen",            "Yerleşen",                          ColumnValueType::Integer, ColumnTypes::Regular, true },
+    { ProgramTableColumn::GenelBasariSirasi,           nullptr,                    "Başarı Sırası",                     ColumnValueType::Integer, ColumnTypes::Regular, false },
+    { ProgramTableColumn::GenelEnKucukPuan,            "GenelEnKucukPuan",         "En Küçük Puan",                     ColumnValueType::Real,    ColumnTypes::Regular, true },
+    { ProgramTableColumn::OkulBirincisiKontenjan,      "OkulBirincisiKontenjan",   "Okul Birincisi Kontenjan",          ColumnValueType::Integer, ColumnTypes::HighSchoolValedictorians, true },
+    { ProgramTableColumn::OkulBirincisiYerlesen,       "OkulBirincisiYerlesen",    "Okul Birincisi Yerleşen",           ColumnValueType::Integer, ColumnTypes::HighSchoolValedictorians, true },
+    { ProgramTableColumn::OkulBirincisiBasariSirasi,   nullptr,                    "Okul Birincisi Başarı Sırası",      ColumnValueType::Integer, ColumnTypes::HighSchoolValedictorians, false },
+    { ProgramTableColumn::OkulBirincisiEnKucukPuan,    "OkulBirincisiEnKucukPuan", "Okul Birincisi En Küçük Puan",      ColumnValueType::Real,    ColumnTypes::HighSchoolValedictorians, true },
+    { ProgramTableColumn::SehitGaziYakiniKontenjan,    "SehitGaziKontenjan",       "Şehit / Gazi Yakını Kontenjan",     ColumnValueType::Integer, ColumnTypes::MartyrsAndVeterans, true },
+    { ProgramTableColumn::SehitGaziYakiniYerlesen,     "SehitGaziYerlesen",        "Şehit / Gazi Yakını Yerleşen",      ColumnValueType::Integer, ColumnTypes::MartyrsAndVeterans, true },
+    { ProgramTableColumn::SehitGaziYakiniBasariSirasi, nullptr,                    "Şehit / Gazi Yakını Başarı Sırası", ColumnValueType::Integer, ColumnTypes::MartyrsAndVeterans, false },
+    { ProgramTableColumn::SehitGaziYakiniEnKucukPuan,  "SehitGaziEnKucukPuan",     "Şehit / Gazi Yakını En Küçük Puan", ColumnValueType::Real,    ColumnTypes::MartyrsAndVeterans, true },
+    { ProgramTableColumn::DepremzedeKontenjan,         "DepremzedeKontenjan",      "Depremzede Kontenjan",              ColumnValueType::Integer, ColumnTypes::EarthquakeVictims, true },
+    { ProgramTableColumn::DepremzedeYerlesen,          "DepremzedeYerlesen",       "Depremzede Yerleşen",               ColumnValueType::Integer, ColumnTypes::EarthquakeVictims, true },
+    { ProgramTableColumn::DepremzedeBasariSirasi,      nullptr,                    "Depremzede Başarı Sırası",          ColumnValueType::Integer, ColumnTypes::EarthquakeVictims, false },
+    { ProgramTableColumn::DepremzedeEnKucukPuan,       "DepremzedeEnKucukPuan",    "Depremzede En Küçük Puan",          ColumnValueType::Real,    ColumnTypes::EarthquakeVictims, true },
+    { ProgramTableColumn::Kadin34PlusKontenjan,        "Kadin34Kontenjan",         "34+ Kadın Kontenjan",               ColumnValueType::Integer, ColumnTypes::Women34Plus, true },
+    { ProgramTableColumn::Kadin34PlusYerlesen,         "Kadin34Yerlesen",          "34+ Kadın Yerleşen",                ColumnValueType::Integer, ColumnTypes::Women34Plus, true },
+    { ProgramTableColumn::Kadin34PlusBasariSirasi,     nullptr,                    "34+ Kadın Başarı Sırası",           ColumnValueType::Integer, ColumnTypes::Women34Plus, false },
+    { ProgramTableColumn::Kadin34PlusEnKucukPuan,      "Kadin34EnKucukPuan",       "34+ Kadın En Küçük Puan",           ColumnValueType::Real,    ColumnTypes::Women34Plus, true },
+}};
+
+namespace ProgramTableSchemaChecks {
+constexpr bool inEnumOrder()
+{
+    for (int i = 0; i < programTableColumnCount; ++i)
+        if (int(programTableSchema[i].column) != i)
+            return false;
+    return true;
+}
+
+constexpr bool onlyStoredColumnsSortable()
+{
+    for (const ProgramTableColumnSchema &entry : programTableSchema)
+        if (entry.sortable && entry.dbName == nullptr)
+            return false;
+    return true;
+}
+
+constexpr bool sameChars(const char *a, const char *b)
+{
+    while (*a && *a == *b) { ++a; ++b; }
+    return *a == *b;
+}
+
+constexpr bool uniqueDbNames()
+{
+    for (int i = 0; i < programTableColumnCount; ++i)
+        for (int j = i + 1; j < programTableColumnCount; ++j)
+            if (programTableSchema[i].dbName && programTableSchema[j].dbName
+                && sameChars(programTableSchema[i].dbName, programTableSchema[j].dbName))
+                return false;
+    return true;
+}
+}
+
+static_assert(ProgramTableSchemaChecks::inEnumOrder(), "programTableSchema must follow ProgramTableColumn order");
+static_assert(ProgramTableSchemaChecks::onlyStoredColumnsSortable(), "Only stored columns can be sorted on");
+static_assert(ProgramTableSchemaChecks::uniqueDbNames(), "Two schema entries map to the same DB column");
+
 class ProgramTableColumns {
     Q_GADGET
 public:
@@ -67,12 +158,27 @@ public:
     };
     Q_ENUM(Column)
 
-    static const QMap<ProgramTableColumn, ProgramTableColumnInfo> columnMap;
-    static const QMap<ProgramTableColumn, ProgramTableColumnInfo> baseColumnMap;
-    static const QMap<ProgramTableColumn, ProgramTableColumnInfo> optionalColumnMap;
-    static const ProgramTableColumnInfo & operator[] (ProgramTableColumn programTableColumn);
-    static QList<ProgramTableColumnInfo> getColumns();
-    static QMap<ProgramTableColumn, ProgramTableColumnInfo> getColumnMap();
+    static constexpr const ProgramTableColumnSchema &schema(ProgramTableColumn column)
+    {
+        return programTableSchema[int(column)];
+    }
+    static constexpr bool isStored(ProgramTableColumn column) { return schema(column).dbName != nullptr; }
+    // False for columns outside the table as well
+    static constexpr bool isSortable(ProgramTableColumn column)
+    {
+        return int(column) >= 0 && int(column) < programTableColumnCount && schema(column).sortable;
+    }
+    static constexpr bool isText(ProgramTableColumn column) { return schema(column).valueType == ColumnValueType::Text; }
 
-private:
+    // Empty for columns that are not stored in the database
+    static QString dbName(ProgramTableColumn column);
+    static QString displayName(ProgramTableColumn column);
+    // A database value as the schema types the column; NULL stays invalid
+    static QVariant decode(ProgramTableColumn column, const QVariant &value);
+    // "ProgramKodu, UniversiteAdi, ..., NULL AS Column7, ..." in enum order, so
+    // result column i is always ProgramTableColumn(i). Columns outside the mask
+    // are projected as NULL and never decoded.
+    static QString selectList(ProgramTableColumnMask columns = allProgramTableColumns);
+    // Stored columns the dataset does not have
+    static QStringList missingColumns(const QStringList &dbColumnNames);
 };
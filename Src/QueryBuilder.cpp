@@ -0,0 +1,218 @@
+/*
+QueryBuilder class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "QueryBuilder.hpp"
+#include <QStringList>
+#include <tuple>
+#include "ProgramTableColumnDefinitions.hpp"
+#include "Utils/SQLiteUtil.hpp"
+#include "Utils/TurkishText.hpp"
+
+QString QueryBuilder::buildFilteredSql(const AcademyScopeParameters &parameters)
+{
+    return buildFilterSql(parameters) + buildOrderSql(parameters);
+}
+
+QString QueryBuilder::buildFilterSql(const AcademyScopeParameters &parameters)
+{
+    return buildFilterSql(parameters, {});
+}
+
+QVariantList QueryBuilder::buildFilterBindValues(const AcademyScopeParameters &parameters)
+{
+    // Same order and conditions as the placeholders in buildFilterSql. Folded
+    // exactly like ProgramFilter's patterns, so both paths match the same names.
+    QVariantList values;
+    if (!parameters.universityName.trimmed().isEmpty())
+        values << escapeLikePattern(TurkishText::folded(parameters.universityName));
+    if (!parameters.departmentName.trimmed().isEmpty())
+        values << escapeLikePattern(TurkishText::folded(TurkishText::title(parameters.departmentName)));
+    return values;
+}
+
+QString QueryBuilder::escapeLikePattern(const QString &text)
+{
+    QString escaped;
+    escaped.reserve(text.size());
+    for (const QChar c : text) {
+        if (c == u'\\' || c == u'%' || c == u'_')
+            escaped += u'\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+QString QueryBuilder::buildSampledFilterSql(const AcademyScopeParameters &parameters, qint64 firstRowId,
+                                           qint64 lastRowId, qint64 stride)
+{
+    // The sampled rowids are generated and looked up one seek each; the
+    // predicates then only run on the rows found. First term, so it drives the plan.
+    const QString sample = QString("rowid IN (WITH RECURSIVE sample(id) AS (SELECT %1 UNION ALL "
+                                   "SELECT id + %3 FROM sample WHERE id + %3 <= %2) SELECT id FROM sample)")
+                               .arg(firstRowId)
+                               .arg(lastRowId)
+                               .arg(stride);
+    return buildFilterSql(parameters, { sample });
+}
+
+QString QueryBuilder::buildFilterSql(const AcademyScopeParameters &parameters, const QStringList &leadingTerms)
+{
+    QStringList where = leadingTerms;
+    QString sql = "FROM ";
+
+    // Base table
+    sql += buildTableName(parameters);
+
+    // University name and department; the patterns are bound, see buildFilterBindValues.
+    // tr_fold is registered by SQLiteUtil::configureConnection.
+    if (!parameters.universityName.trimmed().isEmpty())
+        where << "tr_fold(UniversiteAdi) LIKE '%' || ? || '%' ESCAPE '\\'";
+    if (!parameters.departmentName.trimmed().isEmpty())
+        where << "tr_fold(ProgramAdi) LIKE '%' || ? || '%' ESCAPE '\\'";
+
+    // Country filter
+    switch (parameters.country) {
+    case Country::Turkiye:          where << "UlkeKodu = 90"; break;
+    case Country::Cyprus:           where << "UlkeKodu = 357"; break;
+    case Country::ForeignCountries: where << "UlkeKodu NOT IN (90, 357)"; break;
+    case Country::AllCountries:
+        break;
+    }
+
+    // Degree type
+    if (parameters.degreeType == DegreeType::Bachelor)      where << "Lisans = 1";
+    else if (parameters.degreeType == DegreeType::Associate) where << "Lisans = 0";
+
+    // University type
+    if (parameters.universityType == UniversityType::Government)      where << "DevletUniversitesi = 1";
+    else if (parameters.universityType == UniversityType::Private)    where << "DevletUniversitesi = 0";
+
+    // Track type
+    switch (parameters.trackType) {
+    case TrackType::Science:      where << "PuanTuru = 'SAY'"; break;
+    case TrackType::EqualWeight:  where << "PuanTuru = 'EA'";  break;
+    case TrackType::Humanities:   where << "PuanTuru = 'SÖZ'"; break;
+    case TrackType::TYT:          where << "PuanTuru = 'TYT'"; break;
+    case TrackType::Language:     where << "PuanTuru = 'DİL'"; break;
+    case TrackType::Undefined:    break;
+    }
+
+    // Score range
+    double minScore = parameters.scoreInterval.minimum.value_or(0);
+    double maxScore = parameters.scoreInterval.maximum.value_or(0);
+    QString scoreRange;
+
+    if (minScore > 100)
+        scoreRange += QString("GenelEnKucukPuan > %1").arg(minScore);
+    if (maxScore < 560) {
+        if (!scoreRange.isEmpty()) scoreRange += " AND ";
+        scoreRange += QString("GenelEnBuyukPuan < %1").arg(maxScore);
+    }
+    if (!scoreRange.isEmpty())
+        where << QString("(%1)").arg(scoreRange);
+
+    // Quota types
+    QStringList kontenjan;
+    if (parameters.selectedQuotaTypes.regularQuota)           kontenjan << "GenelKontenjan IS NOT NULL";
+    if (parameters.selectedQuotaTypes.highSchoolValedictoriansQuota) kontenjan << "OkulBirincisiKontenjan IS NOT NULL";
+    if (parameters.selectedQuotaTypes.martyrsAndVeteransQuota) kontenjan << "SehitGaziKontenjan IS NOT NULL";
+    if (parameters.selectedQuotaTypes.earthquakeVictimsQuota)  kontenjan << "DepremzedeKontenjan IS NOT NULL";
+    if (parameters.selectedQuotaTypes.women34PlusQuota)        kontenjan << "Kadin34Kontenjan IS NOT NULL";
+    if (parameters.selectedQuotaTypes.trncNationalsQuota)      kontenjan << "KKTCUyruklu = TRUE";
+    else                                              where << "KKTCUyruklu = FALSE";
+    if (parameters.selectedQuotaTypes.mtokQuota)               kontenjan << "MTOK = TRUE";
+    else                                              where << "MTOK = FALSE";
+
+    if (!kontenjan.isEmpty())
+        where << "(" + kontenjan.join(" OR ") + ")";
+
+    // Quota size ranges, each only while its quota type is selected. Kept as
+    // top-level AND terms so the *Kontenjan indexes apply.
+    const SelectedQuotaTypes &quotas = parameters.selectedQuotaTypes;
+    const QList<std::tuple<QString, const Interval *, bool>> quotaRanges = {
+        { "GenelKontenjan",         &parameters.regularQuotaInterval,                  quotas.regularQuota },
+        { "OkulBirincisiKontenjan", &parameters.highSchoolValedictoriansQuotaInterval, quotas.highSchoolValedictoriansQuota },
+        { "Kadin34Kontenjan",       &parameters.women34PlusQuotaInterval,              quotas.women34PlusQuota },
+        { "DepremzedeKontenjan",    &parameters.earthquakeVictimsQuotaInterval,        quotas.earthquakeVictimsQuota },
+        { "SehitGaziKontenjan",     &parameters.martyrsAndVeteransQuotaInterval,       quotas.martyrsAndVeteransQuota },
+    };
+    for (const auto &[column, interval, selected] : quotaRanges)
+        if (selected)
+            where << buildRangeSql(column, *interval);
+
+    // KKTC uyruklu programs report their seats in GenelKontenjan
+    const QStringList trncRange = buildRangeSql("GenelKontenjan", parameters.trncNationalsQuotaInterval);
+    if (quotas.trncNationalsQuota && !trncRange.isEmpty())
+        where << QString("(KKTCUyruklu = FALSE OR (%1))").arg(trncRange.join(" AND "));
+
+    // Tuition filters
+    QStringList tuition;
+    if (parameters.selectedTuitionFeeTypes.free)       tuition << "UcretDurumu = 0";
+    if (parameters.selectedTuitionFeeTypes.discounted) tuition << "UcretDurumu = 50";
+    if (parameters.selectedTuitionFeeTypes.paid)       tuition << "UcretDurumu = 100";
+    if (!tuition.isEmpty())                   where << "(" + tuition.join(" OR ") + ")";
+
+    // Combine WHERE clauses
+    if (!where.isEmpty())
+        sql += " WHERE " + where.join(" AND ");
+
+    return sql;
+}
+
+QString QueryBuilder::buildTableName(const AcademyScopeParameters &parameters)
+{
+    const QString table = parameters.placementType == PlacementType::Additional ? "EkTercihDetayli" : "YKS";
+    if (!parameters.year.has_value())
+        return table;
+    return QString("%1.%2").arg(yearSchemaName(*parameters.year), table);
+}
+
+QString QueryBuilder::yearSchemaName(int year)
+{
+    return QString("y%1").arg(year);
+}
+
+QStringList QueryBuilder::buildRangeSql(const QString &column, const Interval &interval)
+{
+    QStringList terms;
+    if (interval.minimum.has_value())
+        terms << QString("%1 >= %2").arg(column).arg(*interval.minimum);
+    if (interval.maximum.has_value())
+        terms << QString("%1 <= %2").arg(column).arg(*interval.maximum);
+    return terms;
+}
+
+QString QueryBuilder::buildOrderSql(const AcademyScopeParameters &parameters)
+{
+    QStringList terms;
+    bool orderedByProgramCode = false;
+    for (const SortKey &key : parameters.order.sortKeys()) {
+        QString col = getDbColumnNameFromProgramTableColumnIndex(key.column);
+        if (col.isEmpty())
+            continue;
+        // NULLs last in both directions, as the in-memory rank order places them
+        terms << QString("%1 %2 NULLS LAST")
+                     .arg(ProgramTableColumns::isText(key.column) ? SQLiteUtil::trOrderExprFor(col) : col)
+                     .arg(key.direction == Qt::AscendingOrder ? "ASC" : "DESC");
+        orderedByProgramCode = orderedByProgramCode || col == "ProgramKodu";
+    }
+
+    // Deterministic tie-break, otherwise LIMIT/OFFSET windows may overlap on equal keys
+    if (!orderedByProgramCode)
+        terms << "ProgramKodu ASC";
+
+    return " ORDER BY " + terms.join(", ");
+}
+
+QString QueryBuilder::getDbColumnNameFromProgramTableColumnIndex(ProgramTableColumn column) {
+    if (int(column) < 0 || int(column) >= programTableColumnCount)
+        return QString();
+    return ProgramTableColumns::dbName(column);
+}
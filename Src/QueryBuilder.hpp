@@ -0,0 +1,43 @@
+/*
+QueryBuilder class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include "DataTypeDefinitions.hpp"
+
+class QueryBuilder
+{
+public:
+    // "FROM <table> WHERE ..." followed by the ORDER BY clause
+    static QString buildFilteredSql(const AcademyScopeParameters &parameters);
+    // "FROM <table> WHERE ..." only. User text is never spliced in: the name
+    // filters are "?" placeholders bound from buildFilterBindValues.
+    static QString buildFilterSql(const AcademyScopeParameters &parameters);
+    // Values of the placeholders in buildFilterSql, in order
+    static QVariantList buildFilterBindValues(const AcademyScopeParameters &parameters);
+    // Escapes %, _ and the escape character itself for "LIKE ... ESCAPE '\'"
+    static QString escapeLikePattern(const QString &text);
+    // buildFilterSql restricted to the rowids firstRowId, firstRowId + stride, ...
+    // up to lastRowId, for sampled estimates; never scans the table
+    static QString buildSampledFilterSql(const AcademyScopeParameters &parameters, qint64 firstRowId,
+                                         qint64 lastRowId, qint64 stride);
+    // " ORDER BY ..." including the ProgramKodu tie-break
+    static QString buildOrderSql(const AcademyScopeParameters &parameters);
+    static QString getDbColumnNameFromProgramTableColumnIndex(ProgramTableColumn column);
+    // "YKS" / "EkTercihDetayli", qualified with the attached year schema when a year is set
+    static QString buildTableName(const AcademyScopeParameters &parameters);
+    static QString yearSchemaName(int year);
+private:
+    static QString buildFilterSql(const AcademyScopeParameters &parameters, const QStringList &leadingTerms);
+    // "col >= min", "col <= max" for whichever bounds are set
+    static QStringList buildRangeSql(const QString &column, const Interval &interval);
+};
@@ -0,0 +1,134 @@
+/*
+ResultExporter class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ResultExporter.hpp"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QDebug>
+#include "QueryBuilder.hpp"
+#include "Utils/SQLiteUtil.hpp"
+
+ExportResult ResultExporter::exportRows(const QSqlDatabase &db,
+                                        const AcademyScopeParameters &parameters,
+                                        const QList<ProgramTableColumn> &columns,
+                                        QIODevice *sink,
+                                        const ExportOptions &options)
+{
+    if (!db.isOpen() || !sink || !sink->isWritable()) {
+        qWarning() << "[ResultExporter] Database or sink is not ready!";
+        return ExportResult::Failed;
+    }
+
+    QStringList columnNames;
+    for (ProgramTableColumn column : columns) {
+        const QString name = QueryBuilder::getDbColumnNameFromProgramTableColumnIndex(column);
+        if (name.isEmpty())
+            qWarning() << "[ResultExporter] Skipping column without a DB name:" << int(column);
+        else
+            columnNames << name;
+    }
+    if (columnNames.isEmpty())
+        return ExportResult::Failed;
+
+    const QString filterSql = QueryBuilder::buildFilterSql(parameters);
+    const QVariantList bindValues = QueryBuilder::buildFilterBindValues(parameters);
+
+    qint64 total = -1;
+    if (options.progress) {
+        QSqlQuery count(db);
+        if (SQLiteUtil::exec(count, "SELECT COUNT(*) " + filterSql, bindValues) && count.next())
+            total = count.value(0).toLongLong();
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!SQLiteUtil::exec(query, QString("SELECT %1 %2%3")
+                                     .arg(columnNames.join(", "), filterSql, QueryBuilder::buildOrderSql(parameters)),
+                          bindValues)) {
+        qWarning() << "[ResultExporter] Query failed:" << query.lastError().text();
+        return ExportResult::Failed;
+    }
+
+    const int chunkSize = std::max(1, options.chunkSize);
+    QByteArray buffer;
+
+    if (options.format == ExportFormat::Csv) {
+        for (int i = 0; i < columnNames.size(); ++i) {
+            if (i > 0) buffer += ',';
+            appendCsvField(buffer, columnNames[i]);
+        }
+        buffer += "\r\n";
+    }
+
+    qint64 written = 0;
+    int rowsInBuffer = 0;
+    auto flush = [&]() {
+        if (sink->write(buffer) != buffer.size())
+            return false;
+        buffer.clear(); // keeps capacity, so chunks reuse the same allocation
+        rowsInBuffer = 0;
+        if (options.progress)
+            options.progress(written, total);
+        return true;
+    };
+
+    while (query.next()) {
+        if (options.cancelled && options.cancelled->load(std::memory_order_relaxed))
+            return ExportResult::Cancelled;
+
+        if (options.format == ExportFormat::Csv) {
+            for (int i = 0; i < columnNames.size(); ++i) {
+                if (i > 0) buffer += ',';
+                appendCsvField(buffer, query.value(i));
+            }
+            buffer += "\r\n";
+        } else {
+            QJsonObject object;
+            for (int i = 0; i < columnNames.size(); ++i)
+                object.insert(columnNames[i], QJsonValue::fromVariant(query.value(i)));
+            buffer += QJsonDocument(object).toJson(QJsonDocument::Compact);
+            buffer += '\n';
+        }
+
+        ++written;
+        if (++rowsInBuffer >= chunkSize && !flush()) {
+            qWarning() << "[ResultExporter] Write failed:" << sink->errorString();
+            return ExportResult::Failed;
+        }
+    }
+
+    if (!flush()) {
+        qWarning() << "[ResultExporter] Write failed:" << sink->errorString();
+        return ExportResult::Failed;
+    }
+    return ExportResult::Completed;
+}
+
+void ResultExporter::appendCsvField(QByteArray &buffer, const QVariant &value)
+{
+    if (value.isNull())
+        return;
+
+    const QByteArray text = value.toString().toUtf8();
+    if (!text.contains(',') && !text.contains('"') && !text.contains('\n') && !text.contains('\r')) {
+        buffer += text;
+        return;
+    }
+
+    buffer += '"';
+    for (char c : text) {
+        if (c == '"') buffer += '"';
+        buffer += c;
+    }
+    buffer += '"';
+}
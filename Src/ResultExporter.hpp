@@ -0,0 +1,50 @@
+/*
+ResultExporter class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QIODevice>
+#include <QList>
+#include <QSqlDatabase>
+#include <atomic>
+#include <functional>
+#include "DataTypeDefinitions.hpp"
+
+enum class ExportFormat {
+    Csv,
+    JsonLines
+};
+
+enum class ExportResult {
+    Completed,
+    Cancelled,
+    Failed
+};
+
+struct ExportOptions {
+    ExportFormat format = ExportFormat::Csv;
+    int chunkSize = 1000; // rows buffered before each write to the sink
+    // Called after every chunk with the rows written so far and the total row count
+    std::function<void(qint64 written, qint64 total)> progress;
+    const std::atomic_bool *cancelled = nullptr;
+};
+
+// Streams a full filtered result from a forward-only cursor into a sink.
+// Only one chunk of rows is held in memory at a time.
+class ResultExporter
+{
+public:
+    static ExportResult exportRows(const QSqlDatabase &db,
+                                   const AcademyScopeParameters &parameters,
+                                   const QList<ProgramTableColumn> &columns,
+                                   QIODevice *sink,
+                                   const ExportOptions &options);
+private:
+    static void appendCsvField(QByteArray &buffer, const QVariant &value);
+};
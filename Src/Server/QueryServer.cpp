@@ -0,0 +1,216 @@
+/*
+QueryServer class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "QueryServer.hpp"
+#include <QPointer>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+#include "../LookupLists.hpp"
+#include "../ParametersJson.hpp"
+#include "../QueryBuilder.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+
+namespace {
+QJsonObject errorResponse(const QString &message)
+{
+    return QJsonObject{ { "ok", false }, { "error", message } };
+}
+}
+
+QueryServer::QueryServer(const QueryServerOptions &options, QObject *parent)
+    : QObject(parent), options(options), connections(options.databasePath),
+      yearCatalog(QFileInfo(options.databasePath).absolutePath())
+{
+    workers.setMaxThreadCount(std::max(1, options.workerCount));
+    // Workers keep their read connection; they only exit in stop(), which closes it
+    workers.setExpiryTimeout(-1);
+    connect(&server, &QLocalServer::newConnection, this, &QueryServer::acceptConnections);
+}
+
+QueryServer::~QueryServer()
+{
+    stop();
+}
+
+bool QueryServer::start()
+{
+    QLocalServer::removeServer(options.socketName);
+    if (!server.listen(options.socketName)) {
+        qWarning() << "[QueryServer] Listen failed:" << server.errorString();
+        return false;
+    }
+    qInfo() << "[QueryServer] Listening on" << server.fullServerName()
+            << "with" << workers.maxThreadCount() << "workers";
+    return true;
+}
+
+void QueryServer::stop()
+{
+    server.close();
+    workers.waitForDone();
+}
+
+const QueryServerOptions &QueryServer::getOptions() const
+{
+    return options;
+}
+
+void QueryServer::acceptConnections()
+{
+    while (QLocalSocket *socket = server.nextPendingConnection()) {
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { readRequests(socket); });
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+    }
+}
+
+void QueryServer::readRequests(QLocalSocket *socket)
+{
+    // A request line past the limit, finished or not, ends the connection with an error reply
+    auto rejectOversized = [this, socket]() {
+        qWarning() << "[QueryServer] Request exceeds" << options.maximumRequestBytes << "bytes; disconnecting";
+        disconnect(socket, &QLocalSocket::readyRead, this, nullptr);
+        QByteArray payload = QJsonDocument(errorResponse("request too large")).toJson(QJsonDocument::Compact);
+        payload += '\n';
+        socket->write(payload);
+        // Sends the reply before the connection closes
+        socket->disconnectFromServer();
+    };
+
+    while (socket->canReadLine()) {
+        const QByteArray line = socket->readLine().trimmed();
+        if (line.size() > options.maximumRequestBytes) {
+            rejectOversized();
+            return;
+        }
+        if (line.isEmpty())
+            continue;
+
+        // The deadline covers queueing time as well as execution
+        const QDeadlineTimer deadline(options.requestTimeoutMilliseconds);
+        QPointer<QLocalSocket> target(socket);
+
+        workers.start([this, line, deadline, target]() {
+            QJsonParseError parseError;
+            const QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+            QJsonObject response;
+            if (!document.isObject()) {
+                response = errorResponse("invalid JSON: " + parseError.errorString());
+            } else {
+                const QJsonObject request = document.object();
+                response = deadline.hasExpired() ? errorResponse("timeout") : handleRequest(request, deadline);
+                response.insert("id", request.value("id"));
+            }
+
+            QByteArray payload = QJsonDocument(response).toJson(QJsonDocument::Compact);
+            payload += '\n';
+            // Sockets belong to the server thread
+            QMetaObject::invokeMethod(this, [target, payload]() {
+                if (target)
+                    target->write(payload);
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    // What is left is an unfinished line; it must not grow without bound while the newline never comes
+    if (socket->bytesAvailable() > options.maximumRequestBytes)
+        rejectOversized();
+}
+
+QJsonObject QueryServer::handleRequest(const QJsonObject &request, const QDeadlineTimer &deadline)
+{
+    const QString op = request.value("op").toString();
+    if (op == "query")
+        return handleQuery(request, deadline);
+    if (op == "universities" || op == "departments")
+        return handleLookup(op);
+    if (op == "ping")
+        return QJsonObject{ { "ok", true } };
+    return errorResponse("unknown op: " + op);
+}
+
+QJsonObject QueryServer::handleQuery(const QJsonObject &request, const QDeadlineTimer &deadline)
+{
+    QSqlDatabase db = connections.connectionForCurrentThread();
+    if (!db.isOpen())
+        return errorResponse("database is not open");
+
+    const AcademyScopeParameters parameters = ParametersJson::fromJson(request.value("parameters").toObject());
+    if (parameters.year.has_value() && !yearCatalog.ensureAttached(db, *parameters.year))
+        return errorResponse(QString("no data for year %1").arg(*parameters.year));
+    const QString filterSql = QueryBuilder::buildFilterSql(parameters);
+    const QVariantList bindValues = QueryBuilder::buildFilterBindValues(parameters);
+    const int offset = std::max(0, request.value("offset").toInt(0));
+    const int limit = std::clamp(request.value("limit").toInt(100), 0, options.maximumPageSize);
+
+    // A statement still running at the deadline is interrupted, not waited for
+    const SQLiteUtil::StatementDeadline statementDeadline(db, deadline);
+    auto failure = [&deadline](const QSqlQuery &query) {
+        return errorResponse(deadline.hasExpired() ? "timeout" : query.lastError().text());
+    };
+
+    QJsonObject response{ { "ok", true } };
+
+    if (request.value("count").toBool(true)) {
+        QSqlQuery count(db);
+        if (!SQLiteUtil::exec(count, "SELECT COUNT(*) " + filterSql, bindValues) || !count.next())
+            return failure(count);
+        response.insert("total", count.value(0).toLongLong());
+        if (deadline.hasExpired())
+            return errorResponse("timeout");
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    const QString sql = QString("SELECT * %1%2 LIMIT %3 OFFSET %4")
+                            .arg(filterSql, QueryBuilder::buildOrderSql(parameters))
+                            .arg(limit)
+                            .arg(offset);
+    if (!SQLiteUtil::exec(query, sql, bindValues))
+        return failure(query);
+
+    const QSqlRecord record = query.record();
+    QJsonArray columns;
+    for (int i = 0; i < record.count(); ++i)
+        columns.append(record.fieldName(i));
+
+    QJsonArray rows;
+    while (query.next()) {
+        QJsonArray row;
+        for (int i = 0; i < record.count(); ++i)
+            row.append(QJsonValue::fromVariant(query.value(i)));
+        rows.append(row);
+    }
+    // next() also stops when the statement was interrupted
+    if (query.lastError().isValid() || deadline.hasExpired())
+        return failure(query);
+
+    response.insert("columns", columns);
+    response.insert("rows", rows);
+    return response;
+}
+
+QJsonObject QueryServer::handleLookup(const QString &op)
+{
+    QMutexLocker locker(&lookupMutex);
+    if (!lookupsLoaded) {
+        QSqlDatabase db = connections.connectionForCurrentThread();
+        for (const University &university : LookupLists::loadUniversities(db))
+            universities.append(QJsonObject{ { "id", university.id }, { "name", university.name } });
+        for (const QString &department : LookupLists::loadDepartments(db))
+            departments.append(department);
+        lookupsLoaded = true;
+    }
+    return QJsonObject{ { "ok", true }, { "items", op == "universities" ? universities : departments } };
+}
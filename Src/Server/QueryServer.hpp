@@ -0,0 +1,70 @@
+/*
+QueryServer class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QThreadPool>
+#include <QDeadlineTimer>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QMutex>
+#include "../Utils/ReadConnectionPool.hpp"
+#include "../Data/YearCatalog.hpp"
+
+struct QueryServerOptions {
+    QString socketName = "academyscope";
+    QString databasePath;
+    int workerCount = 4;
+    int requestTimeoutMilliseconds = 5000;
+    int maximumPageSize = 1000;
+    // A client whose unfinished line grows past this is answered with an error and disconnected
+    int maximumRequestBytes = 64 * 1024;
+};
+
+// Headless query service on a local (Unix domain) socket. Requests and
+// responses are single-line JSON objects:
+//   {"id": 1, "op": "query", "parameters": {...}, "offset": 0, "limit": 100}
+//   {"id": 2, "op": "universities"} / {"id": 3, "op": "departments"}
+// Every request runs on a worker of the pool with that worker's read-only
+// connection and fails with "timeout" once its deadline has passed; a
+// statement still running then is interrupted. Request lines are limited to
+// maximumRequestBytes.
+class QueryServer : public QObject {
+    Q_OBJECT
+public:
+    explicit QueryServer(const QueryServerOptions &options, QObject *parent = nullptr);
+    ~QueryServer();
+
+    bool start();
+    void stop();
+    const QueryServerOptions &getOptions() const;
+
+private slots:
+    void acceptConnections();
+
+private:
+    void readRequests(QLocalSocket *socket);
+    QJsonObject handleRequest(const QJsonObject &request, const QDeadlineTimer &deadline);
+    QJsonObject handleQuery(const QJsonObject &request, const QDeadlineTimer &deadline);
+    QJsonObject handleLookup(const QString &op);
+
+    QueryServerOptions options;
+    QLocalServer server;
+    QThreadPool workers;
+    ReadConnectionPool connections;
+    YearCatalog yearCatalog;
+
+    QMutex lookupMutex;
+    bool lookupsLoaded = false;
+    QJsonArray universities;
+    QJsonArray departments;
+};
@@ -0,0 +1,48 @@
+/*
+Headless query server entry point of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QThread>
+#include "QueryServer.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("AcademyScopeServer");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("AcademyScope headless query server");
+    parser.addHelpOption();
+    QCommandLineOption socketOption("socket", "Local socket name.", "name", "academyscope");
+    QCommandLineOption databaseOption("database", "SQLite database path.", "path");
+    QCommandLineOption workersOption("workers", "Worker thread count.", "count",
+                                     QString::number(QThread::idealThreadCount()));
+    QCommandLineOption timeoutOption("timeout", "Request timeout in milliseconds.", "ms", "5000");
+    QCommandLineOption prepareOption("prepare-database",
+                                     "Write the filter indexes into the database and exit; part of the database build.");
+    parser.addOptions({ socketOption, databaseOption, workersOption, timeoutOption, prepareOption });
+    parser.process(app);
+
+    QueryServerOptions options;
+    options.socketName = parser.value(socketOption);
+    options.databasePath = parser.isSet(databaseOption) ? parser.value(databaseOption)
+                                                        : SQLiteUtil::resolveDatabasePath();
+    if (parser.isSet(prepareOption))
+        return SQLiteUtil::prepareDatabase(options.databasePath) ? 0 : 1;
+    options.workerCount = parser.value(workersOption).toInt();
+    options.requestTimeoutMilliseconds = parser.value(timeoutOption).toInt();
+
+    QueryServer server(options);
+    if (!server.start())
+        return 1;
+    return app.exec();
+}
@@ -0,0 +1,128 @@
+/*
+StartupPipeline class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "StartupPipeline.hpp"
+#include <QTimer>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
+#include "Utils/SQLiteUtil.hpp"
+
+StartupPipeline::StartupPipeline(DatasetManager &datasetManager,
+                                 std::function<void(const QString &)> onSnapshotReady,
+                                 std::function<void()> loadFirstResult,
+                                 QObject *parent)
+    : QObject(parent),
+      datasetManager(datasetManager),
+      onSnapshotReady(std::move(onSnapshotReady)),
+      loadFirstResult(std::move(loadFirstResult))
+{
+    connect(&resolveWatcher, &QFutureWatcher<QString>::finished, this, &StartupPipeline::onDatabaseResolved);
+}
+
+StartupPipeline::~StartupPipeline()
+{
+    resolveWatcher.waitForFinished();
+}
+
+void StartupPipeline::start()
+{
+    metrics = StartupMetrics();
+    timer.start();
+    // On mobile platforms resolving copies the seed database, which can take a while
+    resolveWatcher.setFuture(QtConcurrent::run(&SQLiteUtil::resolveDatabasePath));
+}
+
+bool StartupPipeline::runBlocking()
+{
+    metrics = StartupMetrics();
+    timer.start();
+
+    databasePath = SQLiteUtil::resolveDatabasePath();
+    completeStage(StartupStage::DatabaseResolved);
+
+    if (!datasetManager.loadInitial(databasePath)) {
+        emit failed("Dataset could not be loaded from " + databasePath);
+        return false;
+    }
+    onSnapshotReady(databasePath);
+    completeStage(StartupStage::SnapshotPublished);
+
+    if (loadFirstResult) {
+        loadFirstResult();
+        completeStage(StartupStage::FirstResultLoaded);
+    }
+    return true;
+}
+
+const StartupMetrics &StartupPipeline::getMetrics() const
+{
+    return metrics;
+}
+
+void StartupPipeline::onDatabaseResolved()
+{
+    databasePath = resolveWatcher.result();
+    completeStage(StartupStage::DatabaseResolved);
+
+    publishedConnection = connect(&datasetManager, &DatasetManager::snapshotPublished,
+                                  this, &StartupPipeline::onSnapshotPublished);
+    failedConnection = connect(&datasetManager, &DatasetManager::reloadFailed,
+                               this, &StartupPipeline::onSnapshotFailed);
+    datasetManager.loadInitialAsync(databasePath);
+}
+
+void StartupPipeline::onSnapshotPublished()
+{
+    disconnectFromManager();
+    onSnapshotReady(databasePath);
+    completeStage(StartupStage::SnapshotPublished);
+
+    if (!loadFirstResult)
+        return;
+    // One event loop turn later, so the interactive UI gets painted first
+    QTimer::singleShot(0, this, [this]() {
+        loadFirstResult();
+        completeStage(StartupStage::FirstResultLoaded);
+    });
+}
+
+void StartupPipeline::onSnapshotFailed(const QString &reason)
+{
+    disconnectFromManager();
+    qWarning() << "[StartupPipeline]" << reason;
+    emit failed(reason);
+}
+
+void StartupPipeline::completeStage(StartupStage stage)
+{
+    const qint64 milliseconds = timer.elapsed();
+    switch (stage) {
+    case StartupStage::DatabaseResolved:
+        metrics.databaseResolvedMilliseconds = milliseconds;
+        break;
+    case StartupStage::SnapshotPublished:
+        metrics.timeToInteractiveMilliseconds = milliseconds;
+        qDebug() << "[StartupPipeline] Interactive after" << milliseconds << "ms";
+        emit interactive(milliseconds);
+        break;
+    case StartupStage::FirstResultLoaded:
+        metrics.timeToFirstResultMilliseconds = milliseconds;
+        qDebug() << "[StartupPipeline] First result after" << milliseconds << "ms";
+        emit firstResultReady(milliseconds);
+        break;
+    }
+    emit stageCompleted(stage, milliseconds);
+}
+
+void StartupPipeline::disconnectFromManager()
+{
+    disconnect(publishedConnection);
+    disconnect(failedConnection);
+}
@@ -0,0 +1,73 @@
+/*
+StartupPipeline class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QObject>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <functional>
+#include "Data/DatasetManager.hpp"
+
+enum class StartupStage {
+    DatabaseResolved,  // path known, mobile seed copied
+    SnapshotPublished, // datasets, indexes and lookup lists ready; the UI is interactive
+    FirstResultLoaded  // default result page filled
+};
+
+// Milliseconds since start(); -1 for stages not reached yet
+struct StartupMetrics {
+    qint64 databaseResolvedMilliseconds = -1;
+    qint64 timeToInteractiveMilliseconds = -1;
+    qint64 timeToFirstResultMilliseconds = -1;
+};
+
+// Brings the back end up in stages. start() keeps the calling (GUI) thread
+// free: the path is resolved and the snapshot built on worker threads, and
+// the first result is loaded one event loop turn after the UI became
+// interactive. runBlocking() walks the same stages on the calling thread.
+class StartupPipeline : public QObject {
+    Q_OBJECT
+signals:
+    void stageCompleted(StartupStage stage, qint64 milliseconds) const;
+    void interactive(qint64 milliseconds) const;
+    void firstResultReady(qint64 milliseconds) const;
+    void failed(const QString &reason) const;
+public:
+    // onSnapshotReady runs on the GUI thread once the first snapshot is published;
+    // loadFirstResult may be empty, which ends the pipeline at interactive
+    StartupPipeline(DatasetManager &datasetManager,
+                    std::function<void(const QString &databasePath)> onSnapshotReady,
+                    std::function<void()> loadFirstResult,
+                    QObject *parent = nullptr);
+    ~StartupPipeline();
+
+    void start();
+    bool runBlocking();
+    const StartupMetrics &getMetrics() const;
+
+private slots:
+    void onDatabaseResolved();
+    void onSnapshotPublished();
+    void onSnapshotFailed(const QString &reason);
+
+private:
+    void completeStage(StartupStage stage);
+    void disconnectFromManager();
+
+    DatasetManager &datasetManager;
+    std::function<void(const QString &)> onSnapshotReady;
+    std::function<void()> loadFirstResult;
+    QString databasePath;
+    QElapsedTimer timer;
+    StartupMetrics metrics;
+    QFutureWatcher<QString> resolveWatcher;
+    QMetaObject::Connection publishedConnection;
+    QMetaObject::Connection failedConnection;
+};
@@ -0,0 +1,138 @@
+/*
+MemoryAccountant class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MemoryAccountant.hpp"
+#include <QDebug>
+#include <QStringList>
+#include <algorithm>
+#include "MemoryUtil.hpp"
+
+MemoryAccountant::MemoryAccountant(QObject *parent)
+    : QObject(parent)
+{
+    connect(&reportTimer, &QTimer::timeout, this, [this]() {
+        logUsage();
+        enforceBudget();
+    });
+}
+
+int MemoryAccountant::registerComponent(const MemoryComponent &component)
+{
+    const int id = nextId++;
+    components.insert(id, component);
+    return id;
+}
+
+void MemoryAccountant::unregisterComponent(int id)
+{
+    components.remove(id);
+}
+
+void MemoryAccountant::setBudgetBytes(qint64 bytes)
+{
+    budgetBytes = std::max<qint64>(0, bytes);
+    enforceBudget();
+}
+
+qint64 MemoryAccountant::getBudgetBytes() const
+{
+    return budgetBytes;
+}
+
+QVector<MemoryUsage> MemoryAccountant::getUsage() const
+{
+    QVector<MemoryUsage> usage;
+    usage.reserve(components.size());
+    for (const MemoryComponent &component : components)
+        usage.append(MemoryUsage{component.name, component.usageBytes(), bool(component.release)});
+    return usage;
+}
+
+qint64 MemoryAccountant::getTotalBytes() const
+{
+    qint64 total = 0;
+    for (const MemoryComponent &component : components)
+        total += component.usageBytes();
+    return total;
+}
+
+qint64 MemoryAccountant::enforceBudget()
+{
+    if (budgetBytes <= 0)
+        return 0;
+    qint64 excess = getTotalBytes() - budgetBytes;
+    if (excess <= 0)
+        return 0;
+
+    struct Candidate {
+        const MemoryComponent *component;
+        qint64 bytes;
+        double costPerByte;
+    };
+    QVector<Candidate> candidates;
+    for (const MemoryComponent &component : components) {
+        if (!component.release)
+            continue;
+        const qint64 bytes = component.usageBytes();
+        if (bytes <= 0)
+            continue;
+        const double cost = component.rebuildCostMilliseconds ? component.rebuildCostMilliseconds() : 0;
+        candidates.append(Candidate{&component, bytes, cost / bytes});
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate &a, const Candidate &b) { return a.costPerByte < b.costPerByte; });
+
+    qint64 freed = 0;
+    QStringList evicted;
+    for (const Candidate &candidate : candidates) {
+        if (excess <= 0)
+            break;
+        const qint64 released = candidate.component->release(excess);
+        if (released <= 0)
+            continue;
+        freed += released;
+        excess -= released;
+        evicted << QString("%1 %2 MB").arg(candidate.component->name).arg(MemoryUtil::toMegabytes(released), 0, 'f', 1);
+    }
+
+    qDebug() << "[MemoryAccountant] Budget" << MemoryUtil::toMegabytes(budgetBytes) << "MB, freed"
+             << MemoryUtil::toMegabytes(freed) << "MB:" << evicted.join(", ");
+    if (excess > 0) {
+        qWarning() << "[MemoryAccountant] Still" << MemoryUtil::toMegabytes(excess) << "MB over budget";
+        emit budgetExceeded(budgetBytes + excess, budgetBytes);
+    }
+    return freed;
+}
+
+void MemoryAccountant::setReportInterval(int milliseconds)
+{
+    if (milliseconds <= 0) {
+        reportTimer.stop();
+        return;
+    }
+    reportTimer.start(milliseconds);
+}
+
+void MemoryAccountant::logUsage() const
+{
+    QStringList parts;
+    qint64 total = 0;
+    for (const MemoryUsage &usage : getUsage()) {
+        parts << QString("%1 %2 MB").arg(usage.name).arg(MemoryUtil::toMegabytes(usage.bytes), 0, 'f', 1);
+        total += usage.bytes;
+    }
+    const QString budget = budgetBytes > 0 ? QString("%1 MB").arg(MemoryUtil::toMegabytes(budgetBytes), 0, 'f', 1)
+                                           : QString("unlimited");
+    qDebug().noquote() << QString("[MemoryAccountant] Total %1 MB of %2, RSS %3 MB:")
+                              .arg(MemoryUtil::toMegabytes(total), 0, 'f', 1)
+                              .arg(budget)
+                              .arg(MemoryUtil::toMegabytes(MemoryUtil::residentSetSizeBytes()), 0, 'f', 1)
+                       << parts.join(", ");
+}
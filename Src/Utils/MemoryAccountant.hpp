@@ -0,0 +1,68 @@
+/*
+MemoryAccountant class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QObject>
+#include <QMap>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <functional>
+
+struct MemoryComponent {
+    QString name;
+    std::function<qint64()> usageBytes;
+    // Frees up to the given number of bytes and returns how many were freed.
+    // Empty for components that cannot shrink (the published snapshot).
+    std::function<qint64(qint64 targetBytes)> release;
+    // Milliseconds it would take to rebuild what release() drops; empty means free
+    std::function<double()> rebuildCostMilliseconds;
+};
+
+struct MemoryUsage {
+    QString name;
+    qint64 bytes = 0;
+    bool evictable = false;
+};
+
+// Sums the footprint every cache and store of the back end registers and
+// keeps it under one budget. When the total exceeds the budget, evictable
+// components are asked to shrink in cost/benefit order: the cheapest rebuild
+// per byte held goes first. Lives on the GUI thread, like the components.
+class MemoryAccountant : public QObject {
+    Q_OBJECT
+signals:
+    // Still over budget after every evictable component was asked to shrink
+    void budgetExceeded(qint64 usageBytes, qint64 budgetBytes) const;
+public:
+    explicit MemoryAccountant(QObject *parent = nullptr);
+
+    int registerComponent(const MemoryComponent &component);
+    void unregisterComponent(int id);
+
+    // 0 disables enforcement
+    void setBudgetBytes(qint64 bytes);
+    qint64 getBudgetBytes() const;
+
+    QVector<MemoryUsage> getUsage() const;
+    qint64 getTotalBytes() const;
+    // Returns the bytes freed
+    qint64 enforceBudget();
+
+    // Every tick logs the usage line and enforces the budget; 0 stops the timer
+    void setReportInterval(int milliseconds);
+    void logUsage() const;
+
+private:
+    QMap<int, MemoryComponent> components;
+    int nextId = 1;
+    qint64 budgetBytes = 0;
+    QTimer reportTimer;
+};
@@ -0,0 +1,47 @@
+/*
+MemoryUtil class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "MemoryUtil.hpp"
+#include <QFile>
+#include <QByteArray>
+
+namespace {
+qint64 readProcStatusKilobytes(const char *key)
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+    while (!status.atEnd()) {
+        const QByteArray line = status.readLine();
+        if (line.startsWith(key))
+            return line.mid(qstrlen(key)).trimmed().split(' ').value(0).toLongLong() * 1024;
+    }
+#else
+    Q_UNUSED(key)
+#endif
+    return -1;
+}
+}
+
+qint64 MemoryUtil::residentSetSizeBytes()
+{
+    return readProcStatusKilobytes("VmRSS:");
+}
+
+qint64 MemoryUtil::peakResidentSetSizeBytes()
+{
+    return readProcStatusKilobytes("VmHWM:");
+}
+
+double MemoryUtil::toMegabytes(qint64 bytes)
+{
+    return bytes < 0 ? -1 : bytes / (1024.0 * 1024.0);
+}
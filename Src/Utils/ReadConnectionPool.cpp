@@ -0,0 +1,74 @@
+/*
+ReadConnectionPool class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ReadConnectionPool.hpp"
+#include <QThread>
+#include <QUuid>
+#include <QSqlError>
+#include <QDebug>
+#include "SQLiteUtil.hpp"
+
+ReadConnectionPool::ReadConnectionPool(const QString &databasePath)
+    : databasePath(databasePath),
+      poolId(QUuid::createUuid().toString(QUuid::WithoutBraces)),
+      connections(std::make_shared<Connections>())
+{
+}
+
+ReadConnectionPool::~ReadConnectionPool()
+{
+    const QString name = QString("%1-%2").arg(poolId).arg(quintptr(QThread::currentThreadId()));
+    if (QSqlDatabase::contains(name))
+        release(connections, name);
+}
+
+void ReadConnectionPool::release(const std::shared_ptr<Connections> &connections, const QString &name)
+{
+    QSqlDatabase::removeDatabase(name);
+    QMutexLocker locker(&connections->mutex);
+    connections->names.removeOne(name);
+}
+
+QSqlDatabase ReadConnectionPool::connectionForCurrentThread()
+{
+    // Thread ids are reused, but never while the connection of the old thread
+    // exists: it is removed when that thread finishes
+    const QString name = QString("%1-%2").arg(poolId).arg(quintptr(QThread::currentThreadId()));
+    if (QSqlDatabase::contains(name))
+        return QSqlDatabase::database(name);
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", name);
+    db.setDatabaseName(databasePath);
+    db.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=2000");
+    if (db.open())
+        SQLiteUtil::configureConnection(db);
+    else
+        qWarning() << "[ReadConnectionPool] Database could not be opened:" << db.lastError().text();
+
+    // finished is emitted by the finishing thread itself, so the connection is
+    // removed by its owner; the state is shared in case the pool is gone by then
+    QObject::connect(QThread::currentThread(), &QThread::finished,
+                     [connections = connections, name]() { release(connections, name); });
+
+    QMutexLocker locker(&connections->mutex);
+    connections->names << name;
+    return db;
+}
+
+int ReadConnectionPool::connectionCount() const
+{
+    QMutexLocker locker(&connections->mutex);
+    return connections->names.size();
+}
+
+const QString &ReadConnectionPool::getDatabasePath() const
+{
+    return databasePath;
+}
@@ -0,0 +1,47 @@
+/*
+ReadConnectionPool class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QSqlDatabase>
+#include <QMutex>
+#include <memory>
+
+// Read-only SQLite connections, one per thread. QSqlDatabase connections may
+// only be used from the thread that created them, so each worker gets its own,
+// and it is closed by that same thread when the thread finishes. A thread
+// pool using this should keep its threads (QThreadPool::setExpiryTimeout(-1))
+// so connections are not reopened after every idle period.
+class ReadConnectionPool
+{
+public:
+    explicit ReadConnectionPool(const QString &databasePath);
+    // Closes the calling thread's connection only; the others close as their threads finish
+    ~ReadConnectionPool();
+
+    // Opens the calling thread's connection on first use
+    QSqlDatabase connectionForCurrentThread();
+    int connectionCount() const;
+    const QString &getDatabasePath() const;
+
+private:
+    // Outlives the pool while threads that still hold a connection run
+    struct Connections {
+        QMutex mutex;
+        QStringList names;
+    };
+
+    static void release(const std::shared_ptr<Connections> &connections, const QString &name);
+
+    QString databasePath;
+    QString poolId;
+    std::shared_ptr<Connections> connections;
+};
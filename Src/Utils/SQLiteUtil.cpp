@@ -14,10 +14,107 @@ You should have received a copy of the GNU General Public License along with thi
 #include <QFileInfo>
 #include <QSqlDatabase>
 #include <QSqlError>
+#include <QSqlQuery>
+#include <QSqlRecord>
 #include <QStandardPaths>
+#include <QUrl>
+#include <QSqlDriver>
 #include <QDebug>
+#include <QVarLengthArray>
+#include <atomic>
+#include <sqlite3.h>
 
 #include "SQLiteUtil.hpp"
+#include "TurkishText.hpp"
+
+namespace {
+// Called every few hundred virtual machine steps; non-zero interrupts the statement
+int interruptAfterDeadline(void *deadline)
+{
+    return static_cast<const QDeadlineTimer *>(deadline)->hasExpired() ? 1 : 0;
+}
+
+std::atomic<qint64> startedStatementCount{0};
+
+int countStartedStatement(unsigned, void *, void *, void *)
+{
+    ++startedStatementCount;
+    return 0;
+}
+
+// tr_fold(text): registered as UTF-16, so SQLite hands over QChar-compatible text
+void foldText(sqlite3_context *context, int, sqlite3_value **arguments)
+{
+    if (sqlite3_value_type(arguments[0]) == SQLITE_NULL) {
+        sqlite3_result_null(context);
+        return;
+    }
+    const auto *text = static_cast<const QChar *>(sqlite3_value_text16(arguments[0]));
+    const qsizetype size = sqlite3_value_bytes16(arguments[0]) / qsizetype(sizeof(QChar));
+    QVarLengthArray<QChar, 256> folded(size);
+    const qsizetype length = TurkishText::fold(QStringView(text, size), folded.data());
+    sqlite3_result_text16(context, folded.constData(), int(length * sizeof(QChar)), SQLITE_TRANSIENT);
+}
+}
+
+SQLiteUtil::StatementDeadline::StatementDeadline(const QSqlDatabase &db, const QDeadlineTimer &deadline)
+    : handle(handleOf(db)), deadline(deadline)
+{
+    if (handle)
+        sqlite3_progress_handler(handle, 1000, interruptAfterDeadline, &this->deadline);
+}
+
+SQLiteUtil::StatementDeadline::~StatementDeadline()
+{
+    if (handle)
+        sqlite3_progress_handler(handle, 0, nullptr, nullptr);
+}
+
+sqlite3 *SQLiteUtil::handleOf(const QSqlDatabase &db)
+{
+    if (!db.isOpen() || !db.driver())
+        return nullptr;
+    const QVariant handle = db.driver()->handle();
+    if (!handle.isValid() || qstrcmp(handle.typeName(), "sqlite3*") != 0)
+        return nullptr;
+    return *static_cast<sqlite3 *const *>(handle.data());
+}
+
+void SQLiteUtil::configureConnection(const QSqlDatabase &db)
+{
+    sqlite3 *handle = handleOf(db);
+    if (!handle) {
+        qWarning() << "[SQLiteUtil] Connection is not an open SQLite connection:" << db.connectionName();
+        return;
+    }
+    if (sqlite3_create_function_v2(handle, "tr_fold", 1, SQLITE_UTF16 | SQLITE_DETERMINISTIC, nullptr,
+                                   foldText, nullptr, nullptr, nullptr) != SQLITE_OK)
+        qWarning() << "[SQLiteUtil] tr_fold could not be registered:" << sqlite3_errmsg(handle);
+    sqlite3_trace_v2(handle, SQLITE_TRACE_STMT, countStartedStatement, nullptr);
+}
+
+qint64 SQLiteUtil::getStartedStatementCount()
+{
+    return startedStatementCount.load();
+}
+
+bool SQLiteUtil::openImmutable(QSqlDatabase &db, const QString &path)
+{
+    // Percent-encoded, so '?' and '#' in the path are not read as URI syntax
+    const QString uri = QUrl::fromLocalFile(QFileInfo(path).absoluteFilePath()).toString(QUrl::FullyEncoded);
+    db.setDatabaseName(uri + "?immutable=1");
+    db.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI");
+    return db.open();
+}
+
+bool SQLiteUtil::exec(QSqlQuery &query, const QString &sql, const QVariantList &bindValues)
+{
+    if (!query.prepare(sql))
+        return false;
+    for (const QVariant &value : bindValues)
+        query.addBindValue(value);
+    return query.exec();
+}
 
 QString SQLiteUtil::resolveDatabasePath() {
 #ifdef QT_DEBUG
@@ -62,12 +159,6 @@ QString SQLiteUtil::resolveDatabasePath() {
 }
 
 QString SQLiteUtil::trOrderExprFor(const QString& col) {
-    // Only text columns to be processed
-    if (!(col == "UniversiteAdi" || col == "FakulteYuksekokulAdi" ||
-          col == "ProgramAdi"    || col == "PuanTuru")) {
-        return col;
-    }
-
     struct Map { const char* from; const char* to; };
     static const Map m[] = {
                             {"Ç","CZ"}, {"ç","cz"},
@@ -85,3 +176,64 @@ QString SQLiteUtil::trOrderExprFor(const QString& col) {
     }
     return expr;
 }
+
+QStringList SQLiteUtil::indexedColumns() {
+    return { "GenelKontenjan", "OkulBirincisiKontenjan", "Kadin34Kontenjan",
+             "DepremzedeKontenjan", "SehitGaziKontenjan" };
+}
+
+bool SQLiteUtil::ensureIndexes(const QSqlDatabase &db, const QString &table, const QStringList &columns) {
+    const QSqlRecord record = db.record(table);
+    QSqlQuery query(db);
+    bool created = true;
+    for (const QString &column : columns) {
+        if (!record.contains(column))
+            continue;
+        const QString sql = QString("CREATE INDEX IF NOT EXISTS idx_%1_%2 ON %1(%2)").arg(table, column);
+        if (!query.exec(sql)) {
+            qWarning() << "Index could not be created:" << sql << query.lastError().text();
+            created = false;
+        }
+    }
+    return created;
+}
+
+QStringList SQLiteUtil::missingIndexes(const QSqlDatabase &db, const QString &table, const QStringList &columns) {
+    const QSqlRecord record = db.record(table);
+    QStringList indexed;
+    QSqlQuery query(db);
+    // Only the leading column of an index serves a single-column range
+    if (query.exec(QString("SELECT name FROM pragma_index_list('%1')").arg(table))) {
+        QSqlQuery info(db);
+        while (query.next())
+            if (info.exec(QString("SELECT name FROM pragma_index_info('%1') WHERE seqno = 0")
+                              .arg(query.value(0).toString()))
+                && info.next())
+                indexed << info.value(0).toString();
+    }
+
+    QStringList missing;
+    for (const QString &column : columns)
+        if (record.contains(column) && !indexed.contains(column))
+            missing << column;
+    return missing;
+}
+
+bool SQLiteUtil::prepareDatabase(const QString &databasePath) {
+    const QString connectionName = "prepare-database";
+    bool prepared = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        db.setDatabaseName(databasePath);
+        if (!db.open()) {
+            qWarning() << "Database could not be opened:" << db.lastError().text();
+        } else {
+            configureConnection(db);
+            prepared = ensureIndexes(db, "YKS", indexedColumns())
+                       && ensureIndexes(db, "EkTercihDetayli", indexedColumns());
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return prepared;
+}
@@ -10,10 +10,55 @@ You should have received a copy of the GNU General Public License along with thi
 */
 #pragma once
 #include <QString>
+#include <QStringList>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QVariantList>
+#include <QDeadlineTimer>
+
+struct sqlite3;
 
 class SQLiteUtil
 {
 public:
+    // Aborts statements of a connection once the deadline has passed, also in
+    // the middle of a long scan; they then fail with SQLITE_INTERRUPT. The
+    // handler is removed again when the guard goes out of scope.
+    class StatementDeadline
+    {
+    public:
+        StatementDeadline(const QSqlDatabase &db, const QDeadlineTimer &deadline);
+        ~StatementDeadline();
+        StatementDeadline(const StatementDeadline &) = delete;
+        StatementDeadline &operator=(const StatementDeadline &) = delete;
+    private:
+        sqlite3 *handle = nullptr;
+        QDeadlineTimer deadline;
+    };
+
+    // The native handle of an open QSQLITE connection, nullptr otherwise
+    static sqlite3 *handleOf(const QSqlDatabase &db);
+    // Setup every connection gets right after open(): tr_fold(text), the
+    // TurkishText::fold the in-memory filters match with, is registered and
+    // the connection's statements are counted in getStartedStatementCount()
+    static void configureConnection(const QSqlDatabase &db);
+    // Statements started on configured connections of this process, any thread
+    static qint64 getStartedStatementCount();
+    // Opens a file that no one writes while it is open, read-only as
+    // file:...?immutable=1: SQLite takes no locks and never looks for -wal or -shm files
+    static bool openImmutable(QSqlDatabase &db, const QString &path);
+    // prepare() with positional bind values, then exec()
+    static bool exec(QSqlQuery &query, const QString &sql, const QVariantList &bindValues);
     static QString resolveDatabasePath();
+    // ORDER BY expression that sorts a text column in Turkish alphabet order
     static QString trOrderExprFor(const QString& col);
+    // Single-column indexes the filter queries rely on, per program table
+    static QStringList indexedColumns();
+    // Creates a single-column index for every listed column present in the
+    // table; false when one could not be written
+    static bool ensureIndexes(const QSqlDatabase &db, const QString &table, const QStringList &columns);
+    // Listed columns present in the table without an index of their own
+    static QStringList missingIndexes(const QSqlDatabase &db, const QString &table, const QStringList &columns);
+    // Offline build step: writes the indexes of both program tables into the file
+    static bool prepareDatabase(const QString &databasePath);
 };
@@ -9,23 +9,14 @@ This program is distributed in the hope that it will be useful, but WITHOUT ANY
 You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
 */
 #include "StringUtil.hpp"
+#include "TurkishText.hpp"
 
 QString StringUtil::toTurkishTitleCase(const QString &input)
 {
-    QStringList words = input.split(' ', Qt::SkipEmptyParts);
-    for (QString &word : words) {
-        if (!word.isEmpty()) {
-            QString first = turkishLocale.toUpper(word.left(1));
-            QString rest  = turkishLocale.toLower(word.mid(1));
-            word = first + rest;
-        }
-    }
-    return words.join(' ');
+    return TurkishText::title(input);
 }
 
 QString StringUtil::toTurkishUpperCase(const QString &input)
 {
-    return turkishLocale.toUpper(input);
+    return TurkishText::upper(input);
 }
-
-QLocale StringUtil::turkishLocale = QLocale(QLocale::Turkish, QLocale::Turkey);
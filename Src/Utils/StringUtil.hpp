@@ -11,13 +11,12 @@ You should have received a copy of the GNU General Public License along with thi
 #pragma once
 
 #include <QString>
-#include <QLocale>
 
+// Pattern forms for the SQL name filters; see TurkishText for the buffer-based
+// versions and the folded form used by in-memory matching
 class StringUtil
 {
 public:
     static QString toTurkishTitleCase(const QString &input);
     static QString toTurkishUpperCase(const QString &input);
-private:
-    static QLocale turkishLocale;
 };
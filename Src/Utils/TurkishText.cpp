@@ -0,0 +1,182 @@
+/*
+TurkishText class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "TurkishText.hpp"
+#include <cstring>
+
+namespace {
+// Latin-1 and Latin Extended-A, which hold every letter of the Turkish alphabet
+constexpr char16_t tableSize = 0x180;
+
+struct CasePair {
+    char16_t upper;
+    char16_t lower;
+};
+
+// Where Turkish differs from the default mapping (dotted and dotless i), and
+// the remaining Turkish letters so the whole alphabet is spelled out here
+constexpr CasePair turkishPairs[] = {
+    {u'I', u'\u0131'}, {u'\u0130', u'i'},     // I ı, İ i
+    {u'\u011E', u'\u011F'},                  // Ğ ğ
+    {u'\u015E', u'\u015F'},                  // Ş ş
+    {u'\u00C7', u'\u00E7'},                  // Ç ç
+    {u'\u00D6', u'\u00F6'},                  // Ö ö
+    {u'\u00DC', u'\u00FC'}                   // Ü ü
+};
+
+struct CaseTables {
+    char16_t upper[tableSize];
+    char16_t lower[tableSize];
+
+    CaseTables()
+    {
+        for (char16_t c = 0; c < tableSize; ++c) {
+            const char32_t u = QChar::toUpper(char32_t(c));
+            const char32_t l = QChar::toLower(char32_t(c));
+            upper[c] = u > 0xFFFF ? c : char16_t(u);
+            lower[c] = l > 0xFFFF ? c : char16_t(l);
+        }
+        for (const CasePair &pair : turkishPairs) {
+            upper[pair.lower] = pair.upper;
+            lower[pair.upper] = pair.lower;
+        }
+    }
+};
+
+const CaseTables tables;
+
+inline char16_t upperOf(char16_t c)
+{
+    if (c < tableSize)
+        return tables.upper[c];
+    const char32_t u = QChar::toUpper(char32_t(c));
+    return u > 0xFFFF ? c : char16_t(u);
+}
+
+inline char16_t lowerOf(char16_t c)
+{
+    if (c < tableSize)
+        return tables.lower[c];
+    const char32_t l = QChar::toLower(char32_t(c));
+    return l > 0xFFFF ? c : char16_t(l);
+}
+
+// Four UTF-16 code units per 64-bit word; the lane arithmetic below never
+// carries between lanes because every lane is checked to be ASCII first
+constexpr quint64 lanes(quint16 value)
+{
+    return quint64(value) * 0x0001000100010001ULL;
+}
+
+inline bool isAsciiBlock(quint64 word)
+{
+    return (word & lanes(0xFF80)) == 0;
+}
+
+inline bool hasLane(quint64 word, char16_t value)
+{
+    const quint64 x = word ^ lanes(value);
+    return ((x - lanes(1)) & ~x & lanes(0x8000)) != 0;
+}
+
+// 0x80 in every lane holding a character of [first, last]
+inline quint64 rangeMask(quint64 word, char16_t first, char16_t last)
+{
+    return (word + lanes(0x80 - first)) & ~(word + lanes(0x7F - last)) & lanes(0x80);
+}
+
+// The ASCII letter with a Turkish mapping (i -> İ, I -> ı) sends its block to
+// the table; every other ASCII letter just flips the 0x20 bit.
+template <bool Upper>
+qsizetype mapRun(const char16_t *input, qsizetype size, QChar *output)
+{
+    constexpr char16_t first = Upper ? u'a' : u'A';
+    constexpr char16_t last = Upper ? u'z' : u'Z';
+    constexpr char16_t special = Upper ? u'i' : u'I';
+
+    qsizetype i = 0;
+    for (; i + 4 <= size; i += 4) {
+        quint64 word;
+        std::memcpy(&word, input + i, sizeof(word));
+        if (isAsciiBlock(word) && !hasLane(word, special)) {
+            word ^= rangeMask(word, first, last) >> 2;
+            std::memcpy(output + i, &word, sizeof(word));
+            continue;
+        }
+        for (qsizetype j = i; j < i + 4; ++j)
+            output[j] = QChar(Upper ? upperOf(input[j]) : lowerOf(input[j]));
+    }
+    for (; i < size; ++i)
+        output[i] = QChar(Upper ? upperOf(input[i]) : lowerOf(input[i]));
+    return size;
+}
+
+template <qsizetype (*Map)(QStringView, QChar *)>
+QString mapped(QStringView input)
+{
+    QString result(input.size(), Qt::Uninitialized);
+    result.truncate(Map(input, result.data()));
+    return result;
+}
+}
+
+qsizetype TurkishText::toUpper(QStringView input, QChar *output)
+{
+    return mapRun<true>(input.utf16(), input.size(), output);
+}
+
+qsizetype TurkishText::toLower(QStringView input, QChar *output)
+{
+    return mapRun<false>(input.utf16(), input.size(), output);
+}
+
+qsizetype TurkishText::toTitle(QStringView input, QChar *output)
+{
+    const char16_t *text = input.utf16();
+    const qsizetype size = input.size();
+    qsizetype written = 0;
+    qsizetype start = 0;
+    while (start < size) {
+        if (text[start] == u' ') {
+            ++start;
+            continue;
+        }
+        qsizetype end = start + 1;
+        while (end < size && text[end] != u' ')
+            ++end;
+
+        if (written > 0)
+            output[written++] = QChar(u' ');
+        output[written++] = QChar(upperOf(text[start]));
+        written += mapRun<false>(text + start + 1, end - start - 1, output + written);
+        start = end;
+    }
+    return written;
+}
+
+qsizetype TurkishText::fold(QStringView input, QChar *output)
+{
+    return toLower(input, output);
+}
+
+QString TurkishText::upper(QStringView input)
+{
+    return mapped<&TurkishText::toUpper>(input);
+}
+
+QString TurkishText::title(QStringView input)
+{
+    return mapped<&TurkishText::toTitle>(input);
+}
+
+QString TurkishText::folded(QStringView input)
+{
+    return mapped<&TurkishText::fold>(input);
+}
@@ -0,0 +1,37 @@
+/*
+TurkishText class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <QString>
+#include <QStringView>
+
+// Turkish case mapping without QLocale and without allocating. Every function
+// writes into a caller-provided buffer of at least input.size() characters and
+// returns the number of characters written; the mappings are one-to-one, so
+// only toTitle (which drops extra spaces) can write fewer. ASCII runs are
+// mapped four characters per 64-bit word, the Turkish letters through a table
+// covering Latin-1 and Latin Extended-A, and anything else falls back to QChar.
+class TurkishText
+{
+public:
+    static qsizetype toUpper(QStringView input, QChar *output);
+    static qsizetype toLower(QStringView input, QChar *output);
+    // Words separated by single spaces, each with an upper-case first letter
+    static qsizetype toTitle(QStringView input, QChar *output);
+
+    // The canonical form for matching: indexed text and queries are both folded
+    // through here and then compared case-sensitively
+    static qsizetype fold(QStringView input, QChar *output);
+
+    // Convenience forms for call sites that keep the result; one allocation each
+    static QString upper(QStringView input);
+    static QString title(QStringView input);
+    static QString folded(QStringView input);
+};